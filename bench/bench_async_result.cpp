@@ -0,0 +1,116 @@
+/**
+ * @file bench_async_result.cpp
+ * @brief Benchmark: AsyncSlot handoff versus a mutex + condition variable mailbox
+ *
+ * Two threads play ping-pong: the main thread sends a value, an echo
+ * thread sends it back incremented, and the time per round trip (two
+ * handoffs, each usually with a block and a wake-up) is reported. The
+ * *_uncontended rows complete and take in one thread, i.e. the cost when
+ * the consumer finds the Result already there.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+#include "../src/AsyncResult.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kRounds = 20000;
+constexpr uint32_t kIterations = 2000000;
+
+AsyncSlot<uint32_t> g_ping;
+AsyncSlot<uint32_t> g_pong;
+
+struct Mailbox {
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool full = false;
+    uint32_t value = 0;
+
+    void send(uint32_t v) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            value = v;
+            full = true;
+        }
+        ready.notify_one();
+    }
+
+    uint32_t receive() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return full; });
+        full = false;
+        return value;
+    }
+};
+
+Mailbox g_mailPing;
+Mailbox g_mailPong;
+
+template<typename Echo, typename RoundTrip>
+double pingPong(Echo echo, RoundTrip roundTrip) {
+    std::thread peer([&] {
+        for (uint32_t i = 0; i < kRounds; ++i) {
+            echo();
+        }
+    });
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kRounds; ++i) {
+        bench::doNotOptimize(roundTrip(i));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    peer.join();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kRounds;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    AsyncSlot<uint32_t> local;
+    bench::report("async_uncontended", bench::measure([&] {
+        local.promise().setValue(42u);
+        auto r = local.result().tryGet();
+        bench::doNotOptimize(r);
+        local.reset();
+    }, kIterations));
+
+    Mailbox mailbox;
+    bench::report("mutex_condvar_uncontended", bench::measure([&] {
+        mailbox.send(42u);
+        auto v = mailbox.receive();
+        bench::doNotOptimize(v);
+    }, kIterations));
+
+    bench::report("async_roundtrip", pingPong(
+        [] {
+            auto ping = g_ping.result().wait();
+            g_ping.reset();
+            g_pong.promise().setValue(ping.value() + 1);
+        },
+        [](uint32_t i) {
+            g_ping.promise().setValue(i);
+            auto pong = g_pong.result().wait();
+            g_pong.reset();
+            return pong.value();
+        }));
+
+    bench::report("mutex_condvar_roundtrip", pingPong(
+        [] { g_mailPong.send(g_mailPing.receive() + 1); },
+        [](uint32_t i) {
+            g_mailPing.send(i);
+            return g_mailPong.receive();
+        }));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,107 @@
+/**
+ * @file bench_branch_hints.cpp
+ * @brief Benchmark: success-path loop with and without branch hints
+ *
+ * A frame-decoding loop with five Result checks per frame, all of which
+ * succeed. Rows are suffixed with the LIBCOMMON_BRANCH_HINTS setting; run
+ * both environments and compare:
+ *   pio test -e native_bench          (hints on)
+ *   pio test -e native_bench_nohints  (hints off)
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+struct RawFrame {
+    uint8_t address;
+    uint8_t length;
+    uint16_t value;
+    uint8_t checksum;
+};
+
+constexpr size_t kFrames = 256;
+RawFrame g_frames[kFrames];
+
+inline uint8_t checksumOf(const RawFrame& frame) {
+    return static_cast<uint8_t>(frame.address ^ frame.length ^ frame.value ^ (frame.value >> 8));
+}
+
+inline Result<void> checkAddress(const RawFrame& frame) {
+    RETURN_ERROR_IF(frame.address == 0 || frame.address > 247, ErrorCode::INVALID_DATA);
+    return Result<void>::ok();
+}
+
+inline Result<void> checkLength(const RawFrame& frame) {
+    RETURN_ERROR_IF(frame.length != 2, ErrorCode::BUFFER_UNDERFLOW);
+    return Result<void>::ok();
+}
+
+inline Result<void> checkHeader(const RawFrame& frame) {
+    RETURN_IF_ERROR(checkAddress(frame));
+    RETURN_IF_ERROR(checkLength(frame));
+    return Result<void>::ok();
+}
+
+inline Result<uint16_t> checkPayload(const RawFrame& frame) {
+    auto header = checkHeader(frame);
+    RETURN_ERROR_IF(!header, header.error());
+    RETURN_ERROR_IF(checksumOf(frame) != frame.checksum, ErrorCode::CHECKSUM_ERROR);
+    return Result<uint16_t>::ok(frame.value);
+}
+
+inline Result<int32_t> scale(uint16_t raw) {
+    RETURN_ERROR_IF(raw > 60000, ErrorCode::INVALID_DATA);
+    return Result<int32_t>::ok(static_cast<int32_t>(raw) * 10 - 2730);
+}
+
+__attribute__((noinline)) Result<int32_t> decode(const RawFrame& frame) {
+    ASSIGN_OR_RETURN(uint16_t raw, checkPayload(frame));
+    return scale(raw);
+}
+
+__attribute__((noinline)) int64_t decodeAll() {
+    int64_t sum = 0;
+    for (const auto& frame : g_frames) {
+        auto result = decode(frame);
+        if (!result) {
+            return -1;
+        }
+        sum += result.value();
+    }
+    return sum;
+}
+
+#if LIBCOMMON_BRANCH_HINTS
+#define BENCH_SUFFIX "_hints"
+#else
+#define BENCH_SUFFIX "_nohints"
+#endif
+
+} // namespace
+
+int main() {
+    for (size_t i = 0; i < kFrames; ++i) {
+        RawFrame& frame = g_frames[i];
+        frame.address = static_cast<uint8_t>(1 + i % 200);
+        frame.length = 2;
+        frame.value = static_cast<uint16_t>(i * 97);
+        frame.checksum = checksumOf(frame);
+    }
+
+    bench::header();
+
+    const double perLoop = bench::nsPerOp([] {
+        auto sum = decodeAll();
+        bench::doNotOptimize(sum);
+    }, 20000);
+    bench::report("decode_frame" BENCH_SUFFIX, perLoop / kFrames);
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,92 @@
+/**
+ * @file bench_circuit_breaker.cpp
+ * @brief Benchmark: cost of CircuitBreaker::call() when closed and when open
+ *
+ * Compares calling a Result-returning operation directly with calling it
+ * through a closed breaker whose window is full of successes (two loads,
+ * no write), the same breaker shared by four threads, and an open breaker
+ * that fails fast (one load and one clock read; the operation is not
+ * called).
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+#include "../src/CircuitBreaker.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 5000000;
+
+volatile uint16_t g_register = 0x1234;
+
+__attribute__((noinline)) Result<uint16_t> readRegister() {
+    return Result<uint16_t>::ok(static_cast<uint16_t>(g_register));
+}
+
+uint32_t fakeNow(void*) noexcept {
+    return 0;
+}
+
+void noSleep(uint32_t, void*) noexcept {}
+
+double contendedCall(CircuitBreaker& breaker, int threads) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    std::vector<double> results(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            results[t] = bench::nsPerOp([&] {
+                auto r = breaker.call(readRegister);
+                bench::doNotOptimize(r);
+            }, kIterations);
+        });
+    }
+    go.store(true, std::memory_order_release);
+    double sum = 0;
+    for (int t = 0; t < threads; ++t) {
+        workers[t].join();
+        sum += results[t];
+    }
+    return sum / threads;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    bench::report("direct_call", bench::measure([] {
+        auto r = readRegister();
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    const RetryTimer fake{&fakeNow, &noSleep, nullptr};
+    CircuitBreaker closed(CircuitBreakerConfig(), &fake);
+    bench::report("breaker_closed", bench::measure([&] {
+        auto r = closed.call(readRegister);
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    bench::report("breaker_closed_4_threads", contendedCall(closed, 4));
+
+    CircuitBreaker open(CircuitBreakerConfig(), &fake);
+    for (int i = 0; i < 10; ++i) {
+        open.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    }
+    bench::report("breaker_open_reject", bench::measure([&] {
+        auto r = open.call(readRegister);
+        bench::doNotOptimize(r);
+    }, kIterations));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,164 @@
+/**
+ * @file bench_common.h
+ * @brief Minimal timing harness shared by the native benchmarks
+ *
+ * Benchmarks are only compiled in the native_bench environments
+ * (bench/platformio.ini), which define LIBCOMMON_BENCH and build with
+ * optimizations enabled.
+ *
+ * measure() runs a warm-up, then times the calls in batches with
+ * std::chrono::steady_clock and reports min, median and p99 of the
+ * per-call cost across batches next to the overall mean. Rows are CSV by
+ * default; set BENCH_FORMAT=json in the environment for one JSON object
+ * per line. Lines starting with '#' are comments in both formats.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace bench {
+
+/// Number of timed batches measure() splits the iterations into
+constexpr uint32_t kSamples = 200;
+
+/**
+ * @brief Per-call cost of one benchmark, in nanoseconds
+ *
+ * meanNs is total time over total calls; min, median and p99 are taken
+ * over the per-batch averages, so they show run-to-run noise rather than
+ * the cost of individual calls (which steady_clock cannot resolve).
+ */
+struct Stats {
+    double meanNs;
+    double minNs;
+    double medianNs;
+    double p99Ns;
+    uint32_t samples;
+};
+
+/**
+ * @brief Prevent the compiler from discarding a computed value
+ *
+ * Scalars go through an "r,m" operand. Other objects are passed by
+ * address: as an operand GCC copies them to a fresh stack slot (a 4 KiB
+ * memcpy, or piecewise stores that stall store forwarding), which would
+ * be timed as part of the benchmark.
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    if constexpr (std::is_scalar_v<T>) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    } else {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+}
+
+/**
+ * @brief Force pending memory writes to be considered observable
+ */
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+/**
+ * @brief Measure the cost of one call to fn
+ * @param fn Operation to time
+ * @param iterations Number of timed calls (a tenth as many warm-up calls run first)
+ * @return Mean and min/median/p99 over kSamples batches (fewer if iterations is smaller)
+ */
+template<typename F>
+Stats measure(F&& fn, uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    const uint32_t samples = std::max<uint32_t>(1, std::min(iterations, kSamples));
+    const uint32_t batch = std::max<uint32_t>(1, iterations / samples);
+    std::array<double, kSamples> perCall{};
+    double total = 0;
+
+    for (uint32_t s = 0; s < samples; ++s) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < batch; ++i) {
+            fn();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        total += ns;
+        perCall[s] = ns / batch;
+    }
+
+    std::sort(perCall.begin(), perCall.begin() + samples);
+    const uint32_t p99 = (samples * 99 + 99) / 100 - 1;
+    return Stats{total / (static_cast<double>(samples) * batch), perCall[0], perCall[samples / 2], perCall[p99],
+                 samples};
+}
+
+/**
+ * @brief Measure the average cost of one call to fn
+ * @return Nanoseconds per call (the mean of measure())
+ */
+template<typename F>
+double nsPerOp(F&& fn, uint32_t iterations) {
+    return measure(fn, iterations).meanNs;
+}
+
+/**
+ * @brief True when BENCH_FORMAT=json asks for JSON Lines instead of CSV
+ */
+inline bool jsonOutput() {
+    static const bool json = [] {
+        const char* format = std::getenv("BENCH_FORMAT");
+        return format != nullptr && std::strcmp(format, "json") == 0;
+    }();
+    return json;
+}
+
+/**
+ * @brief Print the CSV column header (nothing in JSON mode)
+ *
+ * Call once at the start of main(), before any row.
+ */
+inline void header() {
+    if (!jsonOutput()) {
+        printf("benchmark,ns_per_op,min_ns,median_ns,p99_ns,samples\n");
+    }
+}
+
+/**
+ * @brief Print one benchmark row with its distribution
+ */
+inline void report(const char* name, const Stats& stats) {
+    if (jsonOutput()) {
+        printf("{\"benchmark\":\"%s\",\"ns_per_op\":%.3f,\"min_ns\":%.3f,\"median_ns\":%.3f,\"p99_ns\":%.3f,"
+               "\"samples\":%u}\n",
+               name, stats.meanNs, stats.minNs, stats.medianNs, stats.p99Ns, static_cast<unsigned>(stats.samples));
+    } else {
+        printf("%s,%.3f,%.3f,%.3f,%.3f,%u\n", name, stats.meanNs, stats.minNs, stats.medianNs, stats.p99Ns,
+               static_cast<unsigned>(stats.samples));
+    }
+}
+
+/**
+ * @brief Print one benchmark row that only has a mean (multi-threaded or
+ * hand-timed loops); the distribution columns stay empty
+ */
+inline void report(const char* name, double nsPerOp) {
+    if (jsonOutput()) {
+        printf("{\"benchmark\":\"%s\",\"ns_per_op\":%.3f,\"min_ns\":null,\"median_ns\":null,\"p99_ns\":null,"
+               "\"samples\":0}\n",
+               name, nsPerOp);
+    } else {
+        printf("%s,%.3f,,,,0\n", name, nsPerOp);
+    }
+}
+
+} // namespace bench
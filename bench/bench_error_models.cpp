@@ -0,0 +1,217 @@
+/**
+ * @file bench_error_models.cpp
+ * @brief Benchmark: Result versus raw error codes versus exceptions
+ *
+ * The same three-level call chain (read a register, scale it, convert it
+ * to a float) is written four ways:
+ *   - errcode:        ErrorCode return value plus an out parameter
+ *   - result_manual:  Result<T> with hand-written isError() checks
+ *   - result_macros:  Result<T> with ASSIGN_OR_RETURN
+ *   - exception:      plain return values, failures thrown and caught at the top
+ *
+ * Each model runs at failure rates of 0% and 1% (success-heavy) and 50%
+ * and 100% (failure-heavy). Failures follow a shuffled 1024-entry pattern
+ * so the branch predictor cannot learn them. Exceptions are only built
+ * when the compiler has them enabled (the native default).
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <exception>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kPatternSize = 1024;
+
+volatile uint16_t g_register = 0x1234;
+uint8_t g_pattern[kPatternSize];
+
+struct Workload {
+    const char* name;
+    uint32_t failPerMille;
+    uint32_t iterations;
+};
+
+constexpr Workload kWorkloads[] = {
+    {"fail0", 0, 2000000},
+    {"fail1", 10, 2000000},
+    {"fail50", 500, 200000},
+    {"fail100", 1000, 200000},
+};
+
+// Exactly failPerMille/1000 of the pattern fails, in a fixed pseudo-random order
+void fillPattern(uint32_t failPerMille) {
+    const uint32_t failing = failPerMille * kPatternSize / 1000;
+    for (uint32_t i = 0; i < kPatternSize; ++i) {
+        g_pattern[i] = i < failing ? 1 : 0;
+    }
+    uint32_t state = 0x2545F491u;
+    for (uint32_t i = kPatternSize - 1; i > 0; --i) {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t j = (state >> 8) % (i + 1);
+        const uint8_t tmp = g_pattern[i];
+        g_pattern[i] = g_pattern[j];
+        g_pattern[j] = tmp;
+    }
+}
+
+bool failsAt(uint32_t i) {
+    return g_pattern[i % kPatternSize] != 0;
+}
+
+// --- raw error codes ---
+
+__attribute__((noinline)) ErrorCode readCode(uint32_t i, uint16_t& out) {
+    if (failsAt(i)) {
+        return ErrorCode::TIMEOUT;
+    }
+    out = g_register;
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode scaleCode(uint32_t i, uint16_t& out) {
+    uint16_t raw;
+    const ErrorCode err = readCode(i, raw);
+    if (err != ErrorCode::OK) {
+        return err;
+    }
+    out = static_cast<uint16_t>(raw * 2);
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode convertCode(uint32_t i, float& out) {
+    uint16_t scaled;
+    const ErrorCode err = scaleCode(i, scaled);
+    if (err != ErrorCode::OK) {
+        return err;
+    }
+    out = scaled * 0.1f;
+    return ErrorCode::OK;
+}
+
+// --- Result, hand-written checks ---
+
+__attribute__((noinline)) Result<uint16_t> readResult(uint32_t i) {
+    if (failsAt(i)) {
+        return Result<uint16_t>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(g_register));
+}
+
+__attribute__((noinline)) Result<uint16_t> scaleManual(uint32_t i) {
+    auto raw = readResult(i);
+    if (raw.isError()) {
+        return raw.failure();
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(raw.value() * 2));
+}
+
+__attribute__((noinline)) Result<float> convertManual(uint32_t i) {
+    auto scaled = scaleManual(i);
+    if (scaled.isError()) {
+        return scaled.failure();
+    }
+    return Result<float>::ok(scaled.value() * 0.1f);
+}
+
+// --- Result, propagation macros ---
+
+__attribute__((noinline)) Result<uint16_t> scaleMacros(uint32_t i) {
+    ASSIGN_OR_RETURN(uint16_t raw, readResult(i));
+    return Result<uint16_t>::ok(static_cast<uint16_t>(raw * 2));
+}
+
+__attribute__((noinline)) Result<float> convertMacros(uint32_t i) {
+    ASSIGN_OR_RETURN(uint16_t scaled, scaleMacros(i));
+    return Result<float>::ok(scaled * 0.1f);
+}
+
+// --- exceptions ---
+
+#if defined(__cpp_exceptions)
+class DeviceError : public std::exception {
+public:
+    explicit DeviceError(ErrorCode code) : code_(code) {}
+    const char* what() const noexcept override { return errorCodeToString(code_); }
+    ErrorCode code() const { return code_; }
+
+private:
+    ErrorCode code_;
+};
+
+__attribute__((noinline)) uint16_t readThrowing(uint32_t i) {
+    if (failsAt(i)) {
+        throw DeviceError(ErrorCode::TIMEOUT);
+    }
+    return g_register;
+}
+
+__attribute__((noinline)) uint16_t scaleThrowing(uint32_t i) {
+    return static_cast<uint16_t>(readThrowing(i) * 2);
+}
+
+__attribute__((noinline)) float convertThrowing(uint32_t i) {
+    return scaleThrowing(i) * 0.1f;
+}
+#endif
+
+void runWorkload(const Workload& workload) {
+    fillPattern(workload.failPerMille);
+    char name[48];
+    uint32_t i = 0;
+
+    snprintf(name, sizeof(name), "errcode_%s", workload.name);
+    bench::report(name, bench::measure([&] {
+        float value = 0;
+        const ErrorCode err = convertCode(i++, value);
+        bench::doNotOptimize(err);
+        bench::doNotOptimize(value);
+    }, workload.iterations));
+
+    snprintf(name, sizeof(name), "result_manual_%s", workload.name);
+    bench::report(name, bench::measure([&] {
+        auto result = convertManual(i++);
+        bench::doNotOptimize(result);
+    }, workload.iterations));
+
+    snprintf(name, sizeof(name), "result_macros_%s", workload.name);
+    bench::report(name, bench::measure([&] {
+        auto result = convertMacros(i++);
+        bench::doNotOptimize(result);
+    }, workload.iterations));
+
+#if defined(__cpp_exceptions)
+    snprintf(name, sizeof(name), "exception_%s", workload.name);
+    bench::report(name, bench::measure([&] {
+        float value = 0;
+        ErrorCode err = ErrorCode::OK;
+        try {
+            value = convertThrowing(i++);
+        } catch (const DeviceError& e) {
+            err = e.code();
+        }
+        bench::doNotOptimize(err);
+        bench::doNotOptimize(value);
+    }, workload.iterations));
+#endif
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+#if !defined(__cpp_exceptions)
+    printf("# exceptions disabled, exception_* rows skipped\n");
+#endif
+
+    for (const auto& workload : kWorkloads) {
+        runWorkload(workload);
+    }
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,85 @@
+/**
+ * @file bench_error_stats.cpp
+ * @brief Benchmark: cost of counting errors with LIBCOMMON_ERROR_STATS
+ *
+ * Compares creating an error Result with and without the statistics hook,
+ * the bare record() call, and record() under contention from four
+ * threads hitting the same counter. The tick() row is the cost of the
+ * once-per-second window update.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#define LIBCOMMON_ERROR_STATS 1
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 5000000;
+
+volatile ErrorCode g_code = ErrorCode::TIMEOUT;
+
+__attribute__((noinline)) Result<int> counted() {
+    return Result<int>::error(g_code);
+}
+
+__attribute__((noinline)) Result<int> uncounted() {
+    // A propagated Failure is not counted
+    return Result<int>(detail::failureOf(static_cast<ErrorCode>(g_code), ErrorLocation()));
+}
+
+double contendedRecord(int threads) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    std::vector<double> results(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            results[t] = bench::nsPerOp([] { errorStats().record(g_code); }, kIterations);
+        });
+    }
+    go.store(true, std::memory_order_release);
+    double sum = 0;
+    for (int t = 0; t < threads; ++t) {
+        workers[t].join();
+        sum += results[t];
+    }
+    return sum / threads;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    bench::report("error_result_uncounted", bench::measure([] {
+        auto r = uncounted();
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    bench::report("error_result_counted", bench::measure([] {
+        auto r = counted();
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    bench::report("stats_record", bench::measure([] {
+        errorStats().record(g_code);
+    }, kIterations));
+
+    bench::report("stats_record_4_threads", contendedRecord(4));
+
+    bench::report("stats_tick", bench::measure([] {
+        errorStats().tick();
+    }, 100000));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
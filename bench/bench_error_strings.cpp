@@ -0,0 +1,87 @@
+/**
+ * @file bench_error_strings.cpp
+ * @brief Benchmark: errorCodeToString / errorCodeFromString
+ *
+ * Looks up every ErrorCode in a shuffled order, through the string pool
+ * and through the former switch (error_strings_switch.h). Parsing is
+ * compared with a linear case-insensitive scan over all texts.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <cctype>
+#include "bench_common.h"
+#include "../test/error_strings_switch.h"
+
+using namespace common;
+
+namespace {
+
+constexpr size_t kLookups = 256;
+ErrorCode g_codes[kLookups];
+const char* g_texts[kLookups];
+
+bool equalsIgnoringCase(const char* a, const char* b) {
+    for (; *a != '\0' && *b != '\0'; ++a, ++b) {
+        if (std::tolower(static_cast<unsigned char>(*a)) != std::tolower(static_cast<unsigned char>(*b))) {
+            return false;
+        }
+    }
+    return *a == *b;
+}
+
+__attribute__((noinline)) bool scanFromString(const char* text, ErrorCode& code) {
+    for (auto candidate : kAllErrorCodes) {
+        if (equalsIgnoringCase(baseline::switchErrorCodeToString(candidate), text)) {
+            code = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename F>
+double perLookup(F&& lookup) {
+    return bench::nsPerOp([&] {
+        for (size_t i = 0; i < kLookups; ++i) {
+            lookup(i);
+        }
+    }, 20000) / kLookups;
+}
+
+} // namespace
+
+int main() {
+    uint32_t state = 12345;
+    for (size_t i = 0; i < kLookups; ++i) {
+        state = state * 1664525u + 1013904223u;
+        g_codes[i] = kAllErrorCodes[(state >> 16) % kErrorCodeCount];
+        g_texts[i] = errorCodeToString(g_codes[i]);
+    }
+
+    bench::header();
+
+    bench::report("to_string_pool", perLookup([](size_t i) {
+        const char* text = errorCodeToString(g_codes[i]);
+        bench::doNotOptimize(text);
+    }));
+    bench::report("to_string_switch", perLookup([](size_t i) {
+        const char* text = baseline::switchErrorCodeToString(g_codes[i]);
+        bench::doNotOptimize(text);
+    }));
+    bench::report("from_string_perfect_hash", perLookup([](size_t i) {
+        ErrorCode code = ErrorCode::OK;
+        bool found = errorCodeFromString(g_texts[i], code);
+        bench::doNotOptimize(found);
+        bench::doNotOptimize(code);
+    }));
+    bench::report("from_string_linear_scan", perLookup([](size_t i) {
+        ErrorCode code = ErrorCode::OK;
+        bool found = scanFromString(g_texts[i], code);
+        bench::doNotOptimize(found);
+        bench::doNotOptimize(code);
+    }));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
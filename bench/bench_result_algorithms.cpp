@@ -0,0 +1,87 @@
+/**
+ * @file bench_result_algorithms.cpp
+ * @brief Benchmark: collect() / partition() versus hand-written poll loops
+ *
+ * A poll cycle of 32 register reads, each a Result<uint16_t> from a
+ * non-inlined function. collect<32>() is compared with the usual loop that
+ * returns at the first error, partition<64>() with a loop that keeps going
+ * and tracks a bitmap by hand.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 200000;
+
+volatile uint16_t g_base = 1000;
+volatile uint64_t g_failing = 0;
+
+__attribute__((noinline)) Result<uint16_t> readRegister(size_t index) {
+    if (LIBCOMMON_UNLIKELY((g_failing >> index) & 1u)) {
+        return Result<uint16_t>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(g_base + index));
+}
+
+Result<std::array<uint16_t, 32>> handCollect() {
+    std::array<uint16_t, 32> values{};
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto r = readRegister(i);
+        if (r.isError()) {
+            return Result<std::array<uint16_t, 32>>::error(r.error());
+        }
+        values[i] = r.value();
+    }
+    return Result<std::array<uint16_t, 32>>::ok(values);
+}
+
+uint64_t handPartition(std::array<uint16_t, 64>& values) {
+    uint64_t ok = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto r = readRegister(i);
+        if (r.isOk()) {
+            values[i] = r.value();
+            ok |= 1ull << i;
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    bench::report("hand_collect_32", bench::measure([] {
+        auto r = handCollect();
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    bench::report("collect_32", bench::measure([] {
+        auto r = collect<32>(readRegister);
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    std::array<uint16_t, 64> registers{};
+    g_failing = (1ull << 3) | (1ull << 40);
+    bench::report("hand_partition_64", bench::measure([&] {
+        auto ok = handPartition(registers);
+        bench::doNotOptimize(ok);
+        bench::doNotOptimize(registers);
+    }, kIterations));
+
+    bench::report("partition_64", bench::measure([&] {
+        auto status = partition<64>(readRegister, registers);
+        bench::doNotOptimize(status);
+        bench::doNotOptimize(registers);
+    }, kIterations));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
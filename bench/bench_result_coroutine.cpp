@@ -0,0 +1,101 @@
+/**
+ * @file bench_result_coroutine.cpp
+ * @brief Benchmark: co_await propagation vs RESULT_TRY / hand-written checks
+ *
+ * Three-step read/validate/scale pipeline written three ways. The
+ * coroutine version pays for a frame allocation per call, measured with
+ * the heap and with a StaticFrameArena. Needs C++20; run with:
+ * pio test -e native_bench_cxx20
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+#include "../src/ResultCoroutine.h"
+
+using namespace common;
+
+namespace {
+
+volatile uint8_t g_register = 20;
+
+__attribute__((noinline)) Result<uint16_t> readRegister(uint8_t reg) {
+    if (reg == 0xFF) {
+        return Result<uint16_t>::error(ErrorCode::DEVICE_NOT_FOUND);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(reg * 10));
+}
+
+__attribute__((noinline)) Result<void> checkRange(uint16_t raw) {
+    if (raw > 1000) {
+        return Result<void>::error(ErrorCode::INVALID_DATA);
+    }
+    return Result<void>::ok();
+}
+
+__attribute__((noinline)) Result<float> readManual(uint8_t reg) {
+    auto raw = readRegister(reg);
+    if (!raw) {
+        return makeFailure(raw.error());
+    }
+    auto range = checkRange(raw.value());
+    if (!range) {
+        return makeFailure(range.error());
+    }
+    return Result<float>::ok(raw.value() * 0.5f);
+}
+
+#if LIBCOMMON_HAS_TRY_EXPR
+__attribute__((noinline)) Result<float> readTry(uint8_t reg) {
+    uint16_t raw = RESULT_TRY(readRegister(reg));
+    auto range = checkRange(raw);
+    RETURN_ERROR_IF(!range, range.error());
+    return Result<float>::ok(raw * 0.5f);
+}
+#endif
+
+#if LIBCOMMON_HAS_RESULT_COROUTINES
+__attribute__((noinline)) Result<float> readCoroutine(uint8_t reg) {
+    uint16_t raw = co_await readRegister(reg);
+    co_await checkRange(raw);
+    co_return raw * 0.5f;
+}
+#endif
+
+template<typename F>
+void benchPath(const char* name, F read, uint8_t reg) {
+    const bench::Stats stats = bench::measure([&] {
+        auto result = read(reg);
+        bench::doNotOptimize(result);
+    }, 2000000);
+    bench::report(name, stats);
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    benchPath("manual_ok", readManual, g_register);
+    benchPath("manual_error", readManual, 0xFF);
+#if LIBCOMMON_HAS_TRY_EXPR
+    benchPath("try_ok", readTry, g_register);
+    benchPath("try_error", readTry, 0xFF);
+#endif
+#if LIBCOMMON_HAS_RESULT_COROUTINES
+    benchPath("coroutine_heap_ok", readCoroutine, g_register);
+    benchPath("coroutine_heap_error", readCoroutine, 0xFF);
+
+    static StaticFrameArena<1024> arena;
+    setFrameAllocator(arena.allocator());
+    benchPath("coroutine_arena_ok", readCoroutine, g_register);
+    benchPath("coroutine_arena_error", readCoroutine, 0xFF);
+    resetFrameAllocator();
+#else
+    printf("# coroutine rows skipped: build with -std=c++20\n");
+#endif
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,67 @@
+/**
+ * @file bench_result_emplace.cpp
+ * @brief Benchmark: Result<T>::ok(T{...}) vs Result<T>::emplace(...)
+ *
+ * ok(T{...}) builds a temporary snapshot and moves (for a trivially
+ * copyable T: memcpys) it into the Result. emplace() constructs the
+ * snapshot directly in the Result's storage.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <cstring>
+#include "bench_common.h"
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+// Sensor snapshot filled from a sequence number, like a poll-cycle record
+template<size_t N>
+struct Snapshot {
+    explicit Snapshot(uint32_t seq) : sequence(seq) {
+        memset(samples, static_cast<int>(seq & 0xFF), sizeof(samples));
+    }
+
+    uint32_t sequence;
+    uint8_t samples[N - sizeof(uint32_t)];
+};
+
+volatile uint32_t g_sequence = 1;
+
+template<size_t N>
+__attribute__((noinline)) Result<Snapshot<N>> pollOk() {
+    return Result<Snapshot<N>>::ok(Snapshot<N>(g_sequence));
+}
+
+template<size_t N>
+__attribute__((noinline)) Result<Snapshot<N>> pollEmplace() {
+    return Result<Snapshot<N>>::emplace(g_sequence);
+}
+
+template<size_t N>
+void benchPayload(const char* okName, const char* emplaceName) {
+    bench::report(okName, bench::measure([] {
+        auto result = pollOk<N>();
+        bench::doNotOptimize(result);
+    }, 1000000));
+
+    bench::report(emplaceName, bench::measure([] {
+        auto result = pollEmplace<N>();
+        bench::doNotOptimize(result);
+    }, 1000000));
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    benchPayload<64>("ok_64B", "emplace_64B");
+    benchPayload<512>("ok_512B", "emplace_512B");
+    benchPayload<4096>("ok_4KB", "emplace_4KB");
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
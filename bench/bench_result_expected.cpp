@@ -0,0 +1,146 @@
+/**
+ * @file bench_result_expected.cpp
+ * @brief Benchmark: Result versus std::expected (C++23) on success and error paths
+ *
+ * The same non-inlined register read returns a Result<T> or a
+ * std::expected<T, ErrorCode>, and a three-deep call chain propagates it.
+ * Rows cover the success path, the error path and the toExpected() &&
+ * conversion. The leading comment lines give each type's size and whether
+ * it is trivially copyable, which decides whether the ABI returns it in
+ * registers or through memory.
+ *
+ * Built in native_bench_cxx23, and in native_bench_expected with
+ * LIBCOMMON_RESULT_STD_EXPECTED=1, where the result_* rows use Result's
+ * std::expected layout instead.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <type_traits>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+#if LIBCOMMON_HAS_STD_EXPECTED
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 5000000;
+
+template<typename T>
+using Expected = std::expected<T, ErrorCode>;
+
+volatile uint16_t g_register = 0x1234;
+volatile float g_pressure = 1013.25f;
+volatile bool g_fail = false;
+
+__attribute__((noinline)) Result<uint16_t> readResult() {
+    if (LIBCOMMON_UNLIKELY(g_fail)) {
+        return Result<uint16_t>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(g_register));
+}
+
+__attribute__((noinline)) Expected<uint16_t> readExpected() {
+    if (g_fail) [[unlikely]] {
+        return std::unexpected(ErrorCode::TIMEOUT);
+    }
+    return static_cast<uint16_t>(g_register);
+}
+
+__attribute__((noinline)) Result<float> readPressureResult() {
+    if (LIBCOMMON_UNLIKELY(g_fail)) {
+        return Result<float>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<float>::ok(static_cast<float>(g_pressure));
+}
+
+__attribute__((noinline)) Expected<float> readPressureExpected() {
+    if (g_fail) [[unlikely]] {
+        return std::unexpected(ErrorCode::TIMEOUT);
+    }
+    return static_cast<float>(g_pressure);
+}
+
+__attribute__((noinline)) Result<uint16_t> scaleResult() {
+    auto raw = readResult();
+    if (LIBCOMMON_UNLIKELY(raw.isError())) {
+        return raw.failure();
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(raw.value() * 2));
+}
+
+__attribute__((noinline)) Expected<uint16_t> scaleExpected() {
+    auto raw = readExpected();
+    if (!raw) [[unlikely]] {
+        return std::unexpected(raw.error());
+    }
+    return static_cast<uint16_t>(*raw * 2);
+}
+
+__attribute__((noinline)) Result<uint16_t> chainResult() {
+    auto scaled = scaleResult();
+    if (LIBCOMMON_UNLIKELY(scaled.isError())) {
+        return scaled.failure();
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(scaled.value() + 1));
+}
+
+__attribute__((noinline)) Expected<uint16_t> chainExpected() {
+    auto scaled = scaleExpected();
+    if (!scaled) [[unlikely]] {
+        return std::unexpected(scaled.error());
+    }
+    return static_cast<uint16_t>(*scaled + 1);
+}
+
+template<typename R>
+void describe(const char* name) {
+    printf("# %s: %zu bytes, trivially copyable %d\n", name, sizeof(R), std::is_trivially_copyable_v<R> ? 1 : 0);
+}
+
+template<typename F>
+void run(const char* name, F&& fn) {
+    bench::report(name, bench::measure([&] {
+        auto r = fn();
+        bench::doNotOptimize(r);
+    }, kIterations));
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+    describe<Result<uint16_t>>("Result<uint16_t>");
+    describe<Expected<uint16_t>>("std::expected<uint16_t>");
+    describe<Result<float>>("Result<float>");
+    describe<Expected<float>>("std::expected<float>");
+
+    g_fail = false;
+    run("result_ok", readResult);
+    run("expected_ok", readExpected);
+    run("result_float_ok", readPressureResult);
+    run("expected_float_ok", readPressureExpected);
+    run("result_chain3_ok", chainResult);
+    run("expected_chain3_ok", chainExpected);
+    run("result_to_expected", [] { return readResult().toExpected(); });
+
+    g_fail = true;
+    run("result_error", readResult);
+    run("expected_error", readExpected);
+    run("result_chain3_error", chainResult);
+    run("expected_chain3_error", chainExpected);
+    return 0;
+}
+
+#else
+
+int main() {
+    printf("# bench_result_expected needs C++23 std::expected (pio test -e native_bench_cxx23)\n");
+    return 0;
+}
+
+#endif // LIBCOMMON_HAS_STD_EXPECTED
+
+#endif // LIBCOMMON_BENCH
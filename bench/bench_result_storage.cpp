@@ -0,0 +1,54 @@
+/**
+ * @file bench_result_storage.cpp
+ * @brief Benchmark: cost of returning an error Result for growing payloads
+ *
+ * With union storage an error never constructs T, so the error-return path
+ * should cost the same for a 4-byte and a 4 KiB payload.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+// Frame buffer that zero-fills on default construction, like a Modbus frame
+template<size_t N>
+struct Frame {
+    uint8_t data[N]{};
+};
+
+template<size_t N>
+__attribute__((noinline)) Result<Frame<N>> failRead() {
+    return Result<Frame<N>>::error(ErrorCode::TIMEOUT);
+}
+
+template<size_t N>
+double benchErrorPath(const char* name) {
+    const bench::Stats stats = bench::measure([] {
+        auto result = failRead<N>();
+        bench::doNotOptimize(result);
+    }, 5000000);
+    bench::report(name, stats);
+    return stats.meanNs;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    const double smallest = benchErrorPath<4>("error_path_4B");
+    benchErrorPath<64>("error_path_64B");
+    benchErrorPath<256>("error_path_256B");
+    benchErrorPath<1024>("error_path_1KB");
+    const double largest = benchErrorPath<4096>("error_path_4KB");
+
+    printf("# scaling 4KB vs 4B %.2f\n", largest / smallest);
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,92 @@
+/**
+ * @file bench_result_wire.cpp
+ * @brief Benchmark: wire encoding of a 32-reading frame versus snprintf JSON
+ *
+ * One telemetry frame is 32 Results with two errors among them. Each row
+ * is the time to encode or decode the whole frame. The JSON baseline
+ * formats the same readings with snprintf into a stack buffer, which is
+ * cheaper than the String-based serializer it replaces (no heap).
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include <array>
+#include <cstdio>
+#include <utility>
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+#include "../src/ResultWire.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 200000;
+constexpr size_t kReadings = 32;
+
+template<typename T, size_t... I>
+std::array<Result<T>, sizeof...(I)> makeFrame(T (*value)(size_t), std::index_sequence<I...>) {
+    return {{((I == 7 || I == 19) ? Result<T>::error(ErrorCode::TIMEOUT) : Result<T>::ok(value(I)))...}};
+}
+
+size_t jsonFrame(const std::array<Result<float>, kReadings>& readings, char* out, size_t capacity) {
+    size_t used = 0;
+    for (const auto& r : readings) {
+        const int n = r.isOk() ? snprintf(out + used, capacity - used, "{\"v\":%.7g},", static_cast<double>(r.value()))
+                               : snprintf(out + used, capacity - used, "{\"err\":%d},", static_cast<int>(r.error()));
+        used += static_cast<size_t>(n);
+    }
+    return used;
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    const auto indices = std::make_index_sequence<kReadings>();
+    auto floats = makeFrame<float>([](size_t i) { return 20.0f + 0.37f * i; }, indices);
+    auto registers = makeFrame<uint16_t>([](size_t i) { return static_cast<uint16_t>(1000 + 97 * i); }, indices);
+    auto decodedFloats = floats;
+    auto decodedRegisters = registers;
+
+    uint8_t frame[kReadings * maxWireSize<float>()];
+    size_t floatBytes = encodeResults(floats, frame, sizeof(frame)).value();
+    bench::report("wire_encode_float_32", bench::measure([&] {
+        auto n = encodeResults(floats, frame, sizeof(frame));
+        bench::doNotOptimize(n);
+        bench::doNotOptimize(frame);
+    }, kIterations));
+
+    bench::report("wire_decode_float_32", bench::measure([&] {
+        auto n = decodeResults(frame, floatBytes, decodedFloats);
+        bench::doNotOptimize(n);
+        bench::doNotOptimize(decodedFloats);
+    }, kIterations));
+
+    size_t registerBytes = encodeResults(registers, frame, sizeof(frame)).value();
+    bench::report("wire_encode_u16_32", bench::measure([&] {
+        auto n = encodeResults(registers, frame, sizeof(frame));
+        bench::doNotOptimize(n);
+        bench::doNotOptimize(frame);
+    }, kIterations));
+
+    bench::report("wire_decode_u16_32", bench::measure([&] {
+        auto n = decodeResults(frame, registerBytes, decodedRegisters);
+        bench::doNotOptimize(n);
+        bench::doNotOptimize(decodedRegisters);
+    }, kIterations));
+
+    char json[kReadings * 24];
+    bench::report("json_snprintf_float_32", bench::measure([&] {
+        auto n = jsonFrame(floats, json, sizeof(json));
+        bench::doNotOptimize(n);
+        bench::doNotOptimize(json);
+    }, kIterations / 10));
+
+    printf("# bytes per frame: wire float %zu, wire u16 %zu, json %zu\n", floatBytes, registerBytes,
+           jsonFrame(floats, json, sizeof(json)));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,72 @@
+/**
+ * @file bench_retry.cpp
+ * @brief Benchmark: overhead of retry() when the first attempt succeeds
+ *
+ * Compares calling a Result-returning operation directly with calling it
+ * through retry(): without stats or deadline (clock never read), and with
+ * stats (two clock reads). The last row is one failed attempt followed by
+ * a success, with a no-op sleep.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+#include "../src/Retry.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 5000000;
+
+volatile uint16_t g_register = 0x1234;
+volatile uint32_t g_failures = 0;
+
+__attribute__((noinline)) Result<uint16_t> readRegister() {
+    if (g_failures != 0) {
+        g_failures = g_failures - 1;
+        return Result<uint16_t>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(g_register));
+}
+
+uint32_t fakeNow(void*) noexcept {
+    return 0;
+}
+
+void noSleep(uint32_t, void*) noexcept {}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    bench::report("direct_call", bench::measure([] {
+        auto r = readRegister();
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    RetryPolicy policy;
+    bench::report("retry_success_first_try", bench::measure([&] {
+        auto r = retry(readRegister, policy);
+        bench::doNotOptimize(r);
+    }, kIterations));
+
+    bench::report("retry_success_first_try_stats", bench::measure([&] {
+        RetryStats stats;
+        auto r = retry(readRegister, policy, &stats);
+        bench::doNotOptimize(r);
+        bench::doNotOptimize(stats);
+    }, kIterations));
+
+    const RetryTimer fake{&fakeNow, &noSleep, nullptr};
+    bench::report("retry_one_failure_no_sleep", bench::measure([&] {
+        g_failures = 1;
+        auto r = retry(readRegister, policy, fake);
+        bench::doNotOptimize(r);
+    }, kIterations));
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
@@ -0,0 +1,68 @@
+/**
+ * @file bench_return_chain.cpp
+ * @brief Benchmark: 10-deep RETURN_IF_ERROR chain, trivial vs non-trivial Result
+ *
+ * "trivial" uses Result<double>, which is trivially copyable and returned
+ * in registers. "non_trivial" wraps the same double in a payload with a
+ * user-provided copy constructor, which forces every level to return
+ * through a hidden memory slot - the calling convention every Result used
+ * before it propagated triviality from T.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+struct OpaqueDouble {
+    OpaqueDouble(double v) : value(v) {}
+    OpaqueDouble(const OpaqueDouble& other) : value(other.value) {}
+    double value;
+};
+
+volatile double g_sample = 21.5;
+
+// One call per level: RETURN_IF_ERROR on the inner call, then forward it
+template<typename T, int Depth>
+__attribute__((noinline)) Result<T> level() {
+    auto inner = level<T, Depth - 1>();
+    RETURN_IF_ERROR(inner);
+    return inner;
+}
+
+template<>
+__attribute__((noinline)) Result<double> level<double, 0>() {
+    return Result<double>::ok(static_cast<double>(g_sample));
+}
+
+template<>
+__attribute__((noinline)) Result<OpaqueDouble> level<OpaqueDouble, 0>() {
+    return Result<OpaqueDouble>::ok(OpaqueDouble(static_cast<double>(g_sample)));
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    const bench::Stats trivial = bench::measure([] {
+        auto result = level<double, 10>();
+        bench::doNotOptimize(result);
+    }, 2000000);
+    bench::report("chain10_trivial", trivial);
+
+    const bench::Stats nonTrivial = bench::measure([] {
+        auto result = level<OpaqueDouble, 10>();
+        bench::doNotOptimize(result);
+    }, 2000000);
+    bench::report("chain10_non_trivial", nonTrivial);
+
+    printf("# speedup %.2f\n", nonTrivial.meanNs / trivial.meanNs);
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
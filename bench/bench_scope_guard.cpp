@@ -0,0 +1,107 @@
+/**
+ * @file bench_scope_guard.cpp
+ * @brief Benchmark: ScopeGuard versus hand-written cleanup
+ *
+ * A non-inlined transaction takes a lock, does one step that may fail and
+ * releases the lock on every path. "manual" releases by hand before each
+ * return, "guard" uses makeScopeGuard. The rollback rows model the
+ * commit-or-undo pattern: the guard undoes the step unless dismiss() is
+ * reached, once on the success path and once on the failure path.
+ */
+
+#ifdef LIBCOMMON_BENCH
+
+#include "bench_common.h"
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kIterations = 5000000;
+
+volatile int g_lockDepth = 0;
+volatile uint32_t g_written = 0;
+volatile bool g_fail = false;
+
+__attribute__((noinline)) void lock() { g_lockDepth = g_lockDepth + 1; }
+__attribute__((noinline)) void unlock() { g_lockDepth = g_lockDepth - 1; }
+
+__attribute__((noinline)) ErrorCode writeStep() {
+    if (g_fail) {
+        return ErrorCode::TIMEOUT;
+    }
+    g_written = g_written + 1;
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode transactionManual() {
+    lock();
+    const ErrorCode err = writeStep();
+    if (err != ErrorCode::OK) {
+        unlock();
+        return err;
+    }
+    unlock();
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode transactionGuard() {
+    lock();
+    auto guard = makeScopeGuard([] { unlock(); });
+    const ErrorCode err = writeStep();
+    if (err != ErrorCode::OK) {
+        return err;
+    }
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode rollbackManual() {
+    g_written = g_written + 1;
+    const ErrorCode err = writeStep();
+    if (err != ErrorCode::OK) {
+        g_written = g_written - 1;
+        return err;
+    }
+    return ErrorCode::OK;
+}
+
+__attribute__((noinline)) ErrorCode rollbackGuard() {
+    g_written = g_written + 1;
+    auto undo = makeScopeGuard([] { g_written = g_written - 1; });
+    const ErrorCode err = writeStep();
+    if (err != ErrorCode::OK) {
+        return err;
+    }
+    undo.dismiss();
+    return ErrorCode::OK;
+}
+
+template<typename F>
+void run(const char* name, F fn) {
+    bench::report(name, bench::measure([&] {
+        auto err = fn();
+        bench::doNotOptimize(err);
+    }, kIterations));
+}
+
+} // namespace
+
+int main() {
+    bench::header();
+
+    g_fail = false;
+    run("cleanup_manual_ok", transactionManual);
+    run("cleanup_guard_ok", transactionGuard);
+    run("rollback_manual_ok", rollbackManual);
+    run("rollback_guard_dismissed", rollbackGuard);
+
+    g_fail = true;
+    run("cleanup_manual_error", transactionManual);
+    run("cleanup_guard_error", transactionGuard);
+    run("rollback_manual_error", rollbackManual);
+    run("rollback_guard_fired", rollbackGuard);
+    return 0;
+}
+
+#endif // LIBCOMMON_BENCH
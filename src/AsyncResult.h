@@ -0,0 +1,511 @@
+/**
+ * @file AsyncResult.h
+ * @brief Single-slot Promise / AsyncResult pair for handing a Result between tasks
+ *
+ * An AsyncSlot holds one Result<T, E> and is meant to be statically
+ * allocated next to the two tasks sharing it. The producer gets a
+ * Promise from it, the consumer an AsyncResult. Completing the Promise
+ * constructs the Result in the slot and publishes it with a single
+ * atomic fetch_or; only if the consumer is already blocked does the
+ * producer also wake it. The consumer polls (tryGet()), blocks with a
+ * timeout (wait(), ErrorCode::TIMEOUT when it runs out), or registers a
+ * continuation (then()) that runs in whichever task completes last.
+ *
+ * Blocking is delegated to an AsyncWaitBackend (two function pointers):
+ * a futex on Linux, a task notification on ESP-IDF, a mutex and
+ * condition variable elsewhere. Other RTOSes install their own.
+ *
+ * One producer, one consumer, one Result per round; reset() re-arms the
+ * slot once both sides are done with it.
+ *
+ * @code
+ * static AsyncSlot<uint16_t> g_pressure;
+ *
+ * // Bus task
+ * auto promise = g_pressure.promise();
+ * promise.complete(modbus.readHolding(0x10));
+ *
+ * // Control task
+ * auto pending = g_pressure.result();
+ * auto pressure = pending.wait(50);   // ErrorCode::TIMEOUT after 50 ms
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ErrorCodes.h"
+#include "Result.h"
+
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @def LIBCOMMON_ASYNC_NOTIFY_INDEX
+ * @brief Task notification index the ESP-IDF backend blocks on
+ *
+ * Defaults to the last entry of the notification array. With ESP-IDF's
+ * default of one entry (CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES)
+ * that is index 0, shared with xTaskNotify()/ulTaskNotifyTake() and with
+ * stream and message buffers, so a consumer task that also uses those
+ * may be woken early (it re-checks and blocks again) or consume a
+ * notification meant for them. Raise the entry count to give AsyncResult
+ * its own index.
+ */
+#ifndef LIBCOMMON_ASYNC_NOTIFY_INDEX
+#define LIBCOMMON_ASYNC_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+#endif
+static_assert(LIBCOMMON_ASYNC_NOTIFY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+              "LIBCOMMON_ASYNC_NOTIFY_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES");
+#elif defined(__linux__)
+#include <chrono>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace common {
+
+/**
+ * @brief Timeout meaning "wait until the Result arrives"
+ */
+constexpr uint32_t kAsyncWaitForever = 0xFFFFFFFF;
+
+/**
+ * @brief The word a consumer blocks on, and who is blocked
+ */
+struct AsyncSignal {
+    std::atomic<uint32_t> state{0};     ///< Slot state bits (AsyncSlot::kReady, ...)
+    std::atomic<void*> waiter{nullptr}; ///< Backend-specific; task handle on ESP-IDF
+};
+
+/**
+ * @brief How a consumer blocks and a producer wakes it
+ *
+ * wait() returns once signal.state differs from expected or timeoutMs
+ * (kAsyncWaitForever for none) has passed; it must not miss a wake()
+ * issued between the caller's check and the block. wake() is only
+ * called after state has changed.
+ */
+struct AsyncWaitBackend {
+    void (*wait)(AsyncSignal& signal, uint32_t expected, uint32_t timeoutMs, void* context) noexcept;
+    void (*wake)(AsyncSignal& signal, void* context) noexcept;
+    void* context;
+};
+
+namespace detail {
+
+#if defined(ESP_PLATFORM)
+
+// Task notification: the waiter publishes its handle before re-checking
+// state, the producer reads it after setting state. The handle accesses
+// and both fetch_or()s on state are seq_cst, so either the waiter sees the
+// Result or the producer sees the waiter.
+inline void defaultAsyncWait(AsyncSignal& signal, uint32_t expected, uint32_t timeoutMs, void*) noexcept {
+    signal.waiter.store(xTaskGetCurrentTaskHandle());
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t timeout = timeoutMs == kAsyncWaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    while (signal.state.load() == expected) {
+        TickType_t left = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            const TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= timeout) {
+                break;
+            }
+            left = timeout - elapsed;
+        }
+        ulTaskNotifyTakeIndexed(LIBCOMMON_ASYNC_NOTIFY_INDEX, pdTRUE, left);
+    }
+    signal.waiter.store(nullptr);
+}
+
+inline void defaultAsyncWake(AsyncSignal& signal, void*) noexcept {
+    void* task = signal.waiter.load();
+    if (task != nullptr) {
+        xTaskNotifyGiveIndexed(static_cast<TaskHandle_t>(task), LIBCOMMON_ASYNC_NOTIFY_INDEX);
+    }
+}
+
+#elif defined(__linux__)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+
+inline long asyncFutex(AsyncSignal& signal, int op, uint32_t value, const timespec* timeout) noexcept {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal.state), op, value, timeout, nullptr, 0);
+}
+
+inline void defaultAsyncWait(AsyncSignal& signal, uint32_t expected, uint32_t timeoutMs, void*) noexcept {
+    using namespace std::chrono;
+    const auto deadline = steady_clock::now() + milliseconds(timeoutMs);
+    while (signal.state.load(std::memory_order_acquire) == expected) {
+        if (timeoutMs == kAsyncWaitForever) {
+            asyncFutex(signal, FUTEX_WAIT_PRIVATE, expected, nullptr);
+            continue;
+        }
+        const auto left = duration_cast<nanoseconds>(deadline - steady_clock::now()).count();
+        if (left <= 0) {
+            break;
+        }
+        timespec relative;
+        relative.tv_sec = static_cast<time_t>(left / 1000000000);
+        relative.tv_nsec = static_cast<long>(left % 1000000000);
+        asyncFutex(signal, FUTEX_WAIT_PRIVATE, expected, &relative);
+    }
+}
+
+inline void defaultAsyncWake(AsyncSignal& signal, void*) noexcept {
+    asyncFutex(signal, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+#else
+
+// One lock for all slots: it is only taken by a consumer that found the
+// Result missing and by the producer waking it.
+inline std::mutex asyncWaitMutex;
+inline std::condition_variable asyncWaitCondition;
+
+inline void defaultAsyncWait(AsyncSignal& signal, uint32_t expected, uint32_t timeoutMs, void*) noexcept {
+    auto changed = [&] { return signal.state.load(std::memory_order_acquire) != expected; };
+    std::unique_lock<std::mutex> lock(asyncWaitMutex);
+    if (timeoutMs == kAsyncWaitForever) {
+        asyncWaitCondition.wait(lock, changed);
+    } else {
+        asyncWaitCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), changed);
+    }
+}
+
+inline void defaultAsyncWake(AsyncSignal&, void*) noexcept {
+    { std::lock_guard<std::mutex> lock(asyncWaitMutex); }
+    asyncWaitCondition.notify_all();
+}
+
+#endif
+
+inline AsyncWaitBackend asyncWaitBackend{&defaultAsyncWait, &defaultAsyncWake, nullptr};
+
+} // namespace detail
+
+/**
+ * @brief Install the backend used to block in AsyncResult::wait()
+ * @note Not synchronized: install it during startup
+ */
+inline void setAsyncWaitBackend(const AsyncWaitBackend& backend) noexcept {
+    detail::asyncWaitBackend = backend;
+}
+
+/**
+ * @brief Get the backend currently used by AsyncResult::wait()
+ */
+inline AsyncWaitBackend getAsyncWaitBackend() noexcept {
+    return detail::asyncWaitBackend;
+}
+
+/**
+ * @brief Restore the default backend (task notification on ESP-IDF,
+ *        futex on Linux, mutex + condition variable elsewhere)
+ */
+inline void resetAsyncWaitBackend() noexcept {
+    detail::asyncWaitBackend = AsyncWaitBackend{&detail::defaultAsyncWait, &detail::defaultAsyncWake, nullptr};
+}
+
+template<typename T, typename E>
+class AsyncSlot;
+
+/**
+ * @brief Producer side of an AsyncSlot: completes it exactly once
+ *
+ * A Promise destroyed (or overwritten by move-assignment) while still
+ * pending publishes ErrorCode::INVALID_STATE, so a consumer waiting on a
+ * producer that bailed out early is released instead of blocking forever.
+ */
+template<typename T, typename E = ErrorCode>
+class Promise {
+public:
+    Promise(Promise&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+    Promise& operator=(Promise&& other) noexcept {
+        if (this != &other) {
+            breakPending();
+            slot_ = std::exchange(other.slot_, nullptr);
+        }
+        return *this;
+    }
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+
+    ~Promise() { breakPending(); }
+
+    /**
+     * @brief Publish result to the consumer
+     * @return false if this Promise was already completed (or moved from)
+     */
+    bool complete(Result<T, E> result) noexcept(std::is_nothrow_move_constructible_v<Result<T, E>>) {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return false;
+        }
+        new (slot_->storage_) Result<T, E>(std::move(result));
+        std::exchange(slot_, nullptr)->publish();
+        return true;
+    }
+
+    /**
+     * @brief Publish a value, constructed in place in the slot
+     * @return false if this Promise was already completed (or moved from)
+     */
+    template<typename... Args>
+    bool setValue(Args&&... args) noexcept(std::is_nothrow_constructible_v<Result<T, E>, InPlaceTag, Args...>) {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return false;
+        }
+        if constexpr (std::is_void_v<T>) {
+            static_assert(sizeof...(Args) == 0, "Promise<void>::setValue() takes no arguments");
+            new (slot_->storage_) Result<T, E>();
+        } else {
+            new (slot_->storage_) Result<T, E>(in_place, std::forward<Args>(args)...);
+        }
+        std::exchange(slot_, nullptr)->publish();
+        return true;
+    }
+
+    /**
+     * @brief Publish an error
+     * @return false if this Promise was already completed (or moved from)
+     */
+    bool setError(E error, ErrorLocation location = ErrorLocation::current()) noexcept {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return false;
+        }
+        new (slot_->storage_) Result<T, E>(error, location);
+        std::exchange(slot_, nullptr)->publish();
+        return true;
+    }
+
+    /**
+     * @brief Check whether this Promise can still be completed
+     */
+    bool isPending() const noexcept { return slot_ != nullptr; }
+
+private:
+    friend class AsyncSlot<T, E>;
+    explicit Promise(AsyncSlot<T, E>* slot) noexcept : slot_(slot) {}
+
+    // Broken promise: release the consumer with an error
+    void breakPending() noexcept {
+        if (LIBCOMMON_UNLIKELY(slot_ != nullptr)) {
+            setError(E(ErrorCode::INVALID_STATE));
+        }
+    }
+
+    AsyncSlot<T, E>* slot_;
+};
+
+/**
+ * @brief Consumer side of an AsyncSlot: takes the Result exactly once
+ *
+ * tryGet() and wait() hand the Result over by move; after that (or after
+ * then()) this AsyncResult is spent and further calls fail with
+ * ErrorCode::INVALID_STATE.
+ */
+template<typename T, typename E = ErrorCode>
+class AsyncResult {
+    static_assert(std::is_convertible_v<ErrorCode, E>,
+                  "AsyncResult reports WOULD_BLOCK / TIMEOUT / INVALID_STATE, so E must accept an ErrorCode");
+
+public:
+    /// Continuation: receives the Result and the context given to then()
+    using Callback = void (*)(Result<T, E>&& result, void* context);
+
+    AsyncResult(AsyncResult&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+    AsyncResult& operator=(AsyncResult&& other) noexcept {
+        slot_ = std::exchange(other.slot_, nullptr);
+        return *this;
+    }
+    AsyncResult(const AsyncResult&) = delete;
+    AsyncResult& operator=(const AsyncResult&) = delete;
+
+    /**
+     * @brief Check whether the Result has arrived (and not been taken)
+     */
+    bool isReady() const noexcept { return slot_ != nullptr && slot_->isReady(); }
+
+    /**
+     * @brief Take the Result without blocking
+     * @return The Result, or ErrorCode::WOULD_BLOCK if it has not arrived yet
+     */
+    Result<T, E> tryGet() noexcept(std::is_nothrow_move_constructible_v<Result<T, E>>) {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return Result<T, E>(E(ErrorCode::INVALID_STATE));
+        }
+        if (!slot_->isReady()) {
+            return Result<T, E>(E(ErrorCode::WOULD_BLOCK));
+        }
+        return take();
+    }
+
+    /**
+     * @brief Take the Result, blocking for at most timeoutMs
+     * @param timeoutMs Milliseconds to wait, or kAsyncWaitForever
+     * @return The Result, or ErrorCode::TIMEOUT (this AsyncResult stays
+     *         usable and may wait again)
+     */
+    Result<T, E> wait(uint32_t timeoutMs = kAsyncWaitForever) noexcept(
+        std::is_nothrow_move_constructible_v<Result<T, E>>) {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return Result<T, E>(E(ErrorCode::INVALID_STATE));
+        }
+        if (slot_->isReady()) {
+            return take();
+        }
+        if (timeoutMs != 0 && slot_->block(timeoutMs)) {
+            return take();
+        }
+        return Result<T, E>(E(ErrorCode::TIMEOUT));
+    }
+
+    /**
+     * @brief Hand the Result to callback instead of waiting for it
+     *
+     * If the Result has already arrived, callback runs here and now;
+     * otherwise it runs in the producer's task, inside complete(), so it
+     * should be short (post to a queue, notify a task).
+     *
+     * @return false if this AsyncResult was already spent
+     */
+    bool then(Callback callback, void* context = nullptr) {
+        if (LIBCOMMON_UNLIKELY(slot_ == nullptr)) {
+            return false;
+        }
+        std::exchange(slot_, nullptr)->subscribe(callback, context);
+        return true;
+    }
+
+private:
+    friend class AsyncSlot<T, E>;
+    explicit AsyncResult(AsyncSlot<T, E>* slot) noexcept : slot_(slot) {}
+
+    Result<T, E> take() noexcept(std::is_nothrow_move_constructible_v<Result<T, E>>) {
+        return Result<T, E>(std::move(*std::exchange(slot_, nullptr)->stored()));
+    }
+
+    AsyncSlot<T, E>* slot_;
+};
+
+/**
+ * @brief Shared storage for one Result<T, E> passed from a Promise to an
+ *        AsyncResult
+ *
+ * Constant-initialized, so a static AsyncSlot needs no start-up code.
+ * Hand out one promise() and one result() per round; reset() only once
+ * both have been used (or dropped).
+ */
+template<typename T, typename E = ErrorCode>
+class AsyncSlot {
+    static_assert(!std::is_reference_v<T>, "AsyncSlot stores the value; use a pointer to share a reference");
+
+public:
+    constexpr AsyncSlot() noexcept = default;
+    AsyncSlot(const AsyncSlot&) = delete;
+    AsyncSlot& operator=(const AsyncSlot&) = delete;
+
+    ~AsyncSlot() { destroy(); }
+
+    /**
+     * @brief Producer handle for this round
+     */
+    Promise<T, E> promise() noexcept { return Promise<T, E>(this); }
+
+    /**
+     * @brief Consumer handle for this round
+     */
+    AsyncResult<T, E> result() noexcept { return AsyncResult<T, E>(this); }
+
+    /**
+     * @brief Check whether the Result has been published
+     */
+    bool isReady() const noexcept {
+        return (signal_.state.load(std::memory_order_acquire) & kReady) != 0;
+    }
+
+    /**
+     * @brief Drop the stored Result and re-arm the slot for the next round
+     * @note Neither handle of the current round may be used concurrently
+     */
+    void reset() noexcept {
+        destroy();
+        callback_ = nullptr;
+        context_ = nullptr;
+        signal_.state.store(0, std::memory_order_release);
+    }
+
+    /// State bits in AsyncSignal::state
+    static constexpr uint32_t kReady = 1u << 0;     ///< Result constructed and published
+    static constexpr uint32_t kWaiting = 1u << 1;   ///< Consumer is (about to be) blocked
+    static constexpr uint32_t kCallback = 1u << 2;  ///< Continuation registered
+
+private:
+    friend class Promise<T, E>;
+    friend class AsyncResult<T, E>;
+
+    Result<T, E>* stored() noexcept {
+        return std::launder(reinterpret_cast<Result<T, E>*>(storage_));
+    }
+
+    void destroy() noexcept {
+        if ((signal_.state.load(std::memory_order_acquire) & kReady) != 0) {
+            stored()->~Result<T, E>();
+        }
+    }
+
+    // The one atomic step of completion; the wake-up and the continuation
+    // only happen if the consumer got there first. seq_cst, like block(),
+    // so a backend reading signal.waiter afterwards cannot miss a waiter.
+    void publish() {
+        const uint32_t before = signal_.state.fetch_or(kReady, std::memory_order_seq_cst);
+        if (LIBCOMMON_UNLIKELY((before & kWaiting) != 0)) {
+            const AsyncWaitBackend backend = detail::asyncWaitBackend;
+            backend.wake(signal_, backend.context);
+        }
+        if ((before & kCallback) != 0) {
+            callback_(std::move(*stored()), context_);
+        }
+    }
+
+    bool block(uint32_t timeoutMs) noexcept {
+        const uint32_t before = signal_.state.fetch_or(kWaiting, std::memory_order_seq_cst);
+        if ((before & kReady) != 0) {
+            return true;
+        }
+        const AsyncWaitBackend backend = detail::asyncWaitBackend;
+        backend.wait(signal_, before | kWaiting, timeoutMs, backend.context);
+        if (isReady()) {
+            return true;
+        }
+        // Spare the producer a wake-up nobody is waiting for
+        return (signal_.state.fetch_and(~kWaiting, std::memory_order_acq_rel) & kReady) != 0;
+    }
+
+    void subscribe(typename AsyncResult<T, E>::Callback callback, void* context) {
+        callback_ = callback;
+        context_ = context;
+        const uint32_t before = signal_.state.fetch_or(kCallback, std::memory_order_acq_rel);
+        if ((before & kReady) != 0) {
+            callback(std::move(*stored()), context);
+        }
+    }
+
+    AsyncSignal signal_;
+    typename AsyncResult<T, E>::Callback callback_ = nullptr;
+    void* context_ = nullptr;
+    alignas(Result<T, E>) unsigned char storage_[sizeof(Result<T, E>)] = {};
+};
+
+} // namespace common
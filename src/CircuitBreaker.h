@@ -0,0 +1,298 @@
+/**
+ * @file CircuitBreaker.h
+ * @brief Fail fast while a device keeps failing
+ *
+ * A CircuitBreaker watches the outcomes of the calls it wraps in a sliding
+ * window of the last windowSize calls. When at least minimumCalls are in
+ * the window and failureThresholdPercent of them failed, it trips OPEN:
+ * calls return ErrorCode::RESOURCE_UNAVAILABLE at once instead of spending
+ * bus time on timeouts. After openMs it lets one probe call through
+ * (HALF_OPEN); if the probe succeeds the breaker closes with an empty
+ * window, otherwise it opens for another openMs.
+ *
+ * Only errors the device is to blame for count as failures (by default
+ * isRetryable(): timeouts, CRC errors, disconnects, ...). An error such as
+ * INVALID_PARAMETER proves the device answered and counts as a success.
+ *
+ * The whole state (window, or the time it opened) is one 32-bit atomic
+ * word updated by compare-and-swap, so several tasks can share one
+ * breaker per device without a mutex.
+ *
+ * @code
+ * CircuitBreaker slave3;   // one per Modbus slave, shared by all pollers
+ *
+ * auto value = slave3.call([&] { return modbus.readHolding(3, 0x10); });
+ * if (value.error() == ErrorCode::RESOURCE_UNAVAILABLE) {
+ *     // Slave 3 is offline; skip it this cycle
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "ErrorCodes.h"
+#include "Result.h"
+#include "Retry.h"
+
+namespace common {
+
+/**
+ * @brief When a CircuitBreaker trips and for how long it stays open
+ */
+struct CircuitBreakerConfig {
+    uint8_t windowSize = 10;               ///< Outcomes remembered (1-24)
+    uint8_t minimumCalls = 5;              ///< Outcomes needed before it can trip
+    uint8_t failureThresholdPercent = 50;  ///< Trip when this share of the window failed
+    uint32_t openMs = 5000;                ///< Time open before a probe is let through
+    bool (*isFailure)(ErrorCode error) = nullptr;  ///< nullptr: isRetryable()
+};
+
+/**
+ * @brief State of a CircuitBreaker
+ */
+enum class CircuitState : uint8_t {
+    CLOSED,     ///< Calls go through; outcomes are counted
+    OPEN,       ///< Calls fail fast
+    HALF_OPEN,  ///< One probe call is in flight
+};
+
+/**
+ * @brief What CircuitBreaker::acquire() allows the caller to do
+ */
+enum class CircuitPermit : uint8_t {
+    REJECTED,  ///< Do not call; fail fast
+    CALL,      ///< Call; the outcome goes into the window
+    PROBE,     ///< Call; the outcome closes or reopens the breaker
+};
+
+/**
+ * @class CircuitBreaker
+ * @brief Lock-free circuit breaker for calls returning Result<T>
+ *
+ * call() covers the usual case. acquire() and record() split it for
+ * callers that cannot wrap the operation in a callable.
+ */
+class CircuitBreaker {
+public:
+    /// Largest supported window
+    static constexpr uint8_t kMaxWindow = 24;
+
+    /// Longest supported openMs (about six days)
+    static constexpr uint32_t kMaxOpenMs = 0x1FFFFFFF;
+
+    /**
+     * @brief Create a closed breaker
+     * @param config Window and thresholds; windowSize is clamped to 1-24,
+     *        minimumCalls to 1-windowSize and openMs to 1-kMaxOpenMs
+     * @param timer Clock to use; nullptr for the timer installed with
+     *        setRetryTimer(), read at each call
+     */
+    explicit CircuitBreaker(const CircuitBreakerConfig& config = CircuitBreakerConfig(),
+                            const RetryTimer* timer = nullptr) noexcept
+        : config_(config), timer_(timer) {
+        if (config_.windowSize == 0 || config_.windowSize > kMaxWindow) {
+            config_.windowSize = config_.windowSize == 0 ? 1 : kMaxWindow;
+        }
+        if (config_.minimumCalls == 0 || config_.minimumCalls > config_.windowSize) {
+            config_.minimumCalls = config_.minimumCalls == 0 ? 1 : config_.windowSize;
+        }
+        if (config_.openMs == 0 || config_.openMs > kMaxOpenMs) {
+            config_.openMs = config_.openMs == 0 ? 1 : kMaxOpenMs;
+        }
+    }
+
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    /**
+     * @brief Call fn unless the breaker is open
+     * @param fn Callable returning Result<T> (ErrorCode errors)
+     * @return fn's Result, or RESOURCE_UNAVAILABLE without calling fn
+     */
+    template<typename F>
+    auto call(F&& fn) -> std::invoke_result_t<F&> {
+        using ResultType = std::invoke_result_t<F&>;
+        static_assert(detail::IsErrorCodeResult<ResultType>::value,
+                      "CircuitBreaker::call() needs a callable returning Result<T>");
+
+        const CircuitPermit permit = acquire();
+        if (LIBCOMMON_UNLIKELY(permit == CircuitPermit::REJECTED)) {
+            return ResultType::error(ErrorCode::RESOURCE_UNAVAILABLE);
+        }
+        ResultType result = fn();
+        record(permit, result.isOk() ? ErrorCode::OK : result.error());
+        return result;
+    }
+
+    /**
+     * @brief Ask whether a call may go ahead
+     *
+     * When openMs has passed since the breaker opened (or since the last
+     * probe started without reporting back), the first caller gets PROBE
+     * and the breaker turns HALF_OPEN; everyone else is REJECTED.
+     */
+    CircuitPermit acquire() noexcept {
+        uint32_t word = state_.load(std::memory_order_acquire);
+        for (;;) {
+            if (stateOf(word) == CircuitState::CLOSED) {
+                return CircuitPermit::CALL;
+            }
+            const uint32_t now = clock().now(clock().context);
+            if (((now - payloadOf(word)) & kPayloadMask) < config_.openMs) {
+                return CircuitPermit::REJECTED;
+            }
+            // The new word carries the probe's start, so losers see a fresh probe
+            if (state_.compare_exchange_weak(word, pack(CircuitState::HALF_OPEN, now),
+                                             std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return CircuitPermit::PROBE;
+            }
+        }
+    }
+
+    /**
+     * @brief Report the outcome of a call allowed by acquire()
+     * @param permit What acquire() returned
+     * @param outcome ErrorCode::OK or the call's error
+     */
+    void record(CircuitPermit permit, ErrorCode outcome) noexcept {
+        if (permit == CircuitPermit::REJECTED) {
+            return;
+        }
+        const bool failed = outcome != ErrorCode::OK &&
+                            (config_.isFailure != nullptr ? config_.isFailure(outcome) : isRetryable(outcome));
+        uint32_t word = state_.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t next;
+            if (permit == CircuitPermit::PROBE) {
+                if (stateOf(word) != CircuitState::HALF_OPEN) {
+                    return;  // Another probe already decided
+                }
+                next = failed ? pack(CircuitState::OPEN, clock().now(clock().context))
+                              : pack(CircuitState::CLOSED, 0);
+            } else {
+                if (stateOf(word) != CircuitState::CLOSED) {
+                    return;  // Started before the breaker opened
+                }
+                const uint32_t mask = (1u << config_.windowSize) - 1;
+                const uint32_t history = ((historyOf(word) << 1) | (failed ? 1u : 0u)) & mask;
+                const uint8_t count = static_cast<uint8_t>(countOf(word) + (countOf(word) < config_.windowSize));
+                next = failed && tripped(history, count) ? pack(CircuitState::OPEN, clock().now(clock().context))
+                                                         : pack(CircuitState::CLOSED, closedPayload(count, history));
+            }
+            if (next == word) {
+                return;  // Healthy and the window is full of successes: no write
+            }
+            if (state_.compare_exchange_weak(word, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                if (stateOf(next) == CircuitState::OPEN) {
+                    trips_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Current state
+     */
+    CircuitState state() const noexcept {
+        return stateOf(state_.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Outcomes in the window (0 unless CLOSED)
+     */
+    uint8_t calls() const noexcept {
+        const uint32_t word = state_.load(std::memory_order_acquire);
+        return stateOf(word) == CircuitState::CLOSED ? countOf(word) : 0;
+    }
+
+    /**
+     * @brief Failures in the window (0 unless CLOSED)
+     */
+    uint8_t failures() const noexcept {
+        const uint32_t word = state_.load(std::memory_order_acquire);
+        return stateOf(word) == CircuitState::CLOSED ? popcount(historyOf(word)) : 0;
+    }
+
+    /**
+     * @brief Times the breaker has opened since construction or reset()
+     */
+    uint32_t trips() const noexcept {
+        return trips_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Close the breaker and forget all outcomes
+     */
+    void reset() noexcept {
+        state_.store(pack(CircuitState::CLOSED, 0), std::memory_order_release);
+        trips_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Configuration in use (after clamping)
+     */
+    const CircuitBreakerConfig& config() const noexcept {
+        return config_;
+    }
+
+private:
+    // State word: bits 0-1 state, bits 2-31 payload.
+    // CLOSED: payload bits 0-4 count the outcomes, bits 5-28 hold the
+    // window with the newest outcome lowest (1 = failed).
+    // OPEN and HALF_OPEN: payload is the time it opened or the probe
+    // started (ms, 30 bits), so every transition is a single CAS.
+    static constexpr uint32_t kPayloadShift = 2;
+    static constexpr uint32_t kPayloadMask = 0x3FFFFFFF;
+    static constexpr uint32_t kHistoryShift = 5;
+
+    static constexpr uint32_t pack(CircuitState state, uint32_t payload) noexcept {
+        return static_cast<uint32_t>(state) | (payload << kPayloadShift);
+    }
+
+    static constexpr uint32_t closedPayload(uint8_t count, uint32_t history) noexcept {
+        return count | (history << kHistoryShift);
+    }
+
+    static constexpr CircuitState stateOf(uint32_t word) noexcept {
+        return static_cast<CircuitState>(word & 0x03);
+    }
+
+    static constexpr uint32_t payloadOf(uint32_t word) noexcept {
+        return word >> kPayloadShift;
+    }
+
+    static constexpr uint8_t countOf(uint32_t word) noexcept {
+        return static_cast<uint8_t>(payloadOf(word) & 0x1F);
+    }
+
+    static constexpr uint32_t historyOf(uint32_t word) noexcept {
+        return payloadOf(word) >> kHistoryShift;
+    }
+
+    static constexpr uint8_t popcount(uint32_t bits) noexcept {
+        uint8_t count = 0;
+        for (; bits != 0; bits &= bits - 1) {
+            ++count;
+        }
+        return count;
+    }
+
+    bool tripped(uint32_t history, uint8_t count) const noexcept {
+        return count >= config_.minimumCalls &&
+               popcount(history) * 100u >= static_cast<uint32_t>(config_.failureThresholdPercent) * count;
+    }
+
+    const RetryTimer& clock() const noexcept {
+        return timer_ != nullptr ? *timer_ : detail::retryTimer;
+    }
+
+    CircuitBreakerConfig config_;
+    const RetryTimer* timer_;
+    std::atomic<uint32_t> state_{pack(CircuitState::CLOSED, 0)};
+    std::atomic<uint32_t> trips_{0};
+};
+
+} // namespace common
@@ -9,7 +9,25 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
+
+/**
+ * @def LIBCOMMON_HAS_ENUMERATOR_CHECK
+ * @brief 1 if enum tables can be checked against the enum at compile time
+ *        (default: GCC 9+ and Clang)
+ *
+ * Enables the ErrorDomain names check. Define as 0 to skip it.
+ */
+#ifndef LIBCOMMON_HAS_ENUMERATOR_CHECK
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9)
+#define LIBCOMMON_HAS_ENUMERATOR_CHECK 1
+#else
+#define LIBCOMMON_HAS_ENUMERATOR_CHECK 0
+#endif
+#endif
 
 namespace common {
 
@@ -107,71 +125,6 @@ enum class ErrorCode : int16_t {
     SSL_ERROR = 404,                ///< SSL/TLS error
 };
 
-/**
- * @brief Convert error code to string representation
- * @param code The error code to convert
- * @return String representation of the error code
- */
-inline const char* errorCodeToString(ErrorCode code) {
-    switch (code) {
-        case ErrorCode::OK: return "OK";
-        case ErrorCode::UNKNOWN_ERROR: return "Unknown error";
-        case ErrorCode::NOT_INITIALIZED: return "Not initialized";
-        case ErrorCode::ALREADY_INITIALIZED: return "Already initialized";
-        case ErrorCode::INVALID_PARAMETER: return "Invalid parameter";
-        case ErrorCode::INVALID_STATE: return "Invalid state";
-        case ErrorCode::NOT_SUPPORTED: return "Not supported";
-        case ErrorCode::NOT_IMPLEMENTED: return "Not implemented";
-        case ErrorCode::BUSY: return "Busy";
-        case ErrorCode::WOULD_BLOCK: return "Would block";
-        case ErrorCode::OUT_OF_MEMORY: return "Out of memory";
-        case ErrorCode::RESOURCE_EXHAUSTED: return "Resource exhausted";
-        case ErrorCode::RESOURCE_NOT_FOUND: return "Resource not found";
-        case ErrorCode::RESOURCE_LOCKED: return "Resource locked";
-        case ErrorCode::RESOURCE_UNAVAILABLE: return "Resource unavailable";
-        case ErrorCode::TIMEOUT: return "Timeout";
-        case ErrorCode::MUTEX_ERROR: return "Mutex error";
-        case ErrorCode::SEMAPHORE_ERROR: return "Semaphore error";
-        case ErrorCode::DEADLOCK_DETECTED: return "Deadlock detected";
-        case ErrorCode::QUEUE_FULL: return "Queue full";
-        case ErrorCode::QUEUE_EMPTY: return "Queue empty";
-        case ErrorCode::IO_ERROR: return "I/O error";
-        case ErrorCode::READ_ERROR: return "Read error";
-        case ErrorCode::WRITE_ERROR: return "Write error";
-        case ErrorCode::PERMISSION_DENIED: return "Permission denied";
-        case ErrorCode::DATA_NOT_READY: return "Data not ready";
-        case ErrorCode::DATA_CORRUPTED: return "Data corrupted";
-        case ErrorCode::CRC_ERROR: return "CRC error";
-        case ErrorCode::CHECKSUM_ERROR: return "Checksum error";
-        case ErrorCode::BUFFER_OVERFLOW: return "Buffer overflow";
-        case ErrorCode::BUFFER_UNDERFLOW: return "Buffer underflow";
-        case ErrorCode::INVALID_DATA: return "Invalid data";
-        case ErrorCode::DEVICE_NOT_FOUND: return "Device not found";
-        case ErrorCode::DEVICE_ERROR: return "Device error";
-        case ErrorCode::DEVICE_BUSY: return "Device busy";
-        case ErrorCode::DEVICE_DISCONNECTED: return "Device disconnected";
-        case ErrorCode::HARDWARE_FAILURE: return "Hardware failure";
-        case ErrorCode::COMMUNICATION_ERROR: return "Communication error";
-        case ErrorCode::CONNECTION_FAILED: return "Connection failed";
-        case ErrorCode::CONNECTION_LOST: return "Connection lost";
-        case ErrorCode::CONNECTION_REFUSED: return "Connection refused";
-        case ErrorCode::PROTOCOL_ERROR: return "Protocol error";
-        case ErrorCode::SEND_FAILED: return "Send failed";
-        case ErrorCode::RECEIVE_FAILED: return "Receive failed";
-        case ErrorCode::STORAGE_ERROR: return "Storage error";
-        case ErrorCode::STORAGE_FULL: return "Storage full";
-        case ErrorCode::FILE_NOT_FOUND: return "File not found";
-        case ErrorCode::FILE_EXISTS: return "File exists";
-        case ErrorCode::MOUNT_FAILED: return "Mount failed";
-        case ErrorCode::NETWORK_ERROR: return "Network error";
-        case ErrorCode::NETWORK_UNREACHABLE: return "Network unreachable";
-        case ErrorCode::HOST_UNREACHABLE: return "Host unreachable";
-        case ErrorCode::DNS_FAILED: return "DNS failed";
-        case ErrorCode::SSL_ERROR: return "SSL error";
-        default: return "Unknown error code";
-    }
-}
-
 /**
  * @brief Check if error code indicates success
  * @param code The error code to check
@@ -190,4 +143,572 @@ constexpr bool isError(ErrorCode code) noexcept {
     return code != ErrorCode::OK;
 }
 
+/**
+ * @enum ErrorCategory
+ * @brief Band of an error code (see the ranges documented on ErrorCode)
+ */
+enum class ErrorCategory : uint8_t {
+    NONE = 0,             ///< OK
+    GENERAL = 1,          ///< 1-9
+    RESOURCE = 2,         ///< 10-29
+    SYNCHRONIZATION = 3,  ///< 30-49
+    IO = 4,               ///< 50-69
+    DATA = 5,             ///< 70-99
+    DEVICE = 6,           ///< 100-199
+    COMMUNICATION = 7,    ///< 200-299
+    STORAGE = 8,          ///< 300-399
+    NETWORK = 9,          ///< 400-499
+    LIBRARY = 10,         ///< 500 and above: library-specific codes
+    UNKNOWN = 11,         ///< Not an ErrorCode value
+};
+
+/**
+ * @enum ErrorSeverity
+ * @brief How serious an error is
+ */
+enum class ErrorSeverity : uint8_t {
+    NONE = 0,             ///< Not an error (OK)
+    WARNING = 1,          ///< Expected now and then; normal operation continues
+    ERROR = 2,            ///< The operation failed
+    FATAL = 3,            ///< The system cannot continue without intervention
+};
+
+namespace detail {
+
+/// Retrying the same operation cannot help
+constexpr uint8_t kPermanent = 0;
+/// Retrying the same operation may succeed
+constexpr uint8_t kRetryable = 1;
+/// Retryable, and the cause clears by itself: wait, then retry
+constexpr uint8_t kTransient = 3;
+
+/**
+ * @brief One row of the error code table; every field is required
+ */
+struct ErrorCodeInfo {
+    constexpr ErrorCodeInfo(ErrorCode code, const char* text, ErrorSeverity severity, uint8_t recovery)
+        : code(code), text(text), severity(severity), recovery(recovery) {}
+
+    ErrorCode code;
+    const char* text;
+    ErrorSeverity severity;
+    uint8_t recovery;
+};
+
+/**
+ * @brief Every ErrorCode value with its text and classification, in
+ *        ascending order
+ *
+ * The single list of codes: a code added to the enum must be added here.
+ * Only used at compile time; the strings end up in kErrorCodeStrings and
+ * the classification in kErrorCodeClasses.
+ */
+inline constexpr ErrorCodeInfo kErrorCodeInfo[] = {
+    {ErrorCode::OK,                   "OK",                   ErrorSeverity::NONE,    kPermanent},
+    {ErrorCode::UNKNOWN_ERROR,        "Unknown error",        ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::NOT_INITIALIZED,      "Not initialized",      ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::ALREADY_INITIALIZED,  "Already initialized",  ErrorSeverity::WARNING, kPermanent},
+    {ErrorCode::INVALID_PARAMETER,    "Invalid parameter",    ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::INVALID_STATE,        "Invalid state",        ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::NOT_SUPPORTED,        "Not supported",        ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::NOT_IMPLEMENTED,      "Not implemented",      ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::BUSY,                 "Busy",                 ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::WOULD_BLOCK,          "Would block",          ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::OUT_OF_MEMORY,        "Out of memory",        ErrorSeverity::FATAL,   kPermanent},
+    {ErrorCode::RESOURCE_EXHAUSTED,   "Resource exhausted",   ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::RESOURCE_NOT_FOUND,   "Resource not found",   ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::RESOURCE_LOCKED,      "Resource locked",      ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::RESOURCE_UNAVAILABLE, "Resource unavailable", ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::TIMEOUT,              "Timeout",              ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::MUTEX_ERROR,          "Mutex error",          ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::SEMAPHORE_ERROR,      "Semaphore error",      ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::DEADLOCK_DETECTED,    "Deadlock detected",    ErrorSeverity::FATAL,   kPermanent},
+    {ErrorCode::QUEUE_FULL,           "Queue full",           ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::QUEUE_EMPTY,          "Queue empty",          ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::IO_ERROR,             "I/O error",            ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::READ_ERROR,           "Read error",           ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::WRITE_ERROR,          "Write error",          ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::PERMISSION_DENIED,    "Permission denied",    ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::DATA_NOT_READY,       "Data not ready",       ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::DATA_CORRUPTED,       "Data corrupted",       ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::CRC_ERROR,            "CRC error",            ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::CHECKSUM_ERROR,       "Checksum error",       ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::BUFFER_OVERFLOW,      "Buffer overflow",      ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::BUFFER_UNDERFLOW,     "Buffer underflow",     ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::INVALID_DATA,         "Invalid data",         ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::DEVICE_NOT_FOUND,     "Device not found",     ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::DEVICE_ERROR,         "Device error",         ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::DEVICE_BUSY,          "Device busy",          ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::DEVICE_DISCONNECTED,  "Device disconnected",  ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::HARDWARE_FAILURE,     "Hardware failure",     ErrorSeverity::FATAL,   kPermanent},
+    {ErrorCode::COMMUNICATION_ERROR,  "Communication error",  ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::CONNECTION_FAILED,    "Connection failed",    ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::CONNECTION_LOST,      "Connection lost",      ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::CONNECTION_REFUSED,   "Connection refused",   ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::PROTOCOL_ERROR,       "Protocol error",       ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::SEND_FAILED,          "Send failed",          ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::RECEIVE_FAILED,       "Receive failed",       ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::STORAGE_ERROR,        "Storage error",        ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::STORAGE_FULL,         "Storage full",         ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::FILE_NOT_FOUND,       "File not found",       ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::FILE_EXISTS,          "File exists",          ErrorSeverity::WARNING, kPermanent},
+    {ErrorCode::MOUNT_FAILED,         "Mount failed",         ErrorSeverity::ERROR,   kPermanent},
+    {ErrorCode::NETWORK_ERROR,        "Network error",        ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::NETWORK_UNREACHABLE,  "Network unreachable",  ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::HOST_UNREACHABLE,     "Host unreachable",     ErrorSeverity::WARNING, kTransient},
+    {ErrorCode::DNS_FAILED,           "DNS failed",           ErrorSeverity::ERROR,   kRetryable},
+    {ErrorCode::SSL_ERROR,            "SSL error",            ErrorSeverity::ERROR,   kPermanent},
+};
+
+} // namespace detail
+
+/// Number of distinct ErrorCode values (SUCCESS is an alias of OK)
+constexpr size_t kErrorCodeCount = sizeof(detail::kErrorCodeInfo) / sizeof(detail::kErrorCodeInfo[0]);
+
+namespace detail {
+
+constexpr std::array<ErrorCode, kErrorCodeCount> makeAllErrorCodes() {
+    std::array<ErrorCode, kErrorCodeCount> codes{};
+    for (size_t i = 0; i < kErrorCodeCount; ++i) {
+        codes[i] = kErrorCodeInfo[i].code;
+    }
+    return codes;
+}
+
+} // namespace detail
+
+/**
+ * @brief Every ErrorCode value in ascending order
+ */
+inline constexpr std::array<ErrorCode, kErrorCodeCount> kAllErrorCodes = detail::makeAllErrorCodes();
+
+namespace detail {
+
+constexpr int kMaxErrorCodeValue = static_cast<int>(kAllErrorCodes[kErrorCodeCount - 1]);
+
+struct ErrorCodeIndexTable {
+    uint8_t index[kMaxErrorCodeValue + 1];
+};
+
+constexpr ErrorCodeIndexTable makeErrorCodeIndexTable() {
+    ErrorCodeIndexTable table{};
+    for (int value = 0; value <= kMaxErrorCodeValue; ++value) {
+        table.index[value] = static_cast<uint8_t>(kErrorCodeCount);
+    }
+    for (size_t i = 0; i < kErrorCodeCount; ++i) {
+        table.index[static_cast<int>(kAllErrorCodes[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+}
+
+inline constexpr ErrorCodeIndexTable kErrorCodeIndex = makeErrorCodeIndexTable();
+
+constexpr bool errorCodesAscending() {
+    for (size_t i = 1; i < kErrorCodeCount; ++i) {
+        if (kAllErrorCodes[i - 1] >= kAllErrorCodes[i]) {
+            return false;
+        }
+    }
+    return kAllErrorCodes[0] >= ErrorCode::OK;
+}
+
+} // namespace detail
+
+static_assert(kErrorCodeCount < 255, "ErrorCode index must fit in uint8_t");
+static_assert(detail::errorCodesAscending(),
+              "kErrorCodeInfo must list every ErrorCode once, in ascending order");
+
+/**
+ * @brief Dense index of an error code, for per-code tables
+ * @param code The error code
+ * @return Position of code in kAllErrorCodes, or kErrorCodeCount for
+ *         values that are not ErrorCode enumerators
+ */
+constexpr size_t errorCodeIndex(ErrorCode code) noexcept {
+    const int value = static_cast<int>(code);
+    return (value >= 0 && value <= detail::kMaxErrorCodeValue)
+        ? detail::kErrorCodeIndex.index[value]
+        : kErrorCodeCount;
+}
+
+namespace detail {
+
+inline constexpr char kUnknownErrorCodeText[] = "Unknown error code";
+
+constexpr size_t textLength(const char* text) noexcept {
+    size_t length = 0;
+    while (text[length] != '\0') {
+        ++length;
+    }
+    return length;
+}
+
+constexpr size_t errorCodePoolSize() {
+    size_t size = sizeof(kUnknownErrorCodeText);
+    for (const auto& entry : kErrorCodeInfo) {
+        size += textLength(entry.text) + 1;
+    }
+    return size;
+}
+
+/**
+ * @brief All error code texts in one NUL-separated block, indexed by
+ *        errorCodeIndex() (the last offset is the unknown-code text)
+ */
+struct ErrorCodeStringPool {
+    char chars[errorCodePoolSize()];
+    uint16_t offsets[kErrorCodeCount + 1];
+};
+
+static_assert(errorCodePoolSize() <= UINT16_MAX, "error code texts must fit 16-bit offsets");
+
+constexpr ErrorCodeStringPool makeErrorCodeStringPool() {
+    ErrorCodeStringPool pool{};
+    size_t used = 0;
+    for (size_t i = 0; i <= kErrorCodeCount; ++i) {
+        const char* text = i < kErrorCodeCount ? kErrorCodeInfo[i].text : kUnknownErrorCodeText;
+        pool.offsets[i] = static_cast<uint16_t>(used);
+        for (size_t c = 0; text[c] != '\0'; ++c) {
+            pool.chars[used++] = text[c];
+        }
+        pool.chars[used++] = '\0';
+    }
+    return pool;
+}
+
+inline constexpr ErrorCodeStringPool kErrorCodeStrings = makeErrorCodeStringPool();
+
+} // namespace detail
+
+/**
+ * @brief Convert error code to string representation
+ * @param code The error code to convert
+ * @return String representation of the error code
+ */
+constexpr const char* errorCodeToString(ErrorCode code) {
+    return detail::kErrorCodeStrings.chars + detail::kErrorCodeStrings.offsets[errorCodeIndex(code)];
+}
+
+namespace detail {
+
+/**
+ * @brief Enumerator names that errorCodeFromString() accepts but that do
+ *        not fold to the code's text (the others match it already)
+ */
+struct ErrorCodeAlias {
+    ErrorCode code;
+    const char* name;
+};
+
+inline constexpr ErrorCodeAlias kErrorCodeAliases[] = {
+    {ErrorCode::OK,       "SUCCESS"},
+    {ErrorCode::IO_ERROR, "IO_ERROR"},
+};
+
+/*
+ * Perfect hash of the folded texts and aliases ("keys": the texts in
+ * errorCodeIndex() order, then the aliases), built at compile time by hash
+ * and displace: a key's hash picks one of kNameBuckets seeds, and the
+ * hash mixed with that seed picks its slot. Seeds are chosen bucket by
+ * bucket, largest first, so that no two keys share a slot.
+ */
+constexpr size_t kNameBuckets = 16;
+constexpr size_t kNameSlots = 64;
+constexpr size_t kNameKeyCount = kErrorCodeCount + sizeof(kErrorCodeAliases) / sizeof(kErrorCodeAliases[0]);
+
+static_assert(kNameKeyCount <= kNameSlots, "grow kNameSlots with the number of codes");
+
+// Ignores ASCII case and treats '_' as a space, so "CRC_ERROR" matches "CRC error"
+constexpr char foldName(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : (c == '_' ? ' ' : c);
+}
+
+constexpr uint32_t nameHash(const char* text, size_t length) noexcept {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(foldName(text[i]));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr size_t nameSlot(uint32_t hash, uint8_t seed) noexcept {
+    hash ^= seed * 0x9E3779B9u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return hash % kNameSlots;
+}
+
+constexpr const char* nameKey(size_t key) noexcept {
+    return key < kErrorCodeCount ? kErrorCodeStrings.chars + kErrorCodeStrings.offsets[key]
+                                 : kErrorCodeAliases[key - kErrorCodeCount].name;
+}
+
+struct ErrorCodeNameHash {
+    uint8_t seeds[kNameBuckets];
+    uint8_t slots[kNameSlots];  ///< Key in the slot, kNameKeyCount if empty
+    bool complete;
+};
+
+constexpr ErrorCodeNameHash makeErrorCodeNameHash() {
+    ErrorCodeNameHash table{};
+    for (auto& slot : table.slots) {
+        slot = static_cast<uint8_t>(kNameKeyCount);
+    }
+
+    uint32_t hashes[kNameKeyCount] = {};
+    size_t bucketSize[kNameBuckets] = {};
+    for (size_t i = 0; i < kNameKeyCount; ++i) {
+        hashes[i] = nameHash(nameKey(i), textLength(nameKey(i)));
+        ++bucketSize[hashes[i] % kNameBuckets];
+    }
+
+    for (size_t size = kNameKeyCount; size > 0; --size) {
+        for (size_t bucket = 0; bucket < kNameBuckets; ++bucket) {
+            if (bucketSize[bucket] != size) {
+                continue;
+            }
+            bool placed = false;
+            for (uint32_t seed = 0; seed <= UINT8_MAX && !placed; ++seed) {
+                placed = true;
+                for (size_t i = 0; i < kNameKeyCount && placed; ++i) {
+                    if (hashes[i] % kNameBuckets != bucket) {
+                        continue;
+                    }
+                    const size_t slot = nameSlot(hashes[i], static_cast<uint8_t>(seed));
+                    if (table.slots[slot] == kNameKeyCount) {
+                        table.slots[slot] = static_cast<uint8_t>(i);
+                    } else {
+                        placed = false;
+                    }
+                }
+                if (!placed) {
+                    // Undo this bucket's partial placement
+                    for (auto& slot : table.slots) {
+                        if (slot < kNameKeyCount && hashes[slot] % kNameBuckets == bucket) {
+                            slot = static_cast<uint8_t>(kNameKeyCount);
+                        }
+                    }
+                } else {
+                    table.seeds[bucket] = static_cast<uint8_t>(seed);
+                }
+            }
+            if (!placed) {
+                return table;
+            }
+        }
+    }
+    table.complete = true;
+    return table;
+}
+
+inline constexpr ErrorCodeNameHash kErrorCodeNameHash = makeErrorCodeNameHash();
+
+static_assert(kErrorCodeNameHash.complete,
+              "no perfect hash found: error code texts and aliases must differ ignoring case and '_'");
+
+} // namespace detail
+
+/**
+ * @brief Parse an error code from its text (as returned by
+ *        errorCodeToString()) or its enumerator name
+ *
+ * Matching ignores ASCII case and treats '_' as a space, so "Timeout",
+ * "timeout" and "TIMEOUT" parse as ErrorCode::TIMEOUT, and "CRC error"
+ * and "CRC_ERROR" as ErrorCode::CRC_ERROR. Names that differ from the
+ * text in other ways ("IO_ERROR" for "I/O error", "SUCCESS") are listed
+ * in detail::kErrorCodeAliases. Costs one hash of the text and one
+ * comparison.
+ *
+ * @param text The text (need not be NUL-terminated)
+ * @param length Number of characters in text
+ * @param code Set to the parsed code on success
+ * @return true if text names an error code
+ */
+constexpr bool errorCodeFromString(const char* text, size_t length, ErrorCode& code) noexcept {
+    const uint32_t hash = detail::nameHash(text, length);
+    const size_t slot = detail::nameSlot(hash, detail::kErrorCodeNameHash.seeds[hash % detail::kNameBuckets]);
+    const size_t key = detail::kErrorCodeNameHash.slots[slot];
+    if (key >= detail::kNameKeyCount) {
+        return false;
+    }
+    const char* name = detail::nameKey(key);
+    for (size_t i = 0; i < length; ++i) {
+        if (name[i] == '\0' || detail::foldName(name[i]) != detail::foldName(text[i])) {
+            return false;
+        }
+    }
+    if (name[length] != '\0') {
+        return false;
+    }
+    code = key < kErrorCodeCount ? kAllErrorCodes[key]
+                                 : detail::kErrorCodeAliases[key - kErrorCodeCount].code;
+    return true;
+}
+
+/**
+ * @brief Parse a NUL-terminated error code text
+ * @param text The text or name, e.g. "Timeout" or "TIMEOUT"
+ * @param code Set to the parsed code on success
+ * @return true if text names an error code
+ */
+constexpr bool errorCodeFromString(const char* text, ErrorCode& code) noexcept {
+    return errorCodeFromString(text, detail::textLength(text), code);
+}
+
+namespace detail {
+
+constexpr uint8_t kClassCategoryMask = 0x0F;
+constexpr uint8_t kClassSeverityShift = 4;
+constexpr uint8_t kClassRetryable = 0x40;
+constexpr uint8_t kClassTransient = 0x80;
+
+/**
+ * @brief Category of a code value from the documented ranges
+ */
+constexpr ErrorCategory bandCategory(int value) noexcept {
+    return value == 0 ? ErrorCategory::NONE
+         : value < 0 ? ErrorCategory::UNKNOWN
+         : value < 10 ? ErrorCategory::GENERAL
+         : value < 30 ? ErrorCategory::RESOURCE
+         : value < 50 ? ErrorCategory::SYNCHRONIZATION
+         : value < 70 ? ErrorCategory::IO
+         : value < 100 ? ErrorCategory::DATA
+         : value < 200 ? ErrorCategory::DEVICE
+         : value < 300 ? ErrorCategory::COMMUNICATION
+         : value < 400 ? ErrorCategory::STORAGE
+         : value < 500 ? ErrorCategory::NETWORK
+         : ErrorCategory::LIBRARY;
+}
+
+constexpr uint8_t packClass(ErrorCategory category, ErrorSeverity severity, uint8_t recovery) noexcept {
+    return static_cast<uint8_t>(static_cast<uint8_t>(category) |
+                                (static_cast<uint8_t>(severity) << kClassSeverityShift) |
+                                ((recovery & kRetryable) ? kClassRetryable : 0) |
+                                ((recovery == kTransient) ? kClassTransient : 0));
+}
+
+constexpr uint8_t kUnknownClass = packClass(ErrorCategory::UNKNOWN, ErrorSeverity::ERROR, kPermanent);
+constexpr uint8_t kLibraryClass = packClass(ErrorCategory::LIBRARY, ErrorSeverity::ERROR, kPermanent);
+
+/**
+ * @brief Packed classification of every value up to the largest code:
+ *        category (bits 0-3), severity (bits 4-5), retryable, transient
+ */
+struct ErrorCodeClassTable {
+    uint8_t bits[kMaxErrorCodeValue + 1];
+};
+
+constexpr ErrorCodeClassTable makeErrorCodeClassTable() {
+    ErrorCodeClassTable table{};
+    for (auto& bits : table.bits) {
+        bits = kUnknownClass;
+    }
+    for (const auto& info : kErrorCodeInfo) {
+        const int value = static_cast<int>(info.code);
+        table.bits[value] = packClass(bandCategory(value), info.severity, info.recovery);
+    }
+    return table;
+}
+
+inline constexpr ErrorCodeClassTable kErrorCodeClasses = makeErrorCodeClassTable();
+
+constexpr uint8_t errorCodeClass(ErrorCode code) noexcept {
+    const int value = static_cast<int>(code);
+    return (value >= 0 && value <= kMaxErrorCodeValue) ? kErrorCodeClasses.bits[value]
+         : value >= 500 ? kLibraryClass
+         : kUnknownClass;
+}
+
+constexpr bool classificationIsConsistent() {
+    for (const auto& info : kErrorCodeInfo) {
+        const bool ok = info.code == ErrorCode::OK;
+        if (ok != (info.severity == ErrorSeverity::NONE) || (ok && info.recovery != kPermanent)) {
+            return false;
+        }
+        if (info.recovery != kPermanent && info.recovery != kRetryable && info.recovery != kTransient) {
+            return false;
+        }
+        if (static_cast<int>(info.code) >= 500) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(classificationIsConsistent(),
+              "only OK has severity NONE, recovery is kPermanent, kRetryable or kTransient, "
+              "and common codes stay below 500");
+
+#if LIBCOMMON_HAS_ENUMERATOR_CHECK
+/*
+ * The compiler spells a value with an enumerator as "Enum::NAME" (or
+ * "NAME") in __PRETTY_FUNCTION__ and one without as "(Enum)N", which
+ * tells enumerators apart from other values at compile time. The check
+ * of kErrorCodeInfo against all 500 ErrorCode values lives in
+ * test/test_error_codes.cpp, so library users do not pay for it.
+ */
+template<typename E, E Value>
+constexpr bool isEnumerator() noexcept {
+    const char* signature = __PRETTY_FUNCTION__;
+    const char* value = signature;
+    for (const char* p = signature; *p != '\0'; ++p) {
+        if (*p == '=') {
+            value = p + 1;
+        }
+    }
+    while (*value == ' ') {
+        ++value;
+    }
+    return *value != '(' && (*value < '0' || *value > '9') && *value != '-';
+}
+
+static_assert(isEnumerator<ErrorCode, ErrorCode::TIMEOUT>() &&
+              !isEnumerator<ErrorCode, static_cast<ErrorCode>(29)>(),
+              "unexpected __PRETTY_FUNCTION__ format");
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Category of an error code (from the documented numeric ranges)
+ * @param code The error code
+ * @return The category; LIBRARY for values of 500 and above, UNKNOWN for
+ *         other values that are not ErrorCode enumerators
+ */
+constexpr ErrorCategory category(ErrorCode code) noexcept {
+    return static_cast<ErrorCategory>(detail::errorCodeClass(code) & detail::kClassCategoryMask);
+}
+
+/**
+ * @brief Severity of an error code (ERROR for values outside the enum)
+ */
+constexpr ErrorSeverity severity(ErrorCode code) noexcept {
+    return static_cast<ErrorSeverity>((detail::errorCodeClass(code) >> detail::kClassSeverityShift) & 0x03);
+}
+
+/**
+ * @brief Check if retrying the failed operation may succeed
+ */
+constexpr bool isRetryable(ErrorCode code) noexcept {
+    return (detail::errorCodeClass(code) & detail::kClassRetryable) != 0;
+}
+
+/**
+ * @brief Check if the cause clears by itself (busy, timeout, queue full,
+ *        ...), so the operation should be retried after a wait.
+ *        Transient errors are always retryable.
+ */
+constexpr bool isTransient(ErrorCode code) noexcept {
+    return (detail::errorCodeClass(code) & detail::kClassTransient) != 0;
+}
+
+/**
+ * @brief Check if the error leaves the system unable to continue
+ */
+constexpr bool isFatal(ErrorCode code) noexcept {
+    return severity(code) == ErrorSeverity::FATAL;
+}
+
 } // namespace common
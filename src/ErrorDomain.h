@@ -0,0 +1,307 @@
+/**
+ * @file ErrorDomain.h
+ * @brief Library-specific error enums in the 500+ range
+ *
+ * A library declares its error enum as an error domain: the first common
+ * value of its range and one text per enumerator (enumerators must be
+ * 0, 1, 2, ...). Its errors then convert to and from the common 32-bit
+ * ErrorValue, and to ErrorCode, so they can travel in a Result<T>.
+ *
+ * The application lists the domains it links in an ErrorDomainSet. The
+ * set checks at compile time that no two ranges overlap and merges all
+ * texts into one table, so toString() works for any value without a
+ * runtime registry, static constructors or heap.
+ *
+ * @code
+ * // In the library
+ * namespace modbus {
+ * enum class Error : uint8_t { ILLEGAL_FUNCTION, ILLEGAL_ADDRESS, CRC_MISMATCH };
+ * }
+ *
+ * template<>
+ * struct common::ErrorDomain<modbus::Error> {
+ *     static constexpr ErrorValue first = 600;
+ *     static constexpr const char* names[] = {
+ *         "Illegal function", "Illegal address", "CRC mismatch"};
+ * };
+ *
+ * Result<uint16_t> readRegister() {
+ *     return Result<uint16_t>::error(toErrorCode(modbus::Error::CRC_MISMATCH));
+ * }
+ *
+ * // In the application
+ * using AppErrors = ErrorDomainSet<modbus::Error, wifi::Error>;
+ * printf("%s\n", AppErrors::toString(result.error()));   // "CRC mismatch"
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "ErrorCodes.h"
+
+namespace common {
+
+/// Common error value: an ErrorCode (0-499) or a domain error (500+)
+using ErrorValue = int32_t;
+
+/// First value available to error domains
+constexpr ErrorValue kFirstDomainErrorValue = 500;
+
+/**
+ * @brief Declares enum E as an error domain; specialize per library
+ *
+ * A specialization provides:
+ * - `static constexpr ErrorValue first`: common value of enumerator 0
+ * - `static constexpr const char* names[]`: text of each enumerator
+ */
+template<typename E>
+struct ErrorDomain;
+
+namespace detail {
+
+template<typename E, typename = void>
+struct IsErrorDomain : std::false_type {};
+
+template<typename E>
+struct IsErrorDomain<E, std::void_t<decltype(ErrorDomain<E>::first), decltype(ErrorDomain<E>::names)>>
+    : std::is_enum<E> {};
+
+} // namespace detail
+
+/**
+ * @brief Check if E has an ErrorDomain specialization
+ */
+template<typename E>
+inline constexpr bool isErrorDomain = detail::IsErrorDomain<E>::value;
+
+namespace detail {
+
+#if LIBCOMMON_HAS_ENUMERATOR_CHECK
+template<typename E, size_t... Values>
+constexpr bool namesMatchEnumerators(std::index_sequence<Values...>) noexcept {
+    return (isEnumerator<E, static_cast<E>(Values)>() && ...) &&
+           !isEnumerator<E, static_cast<E>(sizeof...(Values))>();
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Range and checks of error domain E
+ */
+template<typename E>
+struct ErrorDomainRange {
+    static_assert(isErrorDomain<E>, "E needs an ErrorDomain<E> specialization with first and names");
+
+    static constexpr size_t count = sizeof(ErrorDomain<E>::names) / sizeof(ErrorDomain<E>::names[0]);
+    static constexpr ErrorValue first = ErrorDomain<E>::first;
+    static constexpr ErrorValue last = first + static_cast<ErrorValue>(count) - 1;
+
+    static_assert(first >= kFirstDomainErrorValue, "error domains start at 500; 0-499 belong to ErrorCode");
+#if LIBCOMMON_HAS_ENUMERATOR_CHECK
+    static_assert(detail::namesMatchEnumerators<E>(std::make_index_sequence<count>()),
+                  "ErrorDomain names need one entry per enumerator, and enumerators must be 0, 1, 2, ...");
+#endif
+};
+
+/**
+ * @brief Common value of a domain error
+ */
+template<typename E, typename = std::enable_if_t<isErrorDomain<E>>>
+constexpr ErrorValue toErrorValue(E error) noexcept {
+    return ErrorDomainRange<E>::first + static_cast<ErrorValue>(error);
+}
+
+/**
+ * @brief Common value of an ErrorCode (its numeric value)
+ */
+constexpr ErrorValue toErrorValue(ErrorCode code) noexcept {
+    return static_cast<ErrorValue>(code);
+}
+
+/**
+ * @brief Convert a common value back to a domain error
+ * @param value The common value
+ * @param error Set to the domain error if value lies in E's range
+ * @return true if value belongs to domain E
+ */
+template<typename E, typename = std::enable_if_t<isErrorDomain<E>>>
+constexpr bool fromErrorValue(ErrorValue value, E& error) noexcept {
+    if (value < ErrorDomainRange<E>::first || value > ErrorDomainRange<E>::last) {
+        return false;
+    }
+    error = static_cast<E>(value - ErrorDomainRange<E>::first);
+    return true;
+}
+
+/**
+ * @brief Carry a domain error as an ErrorCode, e.g. in a Result<T>
+ *
+ * errorCodeToString() does not know the value; use an ErrorDomainSet.
+ */
+template<typename E, typename = std::enable_if_t<isErrorDomain<E>>>
+constexpr ErrorCode toErrorCode(E error) noexcept {
+    static_assert(ErrorDomainRange<E>::last <= INT16_MAX, "domain range must fit ErrorCode (int16_t)");
+    return static_cast<ErrorCode>(toErrorValue(error));
+}
+
+/**
+ * @brief Text of a domain error
+ */
+template<typename E, typename = std::enable_if_t<isErrorDomain<E>>>
+constexpr const char* errorCodeToString(E error) noexcept {
+    const auto index = static_cast<size_t>(error);
+    return index < ErrorDomainRange<E>::count ? ErrorDomain<E>::names[index] : detail::kUnknownErrorCodeText;
+}
+
+namespace detail {
+
+struct DomainSpan {
+    ErrorValue first;
+    ErrorValue last;
+    uint16_t nameIndex;  ///< Position of the first name in the merged table
+};
+
+template<typename... Domains>
+constexpr std::array<DomainSpan, sizeof...(Domains)> sortedDomainSpans() {
+    std::array<DomainSpan, sizeof...(Domains)> spans{};
+    size_t count = 0;
+    uint16_t names = 0;
+    ((spans[count++] = DomainSpan{ErrorDomainRange<Domains>::first, ErrorDomainRange<Domains>::last, names},
+      names = static_cast<uint16_t>(names + ErrorDomainRange<Domains>::count)), ...);
+
+    // Insertion sort by first value
+    for (size_t i = 1; i < spans.size(); ++i) {
+        for (size_t j = i; j > 0 && spans[j].first < spans[j - 1].first; --j) {
+            const DomainSpan swap = spans[j];
+            spans[j] = spans[j - 1];
+            spans[j - 1] = swap;
+        }
+    }
+    return spans;
+}
+
+template<typename... Domains>
+constexpr size_t domainPoolSize() {
+    size_t size = 0;
+    ((size += [] {
+        size_t bytes = 0;
+        for (const char* name : ErrorDomain<Domains>::names) {
+            bytes += textLength(name) + 1;
+        }
+        return bytes;
+    }()), ...);
+    return size;
+}
+
+/**
+ * @brief Texts of all domains in one NUL-separated block with 16-bit
+ *        offsets, in the order the domains are listed
+ */
+template<size_t PoolSize, size_t NameCount>
+struct DomainStringPool {
+    char chars[PoolSize];
+    uint16_t offsets[NameCount];
+};
+
+template<typename... Domains>
+constexpr auto makeDomainStringPool() {
+    constexpr size_t kNames = (ErrorDomainRange<Domains>::count + ... + 0);
+    static_assert(domainPoolSize<Domains...>() <= UINT16_MAX, "domain texts must fit 16-bit offsets");
+    DomainStringPool<domainPoolSize<Domains...>(), kNames> pool{};
+    size_t used = 0;
+    size_t index = 0;
+    ([&] {
+        for (const char* name : ErrorDomain<Domains>::names) {
+            pool.offsets[index++] = static_cast<uint16_t>(used);
+            for (size_t c = 0; name[c] != '\0'; ++c) {
+                pool.chars[used++] = name[c];
+            }
+            pool.chars[used++] = '\0';
+        }
+    }(), ...);
+    return pool;
+}
+
+} // namespace detail
+
+/**
+ * @brief Check at compile time that no two domain ranges overlap
+ */
+template<typename... Domains>
+constexpr bool errorDomainsDisjoint() {
+    const auto spans = detail::sortedDomainSpans<Domains...>();
+    for (size_t i = 1; i < spans.size(); ++i) {
+        if (spans[i].first <= spans[i - 1].last) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @class ErrorDomainSet
+ * @brief The error domains an application links, merged at compile time
+ *
+ * @tparam Domains Error domain enums; their ranges must not overlap
+ */
+template<typename... Domains>
+class ErrorDomainSet {
+    static_assert(sizeof...(Domains) > 0, "list at least one error domain");
+    static_assert((isErrorDomain<Domains> && ...), "every type needs an ErrorDomain specialization");
+    static_assert(errorDomainsDisjoint<Domains...>(), "error domain ranges overlap");
+
+public:
+    /// Number of domain errors in the set
+    static constexpr size_t kNameCount = (ErrorDomainRange<Domains>::count + ... + 0);
+
+    /**
+     * @brief Check if E is one of the set's domains
+     */
+    template<typename E>
+    static constexpr bool contains = (std::is_same_v<E, Domains> || ...);
+
+    /**
+     * @brief Text of any common value: ErrorCode or a domain error
+     * @param value The common value
+     * @return The text, or "Unknown error code"
+     */
+    static constexpr const char* toString(ErrorValue value) noexcept {
+        if (value < kFirstDomainErrorValue) {
+            return value >= INT16_MIN ? errorCodeToString(static_cast<ErrorCode>(value))
+                                      : detail::kUnknownErrorCodeText;
+        }
+        for (const auto& span : kSpans) {
+            if (value >= span.first && value <= span.last) {
+                return kPool.chars + kPool.offsets[span.nameIndex + (value - span.first)];
+            }
+        }
+        return detail::kUnknownErrorCodeText;
+    }
+
+    /**
+     * @brief Text of an ErrorCode, including domain errors carried in it
+     */
+    static constexpr const char* toString(ErrorCode code) noexcept {
+        return toString(toErrorValue(code));
+    }
+
+    /**
+     * @brief Text of a domain error of this set
+     */
+    template<typename E, typename = std::enable_if_t<contains<E>>>
+    static constexpr const char* toString(E error) noexcept {
+        return toString(toErrorValue(error));
+    }
+
+private:
+    static constexpr auto kSpans = detail::sortedDomainSpans<Domains...>();
+    static constexpr auto kPool = detail::makeDomainStringPool<Domains...>();
+};
+
+} // namespace common
@@ -0,0 +1,144 @@
+/**
+ * @file ErrorLocation.h
+ * @brief Compact source-location tags for errors
+ *
+ * With LIBCOMMON_ERROR_LOCATION enabled, every error Result records where
+ * it was created as a 32-bit tag: a 20-bit id of the source file name and
+ * the 12-bit line number. The tag is computed at compile time, so no file
+ * names end up in the firmware. tools/error_tag.py maps tags back to
+ * file:line using the project's sources.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @def LIBCOMMON_ERROR_LOCATION
+ * @brief Record where each error was created (default 0)
+ *
+ * When 1, error Results carry a 4-byte ErrorLocation that survives
+ * propagation through the macros and the chaining API. When 0,
+ * ErrorLocation is an empty type and Result layout is unchanged.
+ */
+#ifndef LIBCOMMON_ERROR_LOCATION
+#define LIBCOMMON_ERROR_LOCATION 0
+#endif
+
+/**
+ * @def LIBCOMMON_LOCATION_CONSTEVAL
+ * @brief Specifier of ErrorLocation::current(): consteval where supported
+ *
+ * consteval forces the file-name hash to run at compile time even without
+ * optimization. It is only used where an immediate call in a default
+ * argument sees the caller's position (CWG 2631: GCC 14+, Clang 17+);
+ * elsewhere current() is constexpr, and the hash of the constant file name
+ * is folded by the optimizer (-O1 and above).
+ */
+#ifndef LIBCOMMON_LOCATION_CONSTEVAL
+#if defined(__cpp_consteval) && \
+    ((defined(__clang__) && __clang_major__ >= 17) || \
+     (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 14))
+#define LIBCOMMON_LOCATION_CONSTEVAL consteval
+#else
+#define LIBCOMMON_LOCATION_CONSTEVAL constexpr
+#endif
+#endif
+
+namespace common {
+
+namespace detail {
+
+constexpr uint32_t kLocationLineBits = 12;
+constexpr uint32_t kLocationMaxLine = (1u << kLocationLineBits) - 1;
+constexpr uint32_t kLocationFileIdMask = (1u << (32 - kLocationLineBits)) - 1;
+
+/**
+ * @brief 20-bit id of a source file: FNV-1a of the file name, without
+ *        directories, so ids do not depend on the build location
+ */
+constexpr uint32_t locationFileId(const char* path) noexcept {
+    const char* name = path;
+    for (const char* p = path; *p != '\0'; ++p) {
+        if (*p == '/' || *p == '\\') {
+            name = p + 1;
+        }
+    }
+    uint32_t hash = 2166136261u;
+    for (; *name != '\0'; ++name) {
+        hash ^= static_cast<uint8_t>(*name);
+        hash *= 16777619u;
+    }
+    return hash & kLocationFileIdMask;
+}
+
+/**
+ * @brief Pack file id and line (clamped to 4095) into a location tag
+ */
+constexpr uint32_t locationTag(const char* path, uint32_t line) noexcept {
+    return (locationFileId(path) << kLocationLineBits) |
+           (line < kLocationMaxLine ? line : kLocationMaxLine);
+}
+
+} // namespace detail
+
+/**
+ * @class ErrorLocation
+ * @brief Where an error was created, as a 32-bit tag
+ *
+ * Obtained with current(), normally as a defaulted last parameter so it
+ * records the caller's position. A tag of 0 means unknown (recording
+ * disabled, or an error created before the option was enabled).
+ */
+class ErrorLocation {
+public:
+    constexpr ErrorLocation() noexcept = default;
+
+#if LIBCOMMON_ERROR_LOCATION
+    explicit constexpr ErrorLocation(uint32_t tag) noexcept : tag_(tag) {}
+
+    /**
+     * @brief Location of the call site (when used as a default argument)
+     */
+    static LIBCOMMON_LOCATION_CONSTEVAL ErrorLocation current(
+        uint32_t tag = detail::locationTag(__builtin_FILE(), __builtin_LINE())) noexcept {
+        return ErrorLocation(tag);
+    }
+
+    /**
+     * @brief The packed tag, 0 if unknown
+     */
+    constexpr uint32_t tag() const noexcept { return tag_; }
+#else
+    explicit constexpr ErrorLocation(uint32_t) noexcept {}
+
+    static constexpr ErrorLocation current() noexcept { return ErrorLocation(); }
+
+    constexpr uint32_t tag() const noexcept { return 0; }
+#endif
+
+    /**
+     * @brief Check if the location is known
+     */
+    constexpr bool isKnown() const noexcept { return tag() != 0; }
+
+    /**
+     * @brief 20-bit file id (see tools/error_tag.py)
+     */
+    constexpr uint32_t fileId() const noexcept { return tag() >> detail::kLocationLineBits; }
+
+    /**
+     * @brief Line number; 4095 means 4095 or later
+     */
+    constexpr uint32_t line() const noexcept { return tag() & detail::kLocationMaxLine; }
+
+    constexpr bool operator==(ErrorLocation other) const noexcept { return tag() == other.tag(); }
+    constexpr bool operator!=(ErrorLocation other) const noexcept { return tag() != other.tag(); }
+
+private:
+#if LIBCOMMON_ERROR_LOCATION
+    uint32_t tag_ = 0;
+#endif
+};
+
+} // namespace common
@@ -0,0 +1,200 @@
+/**
+ * @file ErrorStats.h
+ * @brief Per-ErrorCode occurrence counters and per-second rate windows
+ *
+ * With LIBCOMMON_ERROR_STATS enabled, every ErrorCode error created
+ * through Result (error(), the error constructors, makeError(),
+ * makeFailure() and RETURN_ERROR_IF) is counted once. Propagating an
+ * existing error does not count again.
+ *
+ * Recording is one relaxed atomic increment in a table indexed by
+ * errorCodeIndex(). Rates are derived by tick(), which one task calls
+ * once per second: it turns the change in each total into a per-second
+ * count kept for the last LIBCOMMON_ERROR_STATS_WINDOW seconds.
+ *
+ * @code
+ * // 1 Hz timer / task
+ * errorStats().tick();
+ *
+ * ErrorStat stats[kErrorCodeCount];
+ * size_t n = errorStats().snapshot(stats, kErrorCodeCount);
+ * @endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "ErrorCodes.h"
+
+/**
+ * @def LIBCOMMON_ERROR_STATS
+ * @brief Count errors created through Result (default 0)
+ */
+#ifndef LIBCOMMON_ERROR_STATS
+#define LIBCOMMON_ERROR_STATS 0
+#endif
+
+/**
+ * @def LIBCOMMON_ERROR_STATS_WINDOW
+ * @brief Seconds of per-second history kept per code (default 8)
+ */
+#ifndef LIBCOMMON_ERROR_STATS_WINDOW
+#define LIBCOMMON_ERROR_STATS_WINDOW 8
+#endif
+
+namespace common {
+
+/**
+ * @brief Statistics of one error code
+ */
+struct ErrorStat {
+    ErrorCode code;        ///< The error code
+    uint32_t total;        ///< Occurrences since start (or reset())
+    uint16_t lastSecond;   ///< Occurrences in the last completed second
+    uint16_t peak;         ///< Highest per-second count in the window
+    uint32_t windowTotal;  ///< Occurrences in the window
+};
+
+/**
+ * @class ErrorStatistics
+ * @brief Lock-free registry of error counts, indexed densely by ErrorCode
+ *
+ * record() and the getters may be called from any thread or ISR; tick()
+ * and reset() from one task at a time.
+ */
+class ErrorStatistics {
+public:
+    /// Slots: one per ErrorCode plus one for values outside the enum
+    static constexpr size_t kSlots = kErrorCodeCount + 1;
+    static constexpr size_t kWindow = LIBCOMMON_ERROR_STATS_WINDOW;
+
+    constexpr ErrorStatistics() noexcept = default;
+    ErrorStatistics(const ErrorStatistics&) = delete;
+    ErrorStatistics& operator=(const ErrorStatistics&) = delete;
+
+    /**
+     * @brief Count one occurrence of code
+     */
+    void record(ErrorCode code) noexcept {
+        totals_[errorCodeIndex(code)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Occurrences of code since start (or reset())
+     */
+    uint32_t total(ErrorCode code) const noexcept {
+        return totals_[errorCodeIndex(code)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Occurrences of values that are not ErrorCode enumerators
+     */
+    uint32_t otherTotal() const noexcept {
+        return totals_[kErrorCodeCount].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Close the current one-second window; call once per second
+     */
+    void tick() noexcept {
+        const uint32_t tick = ticks_.load(std::memory_order_relaxed);
+        const size_t slot = tick % kWindow;
+        for (size_t i = 0; i < kSlots; ++i) {
+            const uint32_t now = totals_[i].load(std::memory_order_relaxed);
+            const uint32_t delta = now - lastTotals_[i];
+            lastTotals_[i] = now;
+            window_[i][slot].store(static_cast<uint16_t>(delta > UINT16_MAX ? UINT16_MAX : delta),
+                                   std::memory_order_relaxed);
+        }
+        ticks_.store(tick + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of completed one-second windows
+     */
+    uint32_t ticks() const noexcept { return ticks_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Per-second counts of code, oldest first
+     * @param code The error code
+     * @param out Destination for up to maxSeconds counts
+     * @param maxSeconds Capacity of out; the newest seconds are kept
+     * @return Number of seconds written (at most kWindow)
+     */
+    size_t history(ErrorCode code, uint16_t* out, size_t maxSeconds) const noexcept {
+        const uint32_t tick = ticks();
+        size_t count = tick < kWindow ? tick : kWindow;
+        if (count > maxSeconds) {
+            count = maxSeconds;
+        }
+        const size_t index = errorCodeIndex(code);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t second = tick - static_cast<uint32_t>(count) + static_cast<uint32_t>(i);
+            out[i] = window_[index][second % kWindow].load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Statistics of one code
+     */
+    ErrorStat stat(ErrorCode code) const noexcept {
+        uint16_t seconds[kWindow];
+        const size_t count = history(code, seconds, kWindow);
+        ErrorStat result{code, total(code), 0, 0, 0};
+        for (size_t i = 0; i < count; ++i) {
+            result.windowTotal += seconds[i];
+            result.peak = seconds[i] > result.peak ? seconds[i] : result.peak;
+        }
+        result.lastSecond = count > 0 ? seconds[count - 1] : 0;
+        return result;
+    }
+
+    /**
+     * @brief Statistics of every code that has occurred, in code order
+     * @param out Destination (kErrorCodeCount entries always suffice)
+     * @param maxEntries Capacity of out
+     * @return Number of entries written
+     */
+    size_t snapshot(ErrorStat* out, size_t maxEntries) const noexcept {
+        size_t written = 0;
+        for (size_t i = 0; i < kErrorCodeCount && written < maxEntries; ++i) {
+            if (totals_[i].load(std::memory_order_relaxed) != 0) {
+                out[written++] = stat(kAllErrorCodes[i]);
+            }
+        }
+        return written;
+    }
+
+    /**
+     * @brief Clear all counts and windows
+     */
+    void reset() noexcept {
+        for (size_t i = 0; i < kSlots; ++i) {
+            totals_[i].store(0, std::memory_order_relaxed);
+            lastTotals_[i] = 0;
+            for (auto& second : window_[i]) {
+                second.store(0, std::memory_order_relaxed);
+            }
+        }
+        ticks_.store(0, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t> totals_[kSlots] = {};
+    uint32_t lastTotals_[kSlots] = {};
+    std::atomic<uint16_t> window_[kSlots][kWindow] = {};
+    std::atomic<uint32_t> ticks_{0};
+};
+
+/**
+ * @brief The process-wide registry used by the Result hook
+ */
+inline ErrorStatistics& errorStats() noexcept {
+    static ErrorStatistics stats;
+    return stats;
+}
+
+} // namespace common
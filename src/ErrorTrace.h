@@ -0,0 +1,395 @@
+/**
+ * @file ErrorTrace.h
+ * @brief Per-thread ring buffers recording error propagation hops
+ *
+ * With LIBCOMMON_ERROR_TRACE enabled, every error that RETURN_IF_ERROR,
+ * ASSIGN_OR_RETURN, RESULT_TRY or RETURN_ERROR_IF passes on is recorded as
+ * a TraceEntry (timestamp, location tag of the macro, error code) in a
+ * ring owned by the current thread. After a fault the rings show the path
+ * each error took, without any logging on the hot path.
+ *
+ * Recording is wait-free: the owning thread is the only writer, so a hop
+ * is a few relaxed stores and one release store. Rings come from a
+ * static pool (no allocation); threads that find the pool exhausted are
+ * not traced. Other threads may snapshot or dump rings concurrently and
+ * never see torn entries.
+ *
+ * A ring goes back to the pool when its thread exits through a
+ * thread_local destructor. FreeRTOS tasks ended with vTaskDelete() do not
+ * run those, so such tasks call releaseErrorTraceRing() before exiting.
+ *
+ * Location tags use the same format as ErrorLocation and are decoded by
+ * tools/error_tag.py, which also decodes dumpErrorTrace() blobs.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "ErrorLocation.h"
+
+#if defined(ESP_PLATFORM)
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * @def LIBCOMMON_ERROR_TRACE
+ * @brief Record error propagation hops in the propagation macros (default 0)
+ */
+#ifndef LIBCOMMON_ERROR_TRACE
+#define LIBCOMMON_ERROR_TRACE 0
+#endif
+
+/**
+ * @def LIBCOMMON_ERROR_TRACE_DEPTH
+ * @brief Entries per thread ring (power of two, default 32)
+ */
+#ifndef LIBCOMMON_ERROR_TRACE_DEPTH
+#define LIBCOMMON_ERROR_TRACE_DEPTH 32
+#endif
+
+/**
+ * @def LIBCOMMON_ERROR_TRACE_THREADS
+ * @brief Number of rings in the pool, i.e. traced threads (default 8)
+ */
+#ifndef LIBCOMMON_ERROR_TRACE_THREADS
+#define LIBCOMMON_ERROR_TRACE_THREADS 8
+#endif
+
+namespace common {
+
+/**
+ * @brief One recorded propagation hop
+ */
+struct TraceEntry {
+    uint32_t timestamp;  ///< Trace clock at the hop (microseconds by default)
+    uint32_t location;   ///< Location tag of the propagating macro
+    int32_t code;        ///< Error code, converted to int32_t
+};
+
+/**
+ * @class ErrorTraceRing
+ * @brief Single-writer ring of the most recent TraceEntry records
+ *
+ * push() may only be called by one thread at a time; snapshot() may be
+ * called from any thread at any time.
+ */
+class ErrorTraceRing {
+public:
+    static constexpr uint32_t kDepth = LIBCOMMON_ERROR_TRACE_DEPTH;
+    static_assert((kDepth & (kDepth - 1)) == 0 && kDepth > 0,
+                  "LIBCOMMON_ERROR_TRACE_DEPTH must be a power of two");
+
+    constexpr ErrorTraceRing() noexcept = default;
+    ErrorTraceRing(const ErrorTraceRing&) = delete;
+    ErrorTraceRing& operator=(const ErrorTraceRing&) = delete;
+
+    /**
+     * @brief Append an entry, overwriting the oldest when full (writer only)
+     */
+    void push(uint32_t timestamp, uint32_t location, int32_t code) noexcept {
+        const uint32_t index = head_.load(std::memory_order_relaxed);
+        // Announce the slot before overwriting it, so readers drop it
+        pending_.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Slot& slot = slots_[index & (kDepth - 1)];
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+        slot.location.store(location, std::memory_order_relaxed);
+        slot.code.store(code, std::memory_order_relaxed);
+        head_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the retained entries, oldest first
+     * @param out Destination for up to maxEntries entries
+     * @param maxEntries Capacity of out; the newest entries are kept
+     * @return Number of entries written
+     */
+    size_t snapshot(TraceEntry* out, size_t maxEntries) const noexcept {
+        const uint32_t end = head_.load(std::memory_order_acquire);
+        uint32_t begin = end - (end < kDepth ? end : kDepth);
+        const uint32_t base = base_.load(std::memory_order_relaxed);
+        if (static_cast<int32_t>(base - begin) > 0) {
+            begin = base;
+        }
+        if (end - begin > maxEntries) {
+            begin = end - static_cast<uint32_t>(maxEntries);
+        }
+
+        for (uint32_t i = begin; i != end; ++i) {
+            const Slot& slot = slots_[i & (kDepth - 1)];
+            TraceEntry& entry = out[i - begin];
+            entry.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            entry.location = slot.location.load(std::memory_order_relaxed);
+            entry.code = slot.code.load(std::memory_order_relaxed);
+        }
+
+        // Entries the writer started to overwrite while we copied are torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint32_t pending = pending_.load(std::memory_order_relaxed);
+        uint32_t firstValid = begin;
+        if (static_cast<int32_t>(pending - kDepth - begin) > 0) {
+            firstValid = pending - kDepth;
+        }
+        if (static_cast<int32_t>(firstValid - end) >= 0) {
+            return 0;
+        }
+        const uint32_t skip = firstValid - begin;
+        for (uint32_t i = skip; i != end - begin; ++i) {
+            out[i - skip] = out[i];
+        }
+        return end - firstValid;
+    }
+
+    /**
+     * @brief Total entries ever pushed (including overwritten ones)
+     */
+    uint32_t pushed() const noexcept { return head_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Id of the thread claim that owns this ring, 0 if never claimed
+     */
+    uint32_t owner() const noexcept { return owner_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Take ownership for a new thread (see detail::claimTraceRing)
+     * @return true if the ring was free
+     */
+    bool tryClaim(uint32_t ownerId) noexcept {
+        bool expected = false;
+        if (!claimed_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        base_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        owner_.store(ownerId, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Give the ring back to the pool; its entries stay readable
+     */
+    void release() noexcept { claimed_.store(false, std::memory_order_release); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> timestamp{0};
+        std::atomic<uint32_t> location{0};
+        std::atomic<int32_t> code{0};
+    };
+
+    Slot slots_[kDepth];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> pending_{0};
+    std::atomic<uint32_t> base_{0};
+    std::atomic<uint32_t> owner_{0};
+    std::atomic<bool> claimed_{false};
+};
+
+namespace detail {
+
+inline uint32_t defaultTraceClock() noexcept {
+#if defined(ESP_PLATFORM)
+    return static_cast<uint32_t>(esp_timer_get_time());
+#else
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline std::atomic<uint32_t (*)()> traceClock{&defaultTraceClock};
+
+inline ErrorTraceRing* traceRings() noexcept {
+    static ErrorTraceRing rings[LIBCOMMON_ERROR_TRACE_THREADS];
+    return rings;
+}
+
+inline std::atomic<uint32_t> traceOwnerCount{0};
+inline std::atomic<uint32_t> traceUntracedThreads{0};
+
+// Returns the ring to the pool when its thread exits (if still held)
+struct TraceRingLease {
+    ErrorTraceRing* ring = nullptr;
+
+    ~TraceRingLease() {
+        if (ring != nullptr) {
+            ring->release();
+        }
+    }
+};
+
+inline thread_local ErrorTraceRing* currentTraceRing = nullptr;
+inline thread_local bool traceRingRequested = false;
+inline thread_local TraceRingLease traceRingLease;
+
+/**
+ * @brief Claim a free ring for the calling thread (first hop only)
+ */
+inline ErrorTraceRing* claimTraceRing() noexcept {
+    TraceRingLease& lease = traceRingLease;
+    traceRingRequested = true;
+    const uint32_t ownerId = traceOwnerCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    ErrorTraceRing* rings = traceRings();
+    for (size_t i = 0; i < LIBCOMMON_ERROR_TRACE_THREADS; ++i) {
+        if (rings[i].tryClaim(ownerId)) {
+            lease.ring = &rings[i];
+            currentTraceRing = &rings[i];
+            return &rings[i];
+        }
+    }
+    traceUntracedThreads.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+} // namespace detail
+
+/**
+ * @brief Record one propagation hop for the calling thread
+ *
+ * Called by the propagation macros when LIBCOMMON_ERROR_TRACE is 1;
+ * may also be called directly.
+ *
+ * @param code Error code
+ * @param location Location tag of the hop
+ */
+inline void recordErrorHop(int32_t code, uint32_t location) noexcept {
+    ErrorTraceRing* ring = detail::currentTraceRing;
+    if (ring == nullptr) {
+        if (detail::traceRingRequested) {
+            return;
+        }
+        ring = detail::claimTraceRing();
+        if (ring == nullptr) {
+            return;
+        }
+    }
+    ring->push(detail::traceClock.load(std::memory_order_relaxed)(), location, code);
+}
+
+/**
+ * @brief Replace the timestamp source (default: microseconds since boot)
+ */
+inline void setErrorTraceClock(uint32_t (*clock)()) noexcept {
+    detail::traceClock.store(clock != nullptr ? clock : &detail::defaultTraceClock,
+                             std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy the calling thread's trace, oldest hop first
+ * @return Number of entries written (0 if the thread has recorded nothing)
+ */
+inline size_t snapshotErrorTrace(TraceEntry* out, size_t maxEntries) noexcept {
+    const ErrorTraceRing* ring = detail::currentTraceRing;
+    return ring != nullptr ? ring->snapshot(out, maxEntries) : 0;
+}
+
+/**
+ * @brief Give the calling thread's ring back to the pool now
+ *
+ * Needed by threads that end without running thread_local destructors,
+ * such as FreeRTOS tasks deleting themselves with vTaskDelete(NULL): call
+ * it just before. The ring's entries stay in dumps until another thread
+ * claims it. Recording a hop afterwards claims a new ring.
+ */
+inline void releaseErrorTraceRing() noexcept {
+    ErrorTraceRing* ring = detail::currentTraceRing;
+    detail::currentTraceRing = nullptr;
+    detail::traceRingRequested = false;
+    detail::traceRingLease.ring = nullptr;
+    if (ring != nullptr) {
+        ring->release();
+    }
+}
+
+/**
+ * @brief Number of threads that recorded hops but found no free ring
+ */
+inline uint32_t untracedThreadCount() noexcept {
+    return detail::traceUntracedThreads.load(std::memory_order_relaxed);
+}
+
+/// Size of the dumpErrorTrace() header
+constexpr size_t kErrorTraceDumpHeaderSize = 8;
+/// Size of each ring header in a dump
+constexpr size_t kErrorTraceDumpRingHeaderSize = 8;
+/// Size of each entry in a dump
+constexpr size_t kErrorTraceDumpEntrySize = 12;
+/// Buffer size that always holds a complete dump
+constexpr size_t kErrorTraceDumpMaxSize =
+    kErrorTraceDumpHeaderSize +
+    LIBCOMMON_ERROR_TRACE_THREADS *
+        (kErrorTraceDumpRingHeaderSize + LIBCOMMON_ERROR_TRACE_DEPTH * kErrorTraceDumpEntrySize);
+
+namespace detail {
+
+inline uint8_t* putLe16(uint8_t* out, uint16_t value) noexcept {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    return out + 2;
+}
+
+inline uint8_t* putLe32(uint8_t* out, uint32_t value) noexcept {
+    out = putLe16(out, static_cast<uint16_t>(value));
+    return putLe16(out, static_cast<uint16_t>(value >> 16));
+}
+
+} // namespace detail
+
+/**
+ * @brief Serialize all rings that were ever used into a binary blob
+ *
+ * Little-endian layout:
+ * - header: "ETR1", u16 ring count, u16 entry size (12)
+ * - per ring: u32 owner id, u16 entry count, u16 0
+ * - per entry, oldest first: u32 timestamp, u32 location, i32 code
+ *
+ * Rings that do not fit in the buffer are left out (and not counted).
+ *
+ * @param buffer Destination (kErrorTraceDumpMaxSize always suffices)
+ * @param capacity Size of buffer
+ * @return Bytes written, 0 if not even the header fits
+ */
+inline size_t dumpErrorTrace(uint8_t* buffer, size_t capacity) noexcept {
+    if (capacity < kErrorTraceDumpHeaderSize) {
+        return 0;
+    }
+    uint8_t* out = buffer + kErrorTraceDumpHeaderSize;
+    uint16_t ringCount = 0;
+    TraceEntry entries[LIBCOMMON_ERROR_TRACE_DEPTH];
+    const ErrorTraceRing* rings = detail::traceRings();
+
+    for (size_t i = 0; i < LIBCOMMON_ERROR_TRACE_THREADS; ++i) {
+        const uint32_t owner = rings[i].owner();
+        if (owner == 0) {
+            continue;
+        }
+        const size_t count = rings[i].snapshot(entries, LIBCOMMON_ERROR_TRACE_DEPTH);
+        const size_t size = kErrorTraceDumpRingHeaderSize + count * kErrorTraceDumpEntrySize;
+        if (size > capacity - static_cast<size_t>(out - buffer)) {
+            break;
+        }
+        out = detail::putLe32(out, owner);
+        out = detail::putLe16(out, static_cast<uint16_t>(count));
+        out = detail::putLe16(out, 0);
+        for (size_t e = 0; e < count; ++e) {
+            out = detail::putLe32(out, entries[e].timestamp);
+            out = detail::putLe32(out, entries[e].location);
+            out = detail::putLe32(out, static_cast<uint32_t>(entries[e].code));
+        }
+        ++ringCount;
+    }
+
+    buffer[0] = 'E';
+    buffer[1] = 'T';
+    buffer[2] = 'R';
+    buffer[3] = '1';
+    detail::putLe16(buffer + 4, ringCount);
+    detail::putLe16(buffer + 6, static_cast<uint16_t>(kErrorTraceDumpEntrySize));
+    return static_cast<size_t>(out - buffer);
+}
+
+} // namespace common
@@ -4,19 +4,68 @@
  *
  * Include this file to get all common utilities:
  * - ErrorCodes: Unified error codes
+ * - ErrorDomain: Library-specific error enums in the 500+ range
  * - Result: Type-safe result type for error handling
+ * - ResultAlgorithms: collect(), all() and partition() over many Results
  * - Common macros and utilities
  */
 
 #pragma once
 
 #include "ErrorCodes.h"
+#include "ErrorDomain.h"
 #include "Result.h"
+#include "ResultAlgorithms.h"
+
+/**
+ * @def LIBCOMMON_CONCAT(x, y)
+ * @brief Paste two tokens after macro-expanding both (e.g. __LINE__)
+ */
+#define LIBCOMMON_CONCAT_INNER(x, y) x##y
+#define LIBCOMMON_CONCAT(x, y) LIBCOMMON_CONCAT_INNER(x, y)
+
+/**
+ * @def LIBCOMMON_TRACE_HOP(code)
+ * @brief Record a propagation hop at this line (see ErrorTrace.h)
+ *
+ * Expands to nothing unless LIBCOMMON_ERROR_TRACE is 1. The location tag
+ * is a compile-time constant. With LIBCOMMON_SHARED_ERROR_PATH, every hop
+ * calls one out-of-line function instead of inlining the ring push.
+ */
+#if LIBCOMMON_ERROR_TRACE && LIBCOMMON_SHARED_ERROR_PATH
+#include "ErrorTrace.h"
+
+namespace common {
+namespace detail {
+
+/**
+ * @brief Out-of-line recordErrorHop() shared by all hops (LIBCOMMON_SHARED_ERROR_PATH)
+ */
+LIBCOMMON_COLD LIBCOMMON_NOINLINE inline void recordErrorHopShared(int32_t code, uint32_t location) noexcept {
+    recordErrorHop(code, location);
+}
+
+} // namespace detail
+} // namespace common
+
+#define LIBCOMMON_TRACE_HOP(code) \
+    ::common::detail::recordErrorHopShared(static_cast<int32_t>(code), \
+        std::integral_constant<uint32_t, ::common::detail::locationTag(__FILE__, __LINE__)>::value)
+#elif LIBCOMMON_ERROR_TRACE
+#include "ErrorTrace.h"
+#define LIBCOMMON_TRACE_HOP(code) \
+    ::common::recordErrorHop(static_cast<int32_t>(code), \
+        std::integral_constant<uint32_t, ::common::detail::locationTag(__FILE__, __LINE__)>::value)
+#else
+#define LIBCOMMON_TRACE_HOP(code) static_cast<void>(0)
+#endif
 
 /**
  * @def RETURN_IF_ERROR(expr)
  * @brief Early return if expression returns an error Result
  *
+ * The error branch is marked unlikely (see LIBCOMMON_BRANCH_HINTS).
+ *
  * Usage:
  * @code
  * Result<void> doSomething() {
@@ -29,15 +78,19 @@
 #define RETURN_IF_ERROR(expr) \
     do { \
         auto _result = (expr); \
-        if (!_result) { \
+        if (LIBCOMMON_UNLIKELY(!_result)) { \
+            LIBCOMMON_TRACE_HOP(_result.error()); \
             return _result; \
         } \
     } while (0)
 
 /**
- * @def RETURN_ERROR_IF(condition, error)
+ * @def RETURN_ERROR_IF(condition, errorCode)
  * @brief Return error if condition is true
  *
+ * The error is returned as a common::Failure, so the enclosing function
+ * may return any Result with a matching error type.
+ *
  * Usage:
  * @code
  * Result<void> validate(int x) {
@@ -46,10 +99,12 @@
  * }
  * @endcode
  */
-#define RETURN_ERROR_IF(condition, error) \
+#define RETURN_ERROR_IF(condition, errorCode) \
     do { \
-        if (condition) { \
-            return decltype(error)::error(error); \
+        if (LIBCOMMON_UNLIKELY(condition)) { \
+            auto _failure = ::common::makeFailure(errorCode); \
+            LIBCOMMON_TRACE_HOP(_failure.error); \
+            return ::common::detail::propagateFailure(_failure); \
         } \
     } while (0)
 
@@ -57,6 +112,10 @@
  * @def ASSIGN_OR_RETURN(var, expr)
  * @brief Assign value from Result or return error
  *
+ * Portable statement form of RESULT_TRY. The error is returned as a
+ * common::Failure, so the source and enclosing Result may have different
+ * value types. May be used once per line.
+ *
  * Usage:
  * @code
  * Result<int> calculate() {
@@ -66,11 +125,62 @@
  * @endcode
  */
 #define ASSIGN_OR_RETURN(var, expr) \
-    auto _temp_result_##__LINE__ = (expr); \
-    if (!_temp_result_##__LINE__) { \
-        return decltype(_temp_result_##__LINE__)::error(_temp_result_##__LINE__.error()); \
+    ASSIGN_OR_RETURN_IMPL(LIBCOMMON_CONCAT(_temp_result_, __LINE__), var, expr)
+
+#define ASSIGN_OR_RETURN_IMPL(tmp, var, expr) \
+    auto&& tmp = (expr); \
+    if (LIBCOMMON_UNLIKELY(!tmp)) { \
+        LIBCOMMON_TRACE_HOP(tmp.error()); \
+        return ::common::detail::propagateFailure(tmp.failure()); \
     } \
-    var = std::move(_temp_result_##__LINE__).value()
+    var = std::forward<decltype(tmp)>(tmp).value()
+
+/**
+ * @def LIBCOMMON_HAS_TRY_EXPR
+ * @brief 1 if RESULT_TRY is available (GCC/Clang statement expressions)
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBCOMMON_HAS_TRY_EXPR 1
+#else
+#define LIBCOMMON_HAS_TRY_EXPR 0
+#endif
+
+#if LIBCOMMON_HAS_TRY_EXPR
+/**
+ * @def RESULT_TRY(expr)
+ * @brief Evaluate to the value of a Result, or return its error
+ *
+ * An expression, so it can be used several times per statement and inside
+ * larger expressions. A temporary Result's value is moved out exactly once,
+ * as with hand-written code. Requires GNU statement expressions; elsewhere
+ * use ASSIGN_OR_RETURN.
+ *
+ * Reference Results (Result<T&>) are rejected at compile time: a statement
+ * expression yields a prvalue, so it would copy the referred object. Use
+ * ASSIGN_OR_RETURN(auto& var, expr) for them.
+ *
+ * Usage:
+ * @code
+ * Result<int> sum() {
+ *     return Result<int>::ok(RESULT_TRY(readA()) + RESULT_TRY(readB()));
+ * }
+ * @endcode
+ */
+#define RESULT_TRY(expr) \
+    RESULT_TRY_IMPL(LIBCOMMON_CONCAT(_try_result_, __COUNTER__), expr)
+
+#define RESULT_TRY_IMPL(tmp, expr) \
+    (__extension__({ \
+        auto&& tmp = (expr); \
+        static_assert(!std::is_reference_v<typename std::decay_t<decltype(tmp)>::ValueType>, \
+                      "RESULT_TRY would copy the referred object; use ASSIGN_OR_RETURN(auto& var, expr)"); \
+        if (LIBCOMMON_UNLIKELY(!tmp)) { \
+            LIBCOMMON_TRACE_HOP(tmp.error()); \
+            return ::common::detail::propagateFailure(tmp.failure()); \
+        } \
+        std::forward<decltype(tmp)>(tmp).value(); \
+    }))
+#endif
 
 namespace common {
 
@@ -196,9 +306,7 @@ protected:
  * }
  * @endcode
  */
-#define SCOPE_EXIT_CAT2(x, y) x##y
-#define SCOPE_EXIT_CAT(x, y) SCOPE_EXIT_CAT2(x, y)
 #define SCOPE_EXIT \
-    auto SCOPE_EXIT_CAT(_scope_guard_, __LINE__) = \
+    auto LIBCOMMON_CONCAT(_scope_guard_, __LINE__) = \
         ::common::makeScopeGuard([&]()
 #define SCOPE_EXIT_END )
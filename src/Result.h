@@ -8,314 +8,1751 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
 #include <utility>
 #include <type_traits>
+#if __has_include(<version>)
+#include <version>
+#endif
 #include "ErrorCodes.h"
+#include "ErrorLocation.h"
+#if LIBCOMMON_ERROR_STATS
+#include "ErrorStats.h"
+#endif
+
+/**
+ * @def LIBCOMMON_HAS_STD_EXPECTED
+ * @brief 1 when the standard library provides std::expected (C++23)
+ *
+ * Enables Result's conversions from and to std::expected.
+ */
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#define LIBCOMMON_HAS_STD_EXPECTED 1
+#else
+#define LIBCOMMON_HAS_STD_EXPECTED 0
+#endif
+
+/**
+ * @def LIBCOMMON_RESULT_STD_EXPECTED
+ * @brief Keep Result's value and error in a std::expected (default 0)
+ *
+ * For comparing code generation: Result<T, E> keeps its interface but
+ * becomes a thin wrapper around std::expected<T, E>, replacing the packed
+ * and discriminated-union layouts, and toExpected() && / construction
+ * from a std::expected move the whole object. Ignored without
+ * std::expected.
+ */
+#ifndef LIBCOMMON_RESULT_STD_EXPECTED
+#define LIBCOMMON_RESULT_STD_EXPECTED 0
+#endif
+
+#if LIBCOMMON_RESULT_STD_EXPECTED && LIBCOMMON_HAS_STD_EXPECTED
+#define LIBCOMMON_EXPECTED_STORAGE 1
+#else
+#define LIBCOMMON_EXPECTED_STORAGE 0
+#endif
+
+/**
+ * @def LIBCOMMON_BRANCH_HINTS
+ * @brief Treat errors as the unlikely path (default 1)
+ *
+ * isOk(), isError(), operator bool and the propagation macros in
+ * LibraryCommon.h tell the compiler that errors are rare, so the success
+ * path becomes fall-through code and error exits move to cold sections.
+ * Define as 0 to leave branch layout to the compiler.
+ */
+#ifndef LIBCOMMON_BRANCH_HINTS
+#define LIBCOMMON_BRANCH_HINTS 1
+#endif
+
+#if LIBCOMMON_BRANCH_HINTS && (defined(__GNUC__) || defined(__clang__))
+#define LIBCOMMON_LIKELY(x) __builtin_expect(static_cast<bool>(x), 1)
+#define LIBCOMMON_UNLIKELY(x) __builtin_expect(static_cast<bool>(x), 0)
+#define LIBCOMMON_COLD __attribute__((cold, noinline))
+#else
+#define LIBCOMMON_LIKELY(x) static_cast<bool>(x)
+#define LIBCOMMON_UNLIKELY(x) static_cast<bool>(x)
+#define LIBCOMMON_COLD
+#endif
+
+/**
+ * @def LIBCOMMON_SHARED_ERROR_PATH
+ * @brief Keep per-error bookkeeping out of line (default 0)
+ *
+ * With LIBCOMMON_ERROR_STATS or LIBCOMMON_ERROR_TRACE, the compiler may
+ * inline the counter update or trace push wherever an error is created or
+ * propagated. Defined as 1, those places call one shared non-template
+ * function that takes the error as an int32_t instead. GCC 12 already keeps
+ * the bookkeeping out of line on the cold error paths, so there it saves
+ * nothing (see test/codegen/check_code_size.py). No effect without
+ * statistics or tracing.
+ */
+#ifndef LIBCOMMON_SHARED_ERROR_PATH
+#define LIBCOMMON_SHARED_ERROR_PATH 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBCOMMON_NOINLINE __attribute__((noinline))
+#else
+#define LIBCOMMON_NOINLINE
+#endif
 
 namespace common {
 
-/**
- * @brief Tag type for constructing error results
- */
-struct ErrorTag {};
+/**
+ * @brief Tag type for constructing error results
+ */
+struct ErrorTag {};
+
+/**
+ * @brief Tag type for constructing success results
+ */
+struct SuccessTag {};
+
+/**
+ * @brief Tag type for constructing a success value in place
+ */
+struct InPlaceTag {};
+
+/**
+ * @brief Inline constexpr tags for Result construction
+ */
+inline constexpr ErrorTag err_tag{};
+inline constexpr SuccessTag ok_tag{};
+inline constexpr InPlaceTag in_place{};
+
+/**
+ * @brief Properties of an error type used by Result
+ *
+ * Specialize with zeroIsSuccess = true for error enums where the value 0 is
+ * reserved for "no error". Result then uses the error field itself as the
+ * discriminant, which lets Result<void, E> and Results with small trivially
+ * copyable values pack into a single register. Such a specialization may
+ * also define unknownError, the code an error Result holds when it is
+ * created from 0 (which would otherwise read as success); without it all
+ * bits are set.
+ *
+ * @tparam E The error type
+ */
+template<typename E>
+struct ErrorTraits {
+    static constexpr bool zeroIsSuccess = false;
+};
+
+/**
+ * @brief ErrorCode reserves 0 (OK) for success
+ */
+template<>
+struct ErrorTraits<ErrorCode> {
+    static constexpr bool zeroIsSuccess = true;
+    static constexpr ErrorCode unknownError = ErrorCode::UNKNOWN_ERROR;
+};
+
+namespace detail {
+
+template<typename E, typename = void>
+struct HasUnknownError : std::false_type {};
+
+template<typename E>
+struct HasUnknownError<E, std::void_t<decltype(ErrorTraits<E>::unknownError)>> : std::true_type {};
+
+/**
+ * @brief The error to store for error: 0 becomes unknownError when E
+ *        reserves 0 for success, so an error Result never reads as success
+ */
+template<typename E>
+constexpr E storableError(E error) noexcept {
+    if constexpr (ErrorTraits<E>::zeroIsSuccess) {
+        if (LIBCOMMON_UNLIKELY(error == static_cast<E>(0))) {
+            if constexpr (HasUnknownError<E>::value) {
+                return ErrorTraits<E>::unknownError;
+            } else if constexpr (std::is_enum_v<E>) {
+                using Bits = std::make_unsigned_t<std::underlying_type_t<E>>;
+                return static_cast<E>(static_cast<Bits>(~Bits{0}));
+            } else {
+                return static_cast<E>(~E{0});
+            }
+        }
+    }
+    return error;
+}
+
+/**
+ * @brief Non-constexpr no-op called on the run-time error path
+ */
+inline void runtimeErrorPath() noexcept {}
+
+/**
+ * @brief Keep a run-time error Result from being folded into a constant
+ *
+ * Called by the error constructors of the layouts holding a T. Without it GCC
+ * evaluates an error constructor with a constant code as a constant
+ * initializer, which zero-fills the whole object and makes the error
+ * return cost a memset of sizeof(T). The non-constexpr call outside
+ * constant evaluation stops that folding and inlines to nothing.
+ */
+constexpr void preventErrorFolding() noexcept {
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9)
+    if (!__builtin_is_constant_evaluated()) {
+        runtimeErrorPath();
+    }
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief An error not yet bound to a value type
+ *
+ * Converts implicitly to any Result<T, E>, which lets error propagation
+ * (RETURN_IF_ERROR, ASSIGN_OR_RETURN, RESULT_TRY) return an error from a
+ * Result<U, E> in a function returning Result<T, E>.
+ *
+ * @tparam E The error type
+ */
+template<typename E>
+struct Failure {
+    E error;
+#if LIBCOMMON_ERROR_LOCATION
+    ErrorLocation location;
+#endif
+};
+
+namespace detail {
+
+#if LIBCOMMON_ERROR_STATS && LIBCOMMON_SHARED_ERROR_PATH
+/**
+ * @brief Out-of-line error counter shared by all Results (LIBCOMMON_SHARED_ERROR_PATH)
+ */
+LIBCOMMON_COLD LIBCOMMON_NOINLINE inline void countErrorShared(int32_t code) noexcept {
+    errorStats().record(static_cast<ErrorCode>(code));
+}
+#endif
+
+/**
+ * @brief Count a newly created error (no-op unless LIBCOMMON_ERROR_STATS)
+ *
+ * Only ErrorCode errors are counted, and never during constant evaluation
+ * (compilers without __builtin_is_constant_evaluated, such as GCC 8, cannot
+ * create error Results in constant expressions while stats are enabled).
+ */
+template<typename E>
+constexpr void countError([[maybe_unused]] E error) noexcept {
+#if LIBCOMMON_ERROR_STATS
+    if constexpr (std::is_same_v<E, ErrorCode>) {
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9)
+        if (__builtin_is_constant_evaluated()) {
+            return;
+        }
+#endif
+#if LIBCOMMON_SHARED_ERROR_PATH
+        countErrorShared(static_cast<int32_t>(storableError(error)));
+#else
+        errorStats().record(storableError(error));
+#endif
+    }
+#endif
+}
+
+/**
+ * @brief Build a Failure for an error that already exists (not counted)
+ */
+template<typename E>
+constexpr Failure<E> failureOf(E error, [[maybe_unused]] ErrorLocation location) noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+    return Failure<E>{storableError(error), location};
+#else
+    return Failure<E>{storableError(error)};
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Create a Failure carrying error
+ * @param error The error code
+ * @param location Where the error was created (defaults to the caller)
+ * @return Failure convertible to any Result with error type E
+ */
+template<typename E>
+constexpr Failure<E> makeFailure(E error, ErrorLocation location = ErrorLocation::current()) noexcept {
+    detail::countError(error);
+    return detail::failureOf(error, location);
+}
+
+namespace detail {
+
+/**
+ * @brief Out-of-line error exit of the propagation macros
+ *
+ * Marked cold, so every path that reaches it is predicted not taken and
+ * its code is placed away from the success path.
+ */
+template<typename E>
+LIBCOMMON_COLD constexpr Failure<E> propagateFailure(Failure<E> failure) noexcept {
+    return failure;
+}
+
+/**
+ * @brief Location recorded in a Failure (unknown if recording is disabled)
+ */
+template<typename E>
+constexpr ErrorLocation failureLocation([[maybe_unused]] const Failure<E>& failure) noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+    return failure.location;
+#else
+    return ErrorLocation();
+#endif
+}
+
+} // namespace detail
+
+namespace detail {
+
+/**
+ * @brief Placeholder union member that is active when no value is held
+ */
+struct Empty {};
+
+/**
+ * @brief Largest packed Result that still fits in a return register pair
+ *        on 32-bit targets and in a single register on 64-bit targets
+ */
+inline constexpr size_t kPackedResultMaxSize = 8;
+
+/**
+ * @brief Build a T from args as a prvalue
+ *
+ * Uses T(args...) when that is valid and falls back to T{args...} for
+ * aggregates. Because the result is a prvalue, initializing a member from
+ * it constructs the T directly in place with no intermediate object.
+ */
+template<typename T, typename... Args>
+constexpr T makeValue(Args&&... args) {
+    if constexpr (std::is_constructible_v<T, Args...>) {
+        return T(std::forward<Args>(args)...);
+    } else {
+        return T{std::forward<Args>(args)...};
+    }
+}
+
+/**
+ * @brief Discriminated-union layout backing Result<T, E>
+ *
+ * The value lives in an anonymous union so an error result never constructs
+ * a T: creating an error costs a store of the error code and the flag,
+ * independent of sizeof(T). This also allows T without a default
+ * constructor. The destructor is trivial whenever T's is.
+ */
+template<typename T, typename E, bool = std::is_trivially_destructible_v<T>>
+class ResultStorageBase {
+public:
+    template<typename... Args>
+    explicit constexpr ResultStorageBase(SuccessTag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : value_(makeValue<T>(std::forward<Args>(args)...)), error_(static_cast<E>(0)), hasValue_(true) {}
+
+    constexpr ResultStorageBase(ErrorTag, E error) noexcept
+        : empty_(), error_(storableError(error)), hasValue_(false) {
+        preventErrorFolding();
+    }
+
+    constexpr bool hasValue() const noexcept { return hasValue_; }
+
+    union {
+        Empty empty_;
+        T value_;
+    };
+    E error_;
+    bool hasValue_;
+};
+
+template<typename T, typename E>
+class ResultStorageBase<T, E, false> {
+public:
+    template<typename... Args>
+    explicit constexpr ResultStorageBase(SuccessTag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : value_(makeValue<T>(std::forward<Args>(args)...)), error_(static_cast<E>(0)), hasValue_(true) {}
+
+    constexpr ResultStorageBase(ErrorTag, E error) noexcept
+        : empty_(), error_(storableError(error)), hasValue_(false) {
+        preventErrorFolding();
+    }
+
+    ResultStorageBase(const ResultStorageBase&) = default;
+    ResultStorageBase(ResultStorageBase&&) = default;
+    ResultStorageBase& operator=(const ResultStorageBase&) = default;
+    ResultStorageBase& operator=(ResultStorageBase&&) = default;
+
+    ~ResultStorageBase() {
+        if (hasValue_) {
+            value_.~T();
+        }
+    }
+
+    constexpr bool hasValue() const noexcept { return hasValue_; }
+
+    union {
+        Empty empty_;
+        T value_;
+    };
+    E error_;
+    bool hasValue_;
+};
+
+/**
+ * @brief Copy and move operations of CopyingResultStorage
+ *
+ * Copy and move only ever touch the active member. The error field is
+ * copied as is: a success source holds 0, which the error constructor
+ * would turn into unknownError. These are declared for every T; the
+ * SpecialMemberGate bases of CopyingResultStorage delete the ones T lacks.
+ */
+template<typename T, typename E>
+class CopyingResultStorageOps : public ResultStorageBase<T, E> {
+    using Base = ResultStorageBase<T, E>;
+
+public:
+    using Base::Base;
+
+    CopyingResultStorageOps(const CopyingResultStorageOps& other) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : Base(err_tag, other.error_) {
+        this->error_ = other.error_;
+        if (other.hasValue_) {
+            construct(other.value_);
+        }
+    }
+
+    CopyingResultStorageOps(CopyingResultStorageOps&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : Base(err_tag, other.error_) {
+        this->error_ = other.error_;
+        if (other.hasValue_) {
+            construct(std::move(other.value_));
+        }
+    }
+
+    CopyingResultStorageOps& operator=(const CopyingResultStorageOps& other)
+        noexcept(std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_copy_assignable_v<T>) {
+        if (this->hasValue_ && other.hasValue_) {
+            this->value_ = other.value_;
+        } else if (other.hasValue_) {
+            construct(other.value_);
+        } else {
+            destroy();
+        }
+        this->error_ = other.error_;
+        return *this;
+    }
+
+    CopyingResultStorageOps& operator=(CopyingResultStorageOps&& other)
+        noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+        if (this->hasValue_ && other.hasValue_) {
+            this->value_ = std::move(other.value_);
+        } else if (other.hasValue_) {
+            construct(std::move(other.value_));
+        } else {
+            destroy();
+        }
+        this->error_ = other.error_;
+        return *this;
+    }
+
+    ~CopyingResultStorageOps() = default;
+
+protected:
+    template<typename... Args>
+    void construct(Args&&... args) {
+        ::new (static_cast<void*>(std::addressof(this->value_))) T(std::forward<Args>(args)...);
+        this->hasValue_ = true;
+    }
+
+    void destroy() noexcept {
+        if (this->hasValue_) {
+            this->value_.~T();
+            this->hasValue_ = false;
+        }
+    }
+};
+
+/**
+ * @brief Empty base that deletes one special member when Enabled is false
+ *
+ * Kind selects the member: 0 copy constructor, 1 move constructor,
+ * 2 copy assignment, 3 move assignment. The others stay defaulted, so a
+ * class deriving from the gates and defaulting its own special members
+ * has exactly the operations its payload supports.
+ */
+template<int Kind, bool Enabled>
+struct SpecialMemberGate {};
+
+template<>
+struct SpecialMemberGate<0, false> {
+    SpecialMemberGate() = default;
+    SpecialMemberGate(const SpecialMemberGate&) = delete;
+    SpecialMemberGate(SpecialMemberGate&&) = default;
+    SpecialMemberGate& operator=(const SpecialMemberGate&) = default;
+    SpecialMemberGate& operator=(SpecialMemberGate&&) = default;
+};
+
+template<>
+struct SpecialMemberGate<1, false> {
+    SpecialMemberGate() = default;
+    SpecialMemberGate(const SpecialMemberGate&) = default;
+    SpecialMemberGate(SpecialMemberGate&&) = delete;
+    SpecialMemberGate& operator=(const SpecialMemberGate&) = default;
+    SpecialMemberGate& operator=(SpecialMemberGate&&) = default;
+};
+
+template<>
+struct SpecialMemberGate<2, false> {
+    SpecialMemberGate() = default;
+    SpecialMemberGate(const SpecialMemberGate&) = default;
+    SpecialMemberGate(SpecialMemberGate&&) = default;
+    SpecialMemberGate& operator=(const SpecialMemberGate&) = delete;
+    SpecialMemberGate& operator=(SpecialMemberGate&&) = default;
+};
+
+template<>
+struct SpecialMemberGate<3, false> {
+    SpecialMemberGate() = default;
+    SpecialMemberGate(const SpecialMemberGate&) = default;
+    SpecialMemberGate(SpecialMemberGate&&) = default;
+    SpecialMemberGate& operator=(const SpecialMemberGate&) = default;
+    SpecialMemberGate& operator=(SpecialMemberGate&&) = delete;
+};
+
+/**
+ * @brief Storage for Result<T, E> with non-trivial copy or move
+ *
+ * Copyable and movable exactly when T is (E is always trivially
+ * copyable), so Result<std::unique_ptr<U>> is move-only.
+ */
+template<typename T, typename E>
+class CopyingResultStorage
+    : public CopyingResultStorageOps<T, E>,
+      SpecialMemberGate<0, std::is_copy_constructible_v<T>>,
+      SpecialMemberGate<1, std::is_move_constructible_v<T>>,
+      SpecialMemberGate<2, std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>>,
+      SpecialMemberGate<3, std::is_move_constructible_v<T> && std::is_move_assignable_v<T>> {
+public:
+    using CopyingResultStorageOps<T, E>::CopyingResultStorageOps;
+};
+
+/**
+ * @brief Unpacked storage for Result<T, E>
+ *
+ * When T and E are trivially copyable the layout class is used directly,
+ * so every copy and move is the implicit trivial one and the Result is
+ * returned in registers where the ABI allows. It is deliberately not
+ * wrapped in a derived class: GCC cannot scalarize copies of a base
+ * subobject and spills them through the stack.
+ */
+template<typename T, typename E>
+using ResultStorage = std::conditional_t<
+    std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E>,
+    ResultStorageBase<T, E>,
+    CopyingResultStorage<T, E>>;
+
+/**
+ * @brief Packed storage for small trivially copyable values
+ *
+ * Used when E reserves 0 for success: the error field doubles as the
+ * discriminant, so a Result<uint16_t> is a single 32-bit word holding the
+ * value and the code. All special members are trivial.
+ */
+template<typename T, typename E>
+class PackedResultStorage {
+public:
+    template<typename... Args>
+    explicit constexpr PackedResultStorage(SuccessTag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : value_(makeValue<T>(std::forward<Args>(args)...)), error_(static_cast<E>(0)) {}
+
+    constexpr PackedResultStorage(ErrorTag, E error) noexcept
+        : empty_(), error_(storableError(error)) {}
+
+    constexpr bool hasValue() const noexcept { return error_ == static_cast<E>(0); }
+
+    union {
+        Empty empty_;
+        T value_;
+    };
+    E error_;
+};
+
+/**
+ * @brief Whether Result<T, E> can use PackedResultStorage
+ */
+template<typename T, typename E>
+inline constexpr bool kIsPackable =
+    ErrorTraits<E>::zeroIsSuccess &&
+    std::is_trivially_copyable_v<T> &&
+    std::is_trivially_destructible_v<T> &&
+    sizeof(PackedResultStorage<T, E>) <= kPackedResultMaxSize;
+
+#if LIBCOMMON_EXPECTED_STORAGE
+/**
+ * @brief std::expected-backed storage (LIBCOMMON_RESULT_STD_EXPECTED)
+ *
+ * Success results hold no error; storedError() reports 0 for them, as the
+ * other layouts do.
+ */
+template<typename T, typename E>
+class ExpectedResultStorage {
+public:
+    template<typename... Args>
+    explicit constexpr ExpectedResultStorage(SuccessTag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : expected_(std::in_place, std::forward<Args>(args)...) {}
+
+    constexpr ExpectedResultStorage(ErrorTag, E error) noexcept : expected_(std::unexpect, storableError(error)) {
+        preventErrorFolding();
+    }
+
+    explicit constexpr ExpectedResultStorage(std::expected<T, E>&& expected)
+        noexcept(std::is_nothrow_move_constructible_v<std::expected<T, E>>)
+        : expected_(std::move(expected)) {}
+
+    constexpr bool hasValue() const noexcept { return expected_.has_value(); }
+
+    std::expected<T, E> expected_;
+};
+
+template<typename E>
+class ExpectedResultStorage<void, E> {
+public:
+    explicit constexpr ExpectedResultStorage(SuccessTag) noexcept : expected_() {}
+    constexpr ExpectedResultStorage(ErrorTag, E error) noexcept : expected_(std::unexpect, storableError(error)) {
+        preventErrorFolding();
+    }
+    explicit constexpr ExpectedResultStorage(std::expected<void, E>&& expected) noexcept
+        : expected_(std::move(expected)) {}
+
+    constexpr bool hasValue() const noexcept { return expected_.has_value(); }
+
+    std::expected<void, E> expected_;
+};
+
+template<typename T, typename E>
+constexpr T& storedValue(ExpectedResultStorage<T, E>& storage) noexcept {
+    return *storage.expected_;
+}
+
+template<typename T, typename E>
+constexpr const T& storedValue(const ExpectedResultStorage<T, E>& storage) noexcept {
+    return *storage.expected_;
+}
+
+template<typename T, typename E>
+constexpr E storedError(const ExpectedResultStorage<T, E>& storage) noexcept {
+    return storage.expected_.has_value() ? static_cast<E>(0) : storage.expected_.error();
+}
+#endif
+
+/**
+ * @brief The value held by a Result's storage
+ */
+template<typename Storage>
+constexpr auto& storedValue(Storage& storage) noexcept {
+    return storage.value_;
+}
+
+/**
+ * @brief The error held by a Result's storage
+ */
+template<typename Storage>
+constexpr auto storedError(const Storage& storage) noexcept {
+    return storage.error_;
+}
+
+/**
+ * @brief Storage selected for Result<T, E>
+ */
+#if LIBCOMMON_EXPECTED_STORAGE
+template<typename T, typename E>
+using ResultStorageFor = ExpectedResultStorage<T, E>;
+#else
+template<typename T, typename E>
+using ResultStorageFor = std::conditional_t<kIsPackable<T, E>,
+                                            PackedResultStorage<T, E>,
+                                            ResultStorage<T, E>>;
+#endif
+
+/**
+ * @brief Storage for Result<void, E>
+ *
+ * When E reserves 0 for success the Result is just the error code.
+ */
+template<typename E, bool Packed = ErrorTraits<E>::zeroIsSuccess>
+class VoidResultStorage {
+public:
+    explicit constexpr VoidResultStorage(SuccessTag) noexcept : error_(static_cast<E>(0)) {}
+    constexpr VoidResultStorage(ErrorTag, E error) noexcept : error_(storableError(error)) {}
+
+    constexpr bool hasValue() const noexcept { return error_ == static_cast<E>(0); }
+
+    E error_;
+};
+
+template<typename E>
+class VoidResultStorage<E, false> {
+public:
+    explicit constexpr VoidResultStorage(SuccessTag) noexcept
+        : error_(static_cast<E>(0)), hasValue_(true) {}
+    constexpr VoidResultStorage(ErrorTag, E error) noexcept
+        : error_(storableError(error)), hasValue_(false) {}
+
+    constexpr bool hasValue() const noexcept { return hasValue_; }
+
+    E error_;
+    bool hasValue_;
+};
+
+/**
+ * @brief Storage selected for Result<void, E>
+ */
+#if LIBCOMMON_EXPECTED_STORAGE
+template<typename E>
+using VoidResultStorageFor = ExpectedResultStorage<void, E>;
+#else
+template<typename E>
+using VoidResultStorageFor = VoidResultStorage<E>;
+#endif
+
+/**
+ * @brief Type produced by invoking F with Args, without cv/ref qualifiers
+ */
+template<typename F, typename... Args>
+using InvokeResult = std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<F, Args...>>>;
+
+/**
+ * @brief Wrap the result of invoking f in ResultType, handling void
+ */
+template<typename ResultType, typename F, typename... Args>
+constexpr ResultType invokeToResult(F&& f, Args&&... args) {
+    if constexpr (std::is_void_v<typename ResultType::ValueType>) {
+        std::forward<F>(f)(std::forward<Args>(args)...);
+        return ResultType::ok();
+    } else {
+        return ResultType::ok(std::forward<F>(f)(std::forward<Args>(args)...));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @class Result
+ * @brief A type-safe result type that holds either a value or an error
+ *
+ * @tparam T The success value type (use void for operations with no return value)
+ * @tparam E The error type (defaults to common::ErrorCode)
+ *
+ * Usage:
+ * @code
+ * Result<int> divide(int a, int b) {
+ *     if (b == 0) {
+ *         return Result<int>::error(ErrorCode::INVALID_PARAMETER);
+ *     }
+ *     return Result<int>::ok(a / b);
+ * }
+ *
+ * auto result = divide(10, 2);
+ * if (result) {
+ *     printf("Result: %d\n", result.value());
+ * } else {
+ *     printf("Error: %s\n", errorCodeToString(result.error()));
+ * }
+ * @endcode
+ */
+template<typename T, typename E = ErrorCode>
+class Result {
+    // A member rather than a base, for the same scalarization reason as
+    // detail::ResultStorage
+    using Storage = detail::ResultStorageFor<T, E>;
+
+public:
+    using ValueType = T;
+    using ErrorType = E;
+
+    /**
+     * @brief Construct a success result with a value
+     * @param value The success value
+     */
+    explicit constexpr Result(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage_(ok_tag, value) {}
+
+    /**
+     * @brief Construct a success result with a moved value
+     * @param value The success value (moved)
+     */
+    explicit constexpr Result(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : storage_(ok_tag, std::move(value)) {}
+
+    /**
+     * @brief Construct an error result
+     * @param error The error code
+     */
+    explicit constexpr Result(E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : storage_(err_tag, error) {
+        setLocation(location);
+        detail::countError(error);
+    }
+
+    /**
+     * @brief Construct a success result with tag
+     * @param value The success value
+     */
+    constexpr Result(SuccessTag, const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage_(ok_tag, value) {}
+
+    /**
+     * @brief Construct an error result with tag
+     * @param error The error code
+     */
+    constexpr Result(ErrorTag, E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : storage_(err_tag, error) {
+        setLocation(location);
+        detail::countError(error);
+    }
+
+    /**
+     * @brief Construct an error result from an untyped Failure
+     * @param failure The error to propagate
+     */
+    constexpr Result(Failure<E> failure) noexcept
+        : storage_(err_tag, failure.error) {
+        setLocation(detail::failureLocation(failure));
+    }
+
+    /**
+     * @brief Construct the success value in place from constructor arguments
+     * @param args Arguments forwarded to T's constructor (or aggregate
+     *             initializer)
+     */
+    template<typename... Args>
+    explicit constexpr Result(InPlaceTag, Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : storage_(ok_tag, std::forward<Args>(args)...) {}
+
+    /**
+     * @brief Take the value of an optional, or ifEmpty if it has none
+     * @param value The optional (moved from)
+     * @param ifEmpty Error to hold when value is empty
+     * @param location Where the error was created (defaults to the caller)
+     */
+    constexpr Result(std::optional<T>&& value, E ifEmpty, ErrorLocation location = ErrorLocation::current())
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+        : storage_(value ? Storage(ok_tag, std::move(*value)) : Storage(err_tag, ifEmpty)) {
+        if (LIBCOMMON_UNLIKELY(!value)) {
+            setLocation(location);
+            detail::countError(ifEmpty);
+        }
+    }
+
+    /**
+     * @brief Copy the value of an optional, or ifEmpty if it has none
+     */
+    constexpr Result(const std::optional<T>& value, E ifEmpty, ErrorLocation location = ErrorLocation::current())
+        noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage_(value ? Storage(ok_tag, *value) : Storage(err_tag, ifEmpty)) {
+        if (LIBCOMMON_UNLIKELY(!value)) {
+            setLocation(location);
+            detail::countError(ifEmpty);
+        }
+    }
+
+#if LIBCOMMON_HAS_STD_EXPECTED
+    /**
+     * @brief Convert from std::expected, moving the value or error over
+     *
+     * The error already exists, so it is not counted again; its location
+     * is the conversion.
+     */
+    constexpr Result(std::expected<T, E>&& other, ErrorLocation location = ErrorLocation::current())
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+#if LIBCOMMON_EXPECTED_STORAGE
+        : storage_(std::move(other)) {
+#else
+        : storage_(other ? Storage(ok_tag, std::move(*other)) : Storage(err_tag, other.error())) {
+#endif
+        if (LIBCOMMON_UNLIKELY(!storage_.hasValue())) {
+            setLocation(location);
+        }
+    }
+
+    /**
+     * @brief Convert from std::expected, copying the value
+     */
+    constexpr Result(const std::expected<T, E>& other, ErrorLocation location = ErrorLocation::current())
+        noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage_(other ? Storage(ok_tag, *other) : Storage(err_tag, other.error())) {
+        if (LIBCOMMON_UNLIKELY(!other)) {
+            setLocation(location);
+        }
+    }
+#endif
+
+    /**
+     * @brief Create a success result
+     * @param value The success value
+     * @return Result containing the value
+     */
+    static constexpr Result ok(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return Result(value);
+    }
+
+    /**
+     * @brief Create a success result with moved value
+     * @param value The success value (moved)
+     * @return Result containing the value
+     */
+    static constexpr Result ok(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return Result(std::move(value));
+    }
+
+    /**
+     * @brief Create a success result, constructing the value in place
+     *
+     * Unlike ok(T{...}) no temporary T is created and moved: the value is
+     * built directly in the Result, and the Result itself is elided into
+     * the caller's storage when returned.
+     *
+     * @param args Arguments forwarded to T's constructor (or aggregate
+     *             initializer)
+     * @return Result containing the value
+     */
+    template<typename... Args>
+    static constexpr Result emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+        return Result(in_place, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Create an error result
+     * @param error The error code
+     * @param location Where the error was created (defaults to the caller)
+     * @return Result containing the error
+     */
+    static constexpr Result error(E error, ErrorLocation location = ErrorLocation::current()) noexcept {
+        return Result(error, location);
+    }
+
+    /**
+     * @brief Check if result contains a value (success)
+     * @return true if result is successful
+     */
+    constexpr bool isOk() const noexcept { return LIBCOMMON_LIKELY(storage_.hasValue()); }
+
+    /**
+     * @brief Check if result contains an error
+     * @return true if result is an error
+     */
+    constexpr bool isError() const noexcept { return !isOk(); }
+
+    /**
+     * @brief Boolean conversion - true if successful
+     */
+    explicit constexpr operator bool() const noexcept { return isOk(); }
+
+    /**
+     * @brief Get the success value
+     * @return Reference to the value
+     * @warning Undefined behavior if result is an error
+     */
+    constexpr T& value() & noexcept { return detail::storedValue(storage_); }
+
+    /**
+     * @brief Get the success value (const)
+     * @return Const reference to the value
+     * @warning Undefined behavior if result is an error
+     */
+    constexpr const T& value() const& noexcept { return detail::storedValue(storage_); }
+
+    /**
+     * @brief Get the success value (rvalue)
+     * @return Rvalue reference to the value
+     * @warning Undefined behavior if result is an error
+     */
+    constexpr T&& value() && noexcept { return std::move(detail::storedValue(storage_)); }
+
+    /**
+     * @brief Get the error code
+     * @return The error code
+     * @warning Undefined behavior if result is successful
+     */
+    constexpr E error() const noexcept { return detail::storedError(storage_); }
+
+    /**
+     * @brief Get where the error was created
+     * @return The location, unknown unless LIBCOMMON_ERROR_LOCATION is set
+     */
+    constexpr ErrorLocation location() const noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        return location_;
+#else
+        return ErrorLocation();
+#endif
+    }
+
+    /**
+     * @brief Get the error and its location for propagation
+     * @return Failure convertible to any Result with error type E
+     * @warning Undefined behavior if result is successful
+     */
+    constexpr Failure<E> failure() const noexcept {
+        return detail::failureOf(error(), location());
+    }
+
+    /**
+     * @brief Get value or default if error
+     * @param defaultValue Value to return if result is an error
+     * @return The value if successful, defaultValue otherwise
+     */
+    constexpr T valueOr(const T& defaultValue) const& noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return storage_.hasValue() ? detail::storedValue(storage_) : defaultValue;
+    }
+
+    /**
+     * @brief Get value or default if error (move version)
+     * @param defaultValue Value to return if result is an error
+     * @return The value if successful, defaultValue otherwise
+     */
+    constexpr T valueOr(T&& defaultValue) && noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return storage_.hasValue() ? std::move(detail::storedValue(storage_)) : std::move(defaultValue);
+    }
+
+    /**
+     * @brief Copy the value into a std::optional, empty on error
+     */
+    constexpr std::optional<T> toOptional() const& noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        if (storage_.hasValue()) {
+            return std::optional<T>(std::in_place, detail::storedValue(storage_));
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Move the value into a std::optional, empty on error
+     */
+    constexpr std::optional<T> toOptional() && noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (storage_.hasValue()) {
+            return std::optional<T>(std::in_place, std::move(detail::storedValue(storage_)));
+        }
+        return std::nullopt;
+    }
+
+#if LIBCOMMON_HAS_STD_EXPECTED
+    /**
+     * @brief Copy into a std::expected (the error location is dropped)
+     */
+    constexpr std::expected<T, E> toExpected() const& noexcept(std::is_nothrow_copy_constructible_v<T>) {
+#if LIBCOMMON_EXPECTED_STORAGE
+        return storage_.expected_;
+#else
+        if (storage_.hasValue()) {
+            return std::expected<T, E>(std::in_place, detail::storedValue(storage_));
+        }
+        return std::expected<T, E>(std::unexpect, detail::storedError(storage_));
+#endif
+    }
+
+    /**
+     * @brief Move into a std::expected (the error location is dropped)
+     */
+    constexpr std::expected<T, E> toExpected() && noexcept(std::is_nothrow_move_constructible_v<T>) {
+#if LIBCOMMON_EXPECTED_STORAGE
+        return std::move(storage_.expected_);
+#else
+        if (storage_.hasValue()) {
+            return std::expected<T, E>(std::in_place, std::move(detail::storedValue(storage_)));
+        }
+        return std::expected<T, E>(std::unexpect, detail::storedError(storage_));
+#endif
+    }
+#endif
+
+    /**
+     * @brief Map the value if successful
+     * @tparam F Function type taking const T&
+     * @param f Function to apply to value
+     * @return Result with mapped value or original error
+     */
+    template<typename F>
+    constexpr auto map(F&& f) const& {
+        using ResultType = Result<detail::InvokeResult<F, const T&>, E>;
+        if (storage_.hasValue()) {
+            return detail::invokeToResult<ResultType>(std::forward<F>(f), detail::storedValue(storage_));
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Map the value if successful, moving it into the function
+     * @tparam F Function type taking T&&
+     * @param f Function to apply to value
+     * @return Result with mapped value or original error
+     */
+    template<typename F>
+    constexpr auto map(F&& f) && {
+        using ResultType = Result<detail::InvokeResult<F, T&&>, E>;
+        if (storage_.hasValue()) {
+            return detail::invokeToResult<ResultType>(std::forward<F>(f), std::move(detail::storedValue(storage_)));
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Alias for map(), matching the std::expected vocabulary
+     */
+    template<typename F>
+    constexpr auto transform(F&& f) const& {
+        return map(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Alias for map() &&, matching the std::expected vocabulary
+     */
+    template<typename F>
+    constexpr auto transform(F&& f) && {
+        return std::move(*this).map(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Apply function if successful, return error otherwise
+     * @tparam F Function type taking const T& and returning Result<U, E>
+     * @param f Function to apply
+     * @return Result from function or original error
+     */
+    template<typename F>
+    constexpr auto andThen(F&& f) const& {
+        using ResultType = detail::InvokeResult<F, const T&>;
+        if (storage_.hasValue()) {
+            return std::forward<F>(f)(detail::storedValue(storage_));
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Apply function if successful, moving the value into it
+     * @tparam F Function type taking T&& and returning Result<U, E>
+     * @param f Function to apply
+     * @return Result from function or original error
+     */
+    template<typename F>
+    constexpr auto andThen(F&& f) && {
+        using ResultType = detail::InvokeResult<F, T&&>;
+        if (storage_.hasValue()) {
+            return std::forward<F>(f)(std::move(detail::storedValue(storage_)));
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Map the error if unsuccessful
+     * @tparam F Function type taking E and returning the new error type
+     * @param f Function to apply to the error
+     * @return Result with the original value or mapped error
+     */
+    template<typename F>
+    constexpr auto mapError(F&& f) const& {
+        using ResultType = Result<T, detail::InvokeResult<F, E>>;
+        if (storage_.hasValue()) {
+            return ResultType::ok(detail::storedValue(storage_));
+        }
+        return ResultType(detail::failureOf(std::forward<F>(f)(detail::storedError(storage_)), location()));
+    }
 
-/**
- * @brief Tag type for constructing success results
- */
-struct SuccessTag {};
+    /**
+     * @brief Map the error if unsuccessful, moving the value through
+     * @tparam F Function type taking E and returning the new error type
+     * @param f Function to apply to the error
+     * @return Result with the original value or mapped error
+     */
+    template<typename F>
+    constexpr auto mapError(F&& f) && {
+        using ResultType = Result<T, detail::InvokeResult<F, E>>;
+        if (storage_.hasValue()) {
+            return ResultType::ok(std::move(detail::storedValue(storage_)));
+        }
+        return ResultType(detail::failureOf(std::forward<F>(f)(detail::storedError(storage_)), location()));
+    }
 
-/**
- * @brief Inline constexpr tags for Result construction
- */
-inline constexpr ErrorTag err_tag{};
-inline constexpr SuccessTag ok_tag{};
+    /**
+     * @brief Recover from an error
+     * @tparam F Function type taking E and returning Result<T, G>
+     * @param f Function to apply to the error
+     * @return The original value, or the Result returned by f
+     */
+    template<typename F>
+    constexpr auto orElse(F&& f) const& {
+        using ResultType = detail::InvokeResult<F, E>;
+        if (storage_.hasValue()) {
+            return ResultType::ok(detail::storedValue(storage_));
+        }
+        return std::forward<F>(f)(detail::storedError(storage_));
+    }
+
+    /**
+     * @brief Recover from an error, moving the value through on success
+     * @tparam F Function type taking E and returning Result<T, G>
+     * @param f Function to apply to the error
+     * @return The original value, or the Result returned by f
+     */
+    template<typename F>
+    constexpr auto orElse(F&& f) && {
+        using ResultType = detail::InvokeResult<F, E>;
+        if (storage_.hasValue()) {
+            return ResultType::ok(std::move(detail::storedValue(storage_)));
+        }
+        return std::forward<F>(f)(detail::storedError(storage_));
+    }
+
+private:
+    constexpr void setLocation([[maybe_unused]] ErrorLocation location) noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        location_ = location;
+#endif
+    }
+
+    Storage storage_;
+#if LIBCOMMON_ERROR_LOCATION
+    ErrorLocation location_{};
+#endif
+};
 
 /**
- * @class Result
- * @brief A type-safe result type that holds either a value or an error
- *
- * @tparam T The success value type (use void for operations with no return value)
- * @tparam E The error type (defaults to common::ErrorCode)
- *
- * Usage:
- * @code
- * Result<int> divide(int a, int b) {
- *     if (b == 0) {
- *         return Result<int>::error(ErrorCode::INVALID_PARAMETER);
- *     }
- *     return Result<int>::ok(a / b);
- * }
- *
- * auto result = divide(10, 2);
- * if (result) {
- *     printf("Result: %d\n", result.value());
- * } else {
- *     printf("Error: %s\n", errorCodeToString(result.error()));
- * }
- * @endcode
+ * @brief Specialization of Result for void (operations with no return value)
  */
-template<typename T, typename E = ErrorCode>
-class Result {
+template<typename E>
+class Result<void, E> {
+    using Storage = detail::VoidResultStorageFor<E>;
+
 public:
-    using ValueType = T;
+    using ValueType = void;
     using ErrorType = E;
 
     /**
-     * @brief Construct a success result with a value
-     * @param value The success value
-     */
-    explicit Result(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
-        : value_(value), error_(static_cast<E>(0)), hasValue_(true) {}
-
-    /**
-     * @brief Construct a success result with a moved value
-     * @param value The success value (moved)
+     * @brief Construct a success result
      */
-    explicit Result(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>)
-        : value_(std::move(value)), error_(static_cast<E>(0)), hasValue_(true) {}
+    constexpr Result() noexcept : storage_(ok_tag) {}
 
     /**
      * @brief Construct an error result
      * @param error The error code
      */
-    explicit Result(E error) noexcept
-        : value_(), error_(error), hasValue_(false) {}
+    explicit constexpr Result(E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : storage_(err_tag, error) {
+        setLocation(location);
+        detail::countError(error);
+    }
 
     /**
      * @brief Construct a success result with tag
-     * @param value The success value
      */
-    Result(SuccessTag, const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
-        : value_(value), error_(static_cast<E>(0)), hasValue_(true) {}
+    explicit constexpr Result(SuccessTag) noexcept : storage_(ok_tag) {}
 
     /**
      * @brief Construct an error result with tag
      * @param error The error code
      */
-    Result(ErrorTag, E error) noexcept
-        : value_(), error_(error), hasValue_(false) {}
+    constexpr Result(ErrorTag, E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : storage_(err_tag, error) {
+        setLocation(location);
+        detail::countError(error);
+    }
 
     /**
-     * @brief Create a success result
-     * @param value The success value
-     * @return Result containing the value
+     * @brief Construct an error result from an untyped Failure
+     * @param failure The error to propagate
      */
-    static Result ok(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) {
-        return Result(value);
+    constexpr Result(Failure<E> failure) noexcept : storage_(err_tag, failure.error) {
+        setLocation(detail::failureLocation(failure));
     }
 
+#if LIBCOMMON_HAS_STD_EXPECTED
     /**
-     * @brief Create a success result with moved value
-     * @param value The success value (moved)
-     * @return Result containing the value
+     * @brief Convert from std::expected<void, E> (the error is not counted again)
      */
-    static Result ok(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) {
-        return Result(std::move(value));
+    constexpr Result(const std::expected<void, E>& other, ErrorLocation location = ErrorLocation::current()) noexcept
+        : storage_(other ? Storage(ok_tag) : Storage(err_tag, other.error())) {
+        if (LIBCOMMON_UNLIKELY(!other)) {
+            setLocation(location);
+        }
+    }
+
+    /**
+     * @brief Convert to std::expected<void, E> (the error location is dropped)
+     */
+    constexpr std::expected<void, E> toExpected() const noexcept {
+#if LIBCOMMON_EXPECTED_STORAGE
+        return storage_.expected_;
+#else
+        if (storage_.hasValue()) {
+            return std::expected<void, E>();
+        }
+        return std::expected<void, E>(std::unexpect, detail::storedError(storage_));
+#endif
+    }
+#endif
+
+    /**
+     * @brief Create a success result
+     * @return Successful Result
+     */
+    static constexpr Result ok() noexcept {
+        return Result();
     }
 
     /**
      * @brief Create an error result
      * @param error The error code
+     * @param location Where the error was created (defaults to the caller)
      * @return Result containing the error
      */
-    static Result error(E error) noexcept {
-        return Result(error);
+    static constexpr Result error(E error, ErrorLocation location = ErrorLocation::current()) noexcept {
+        return Result(error, location);
     }
 
     /**
-     * @brief Check if result contains a value (success)
-     * @return true if result is successful
+     * @brief Check if result is successful
+     * @return true if successful
      */
-    bool isOk() const noexcept { return hasValue_; }
+    constexpr bool isOk() const noexcept { return LIBCOMMON_LIKELY(storage_.hasValue()); }
 
     /**
-     * @brief Check if result contains an error
-     * @return true if result is an error
+     * @brief Check if result is an error
+     * @return true if error
      */
-    bool isError() const noexcept { return !hasValue_; }
+    constexpr bool isError() const noexcept { return !isOk(); }
 
     /**
      * @brief Boolean conversion - true if successful
      */
-    explicit operator bool() const noexcept { return hasValue_; }
+    explicit constexpr operator bool() const noexcept { return isOk(); }
 
     /**
-     * @brief Get the success value
-     * @return Reference to the value
-     * @warning Undefined behavior if result is an error
+     * @brief Get the error code
+     * @return The error code
      */
-    T& value() & noexcept { return value_; }
+    constexpr E error() const noexcept { return detail::storedError(storage_); }
 
     /**
-     * @brief Get the success value (const)
-     * @return Const reference to the value
-     * @warning Undefined behavior if result is an error
+     * @brief Get where the error was created
+     * @return The location, unknown unless LIBCOMMON_ERROR_LOCATION is set
      */
-    const T& value() const& noexcept { return value_; }
+    constexpr ErrorLocation location() const noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        return location_;
+#else
+        return ErrorLocation();
+#endif
+    }
 
     /**
-     * @brief Get the success value (rvalue)
-     * @return Rvalue reference to the value
-     * @warning Undefined behavior if result is an error
+     * @brief Get the error and its location for propagation
+     * @return Failure convertible to any Result with error type E
+     * @warning Undefined behavior if result is successful
      */
-    T&& value() && noexcept { return std::move(value_); }
+    constexpr Failure<E> failure() const noexcept {
+        return detail::failureOf(error(), location());
+    }
 
     /**
-     * @brief Get the error code
-     * @return The error code
-     * @warning Undefined behavior if result is successful
+     * @brief Produce a value if successful
+     * @tparam F Function type taking no arguments
+     * @param f Function to call
+     * @return Result with the produced value or original error
      */
-    E error() const noexcept { return error_; }
+    template<typename F>
+    constexpr auto map(F&& f) const {
+        using ResultType = Result<detail::InvokeResult<F>, E>;
+        if (storage_.hasValue()) {
+            return detail::invokeToResult<ResultType>(std::forward<F>(f));
+        }
+        return ResultType(failure());
+    }
 
     /**
-     * @brief Get value or default if error
-     * @param defaultValue Value to return if result is an error
-     * @return The value if successful, defaultValue otherwise
+     * @brief Alias for map(), matching the std::expected vocabulary
      */
-    T valueOr(const T& defaultValue) const& noexcept(std::is_nothrow_copy_constructible_v<T>) {
-        return hasValue_ ? value_ : defaultValue;
+    template<typename F>
+    constexpr auto transform(F&& f) const {
+        return map(std::forward<F>(f));
     }
 
     /**
-     * @brief Get value or default if error (move version)
-     * @param defaultValue Value to return if result is an error
-     * @return The value if successful, defaultValue otherwise
+     * @brief Apply function if successful, return error otherwise
+     * @tparam F Function type taking no arguments and returning Result<U, E>
+     * @param f Function to call
+     * @return Result from function or original error
      */
-    T valueOr(T&& defaultValue) && noexcept(std::is_nothrow_move_constructible_v<T>) {
-        return hasValue_ ? std::move(value_) : std::move(defaultValue);
+    template<typename F>
+    constexpr auto andThen(F&& f) const {
+        using ResultType = detail::InvokeResult<F>;
+        if (storage_.hasValue()) {
+            return std::forward<F>(f)();
+        }
+        return ResultType(failure());
     }
 
     /**
-     * @brief Map the value if successful
-     * @tparam F Function type
-     * @param f Function to apply to value
-     * @return Result with mapped value or original error
+     * @brief Map the error if unsuccessful
+     * @tparam F Function type taking E and returning the new error type
+     * @param f Function to apply to the error
+     * @return Successful Result or mapped error
      */
     template<typename F>
-    auto map(F&& f) const -> Result<decltype(f(std::declval<T>())), E> {
-        using ResultType = Result<decltype(f(std::declval<T>())), E>;
-        if (hasValue_) {
-            return ResultType::ok(f(value_));
+    constexpr auto mapError(F&& f) const {
+        using ResultType = Result<void, detail::InvokeResult<F, E>>;
+        if (storage_.hasValue()) {
+            return ResultType::ok();
         }
-        return ResultType::error(error_);
+        return ResultType(detail::failureOf(std::forward<F>(f)(detail::storedError(storage_)), location()));
     }
 
     /**
-     * @brief Apply function if successful, return error otherwise
-     * @tparam F Function type returning Result
-     * @param f Function to apply
-     * @return Result from function or original error
+     * @brief Recover from an error
+     * @tparam F Function type taking E and returning Result<void, G>
+     * @param f Function to apply to the error
+     * @return Successful Result, or the Result returned by f
      */
     template<typename F>
-    auto andThen(F&& f) const -> decltype(f(std::declval<T>())) {
-        using ResultType = decltype(f(std::declval<T>()));
-        if (hasValue_) {
-            return f(value_);
+    constexpr auto orElse(F&& f) const {
+        using ResultType = detail::InvokeResult<F, E>;
+        if (storage_.hasValue()) {
+            return ResultType::ok();
         }
-        return ResultType::error(error_);
+        return std::forward<F>(f)(detail::storedError(storage_));
     }
 
 private:
-    T value_;
-    E error_;
-    bool hasValue_;
+    constexpr void setLocation([[maybe_unused]] ErrorLocation location) noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        location_ = location;
+#endif
+    }
+
+    Storage storage_;
+#if LIBCOMMON_ERROR_LOCATION
+    ErrorLocation location_{};
+#endif
 };
 
 /**
- * @brief Specialization of Result for void (operations with no return value)
+ * @brief Specialization of Result for references
+ *
+ * Holds a pointer to the referenced object, so lookups such as "find
+ * device by address" return the object itself without copying it and
+ * without nullable pointer semantics. Use Result<const T&> for read-only
+ * access. Like a pointer, copying the Result copies the reference and
+ * assignment rebinds it; the referenced object must outlive the Result.
+ *
+ * Usage:
+ * @code
+ * Result<Device&> findDevice(uint8_t address);
+ *
+ * auto device = findDevice(0x10);
+ * if (device) {
+ *     device.value().poll();
+ * }
+ * @endcode
  */
-template<typename E>
-class Result<void, E> {
+template<typename T, typename E>
+class Result<T&, E> {
 public:
-    using ValueType = void;
+    using ValueType = T&;
     using ErrorType = E;
 
     /**
-     * @brief Construct a success result
+     * @brief Construct a success result referring to value
+     * @param value The referenced object
+     */
+    explicit constexpr Result(T& value) noexcept
+        : ptr_(std::addressof(value)), error_(static_cast<E>(0)) {}
+
+    /**
+     * @brief Binding a temporary would dangle (T& binds one when T is const)
      */
-    Result() noexcept : error_(static_cast<E>(0)), hasValue_(true) {}
+    template<typename U, typename = std::enable_if_t<!std::is_reference_v<U> &&
+                                                     std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>>>>
+    explicit Result(U&& value) = delete;
 
     /**
      * @brief Construct an error result
      * @param error The error code
      */
-    explicit Result(E error) noexcept : error_(error), hasValue_(false) {}
+    explicit constexpr Result(E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : ptr_(nullptr), error_(detail::storableError(error)) {
+        setLocation(location);
+        detail::countError(error);
+    }
 
     /**
      * @brief Construct a success result with tag
+     * @param value The referenced object
      */
-    explicit Result(SuccessTag) noexcept : error_(static_cast<E>(0)), hasValue_(true) {}
+    constexpr Result(SuccessTag, T& value) noexcept
+        : ptr_(std::addressof(value)), error_(static_cast<E>(0)) {}
+
+    template<typename U, typename = std::enable_if_t<!std::is_reference_v<U> &&
+                                                     std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>>>>
+    Result(SuccessTag, U&& value) = delete;
 
     /**
      * @brief Construct an error result with tag
      * @param error The error code
      */
-    Result(ErrorTag, E error) noexcept : error_(error), hasValue_(false) {}
+    constexpr Result(ErrorTag, E error, ErrorLocation location = ErrorLocation::current()) noexcept
+        : ptr_(nullptr), error_(detail::storableError(error)) {
+        setLocation(location);
+        detail::countError(error);
+    }
 
     /**
-     * @brief Create a success result
-     * @return Successful Result
+     * @brief Construct an error result from an untyped Failure
+     * @param failure The error to propagate
      */
-    static Result ok() noexcept {
-        return Result();
+    constexpr Result(Failure<E> failure) noexcept : ptr_(nullptr), error_(detail::storableError(failure.error)) {
+        setLocation(detail::failureLocation(failure));
+    }
+
+    /**
+     * @brief Create a success result referring to value
+     * @param value The referenced object
+     * @return Result referring to value
+     */
+    static constexpr Result ok(T& value) noexcept {
+        return Result(value);
     }
 
+    /**
+     * @brief Binding a temporary would dangle
+     */
+    static Result ok(T&& value) = delete;
+
     /**
      * @brief Create an error result
      * @param error The error code
+     * @param location Where the error was created (defaults to the caller)
      * @return Result containing the error
      */
-    static Result error(E error) noexcept {
-        return Result(error);
+    static constexpr Result error(E error, ErrorLocation location = ErrorLocation::current()) noexcept {
+        return Result(error, location);
     }
 
     /**
-     * @brief Check if result is successful
-     * @return true if successful
+     * @brief Check if result refers to a value (success)
+     * @return true if result is successful
      */
-    bool isOk() const noexcept { return hasValue_; }
+    constexpr bool isOk() const noexcept { return LIBCOMMON_LIKELY(ptr_ != nullptr); }
 
     /**
-     * @brief Check if result is an error
-     * @return true if error
+     * @brief Check if result contains an error
+     * @return true if result is an error
      */
-    bool isError() const noexcept { return !hasValue_; }
+    constexpr bool isError() const noexcept { return !isOk(); }
 
     /**
      * @brief Boolean conversion - true if successful
      */
-    explicit operator bool() const noexcept { return hasValue_; }
+    explicit constexpr operator bool() const noexcept { return isOk(); }
+
+    /**
+     * @brief Get the referenced object
+     * @return Reference to the object
+     * @warning Undefined behavior if result is an error
+     */
+    constexpr T& value() const noexcept { return *ptr_; }
 
     /**
      * @brief Get the error code
      * @return The error code
+     * @warning Undefined behavior if result is successful
+     */
+    constexpr E error() const noexcept { return error_; }
+
+    /**
+     * @brief Get where the error was created
+     * @return The location, unknown unless LIBCOMMON_ERROR_LOCATION is set
+     */
+    constexpr ErrorLocation location() const noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        return location_;
+#else
+        return ErrorLocation();
+#endif
+    }
+
+    /**
+     * @brief Get the error and its location for propagation
+     * @return Failure convertible to any Result with error type E
+     * @warning Undefined behavior if result is successful
+     */
+    constexpr Failure<E> failure() const noexcept {
+        return detail::failureOf(error(), location());
+    }
+
+    /**
+     * @brief Get the referenced object or a fallback if error
+     * @param defaultValue Object to refer to if result is an error
+     * @return The referenced object if successful, defaultValue otherwise
+     */
+    constexpr T& valueOr(T& defaultValue) const noexcept {
+        return ptr_ ? *ptr_ : defaultValue;
+    }
+
+    /**
+     * @brief Map the referenced object if successful
+     * @tparam F Function type taking T&
+     * @param f Function to apply to the referenced object
+     * @return Result with mapped value or original error
+     */
+    template<typename F>
+    constexpr auto map(F&& f) const {
+        using ResultType = Result<detail::InvokeResult<F, T&>, E>;
+        if (ptr_) {
+            return detail::invokeToResult<ResultType>(std::forward<F>(f), *ptr_);
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Alias for map(), matching the std::expected vocabulary
+     */
+    template<typename F>
+    constexpr auto transform(F&& f) const {
+        return map(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Apply function if successful, return error otherwise
+     * @tparam F Function type taking T& and returning Result<U, E>
+     * @param f Function to apply
+     * @return Result from function or original error
+     */
+    template<typename F>
+    constexpr auto andThen(F&& f) const {
+        using ResultType = detail::InvokeResult<F, T&>;
+        if (ptr_) {
+            return std::forward<F>(f)(*ptr_);
+        }
+        return ResultType(failure());
+    }
+
+    /**
+     * @brief Map the error if unsuccessful
+     * @tparam F Function type taking E and returning the new error type
+     * @param f Function to apply to the error
+     * @return Result with the original reference or mapped error
+     */
+    template<typename F>
+    constexpr auto mapError(F&& f) const {
+        using ResultType = Result<T&, detail::InvokeResult<F, E>>;
+        if (ptr_) {
+            return ResultType::ok(*ptr_);
+        }
+        return ResultType(detail::failureOf(std::forward<F>(f)(error_), location()));
+    }
+
+    /**
+     * @brief Recover from an error
+     * @tparam F Function type taking E and returning Result<T&, G>
+     * @param f Function to apply to the error
+     * @return The original reference, or the Result returned by f
      */
-    E error() const noexcept { return error_; }
+    template<typename F>
+    constexpr auto orElse(F&& f) const {
+        using ResultType = detail::InvokeResult<F, E>;
+        if (ptr_) {
+            return ResultType::ok(*ptr_);
+        }
+        return std::forward<F>(f)(error_);
+    }
 
 private:
+    constexpr void setLocation([[maybe_unused]] ErrorLocation location) noexcept {
+#if LIBCOMMON_ERROR_LOCATION
+        location_ = location;
+#endif
+    }
+
+    T* ptr_;
     E error_;
-    bool hasValue_;
+#if LIBCOMMON_ERROR_LOCATION
+    ErrorLocation location_{};
+#endif
 };
 
+// Packed layouts must stay register-sized and trivially copyable (not
+// promised by the std::expected layout, which is only for comparison)
+#if !LIBCOMMON_EXPECTED_STORAGE
+#if !LIBCOMMON_ERROR_LOCATION
+static_assert(sizeof(Result<void>) == sizeof(ErrorCode),
+              "Result<void> must be exactly one ErrorCode");
+static_assert(sizeof(Result<uint16_t>) == sizeof(uint32_t),
+              "Result<uint16_t> must pack into one 32-bit word");
+static_assert(sizeof(Result<float>) <= detail::kPackedResultMaxSize,
+              "Result<float> must fit the packed size limit");
+#endif
+static_assert(std::is_trivially_copyable_v<Result<void>>,
+              "Result<void> must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Result<uint16_t>>,
+              "Result<uint16_t> must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Result<float>>,
+              "Result<float> must be trivially copyable");
+
+// Unpacked Results inherit triviality from T
+static_assert(std::is_trivially_copyable_v<Result<double>>,
+              "Result<double> must be trivially copyable");
+static_assert(std::is_trivially_destructible_v<Result<double>>,
+              "Result<double> must be trivially destructible");
+#endif
+
+// Reference Results are a pointer and a code
+static_assert(std::is_trivially_copyable_v<Result<int&>>,
+              "Result<T&> must be trivially copyable");
+
 /**
  * @brief Helper function to create a success Result
  * @tparam T Value type
  * @tparam E Error type
- * @param value The success value
+ * @param value The success value (copied or moved; see makeRef())
  * @return Result containing the value
  */
 template<typename T, typename E = ErrorCode>
-Result<T, E> makeOk(T&& value) {
-    return Result<T, E>::ok(std::forward<T>(value));
+constexpr Result<std::decay_t<T>, E> makeOk(T&& value) {
+    return Result<std::decay_t<T>, E>::ok(std::forward<T>(value));
+}
+
+/**
+ * @brief Helper function to create a success Result referring to value
+ * @tparam T Referenced type (const for a const lvalue)
+ * @tparam E Error type
+ * @param value The referenced object, which must outlive the Result
+ * @return Result<T&, E> referring to value
+ */
+template<typename T, typename E = ErrorCode>
+constexpr Result<T&, E> makeRef(T& value) noexcept {
+    return Result<T&, E>::ok(value);
 }
 
+/**
+ * @brief Referring to a temporary would dangle
+ */
+template<typename T, typename E = ErrorCode>
+void makeRef(const T&& value) = delete;
+
 /**
  * @brief Helper function to create a void success Result
  * @tparam E Error type
  * @return Successful void Result
  */
 template<typename E = ErrorCode>
-Result<void, E> makeOk() {
+constexpr Result<void, E> makeOk() {
     return Result<void, E>::ok();
 }
 
@@ -324,11 +1761,12 @@ Result<void, E> makeOk() {
  * @tparam T Value type
  * @tparam E Error type
  * @param error The error code
+ * @param location Where the error was created (defaults to the caller)
  * @return Result containing the error
  */
 template<typename T, typename E = ErrorCode>
-Result<T, E> makeError(E error) {
-    return Result<T, E>::error(error);
+constexpr Result<T, E> makeError(E error, ErrorLocation location = ErrorLocation::current()) {
+    return Result<T, E>::error(error, location);
 }
 
 } // namespace common
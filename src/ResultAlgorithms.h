@@ -0,0 +1,460 @@
+/**
+ * @file ResultAlgorithms.h
+ * @brief Combine many Results: collect(), all() and partition()
+ *
+ * A poll cycle reads dozens of registers, each read a Result<T>. These
+ * helpers combine them without hand-written loops or heap allocation:
+ *
+ * - collect(): all values as a Result<std::array<T, N>>, or the first error
+ * - all(): Result<void> with the first error, values discarded
+ * - partition(): keep going; a bitmap of which elements succeeded plus the
+ *   first error, so one bad register does not discard the whole cycle
+ *
+ * Each takes a fixed array of Results, a pointer and count, or a generator:
+ * a callable taking the element index and returning Result<T>. With a
+ * generator, collect() and all() stop calling it at the first error.
+ *
+ * For a few Results of different types, zip() gathers the values in a
+ * Result<std::tuple<...>> and apply() passes them straight to a function.
+ *
+ * @code
+ * auto poll = [&](size_t i) { return modbus.readHolding(kFirstRegister + i); };
+ *
+ * // All 32 registers or nothing
+ * auto block = collect<32>(poll);
+ *
+ * // Whatever could be read; failed slots keep their previous value
+ * static std::array<uint16_t, 32> registers;
+ * BatchStatus<32> status = partition<32>(poll, registers);
+ * for (size_t i = 0; i < 32; ++i) {
+ *     if (!status.isOk(i)) { markStale(i); }
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "ErrorCodes.h"
+#include "Result.h"
+
+namespace common {
+
+/**
+ * @brief Fixed-size bitmap, one bit per batch element, packed in 32-bit words
+ * @tparam N Number of bits
+ */
+template<size_t N>
+struct BatchMask {
+    static constexpr size_t kWords = N == 0 ? 1 : (N + 31) / 32;
+
+    uint32_t words[kWords] = {};
+
+    /**
+     * @brief Check bit index
+     */
+    constexpr bool test(size_t index) const noexcept {
+        return (words[index / 32] >> (index % 32)) & 1u;
+    }
+
+    /**
+     * @brief Set bit index
+     */
+    constexpr void set(size_t index) noexcept {
+        words[index / 32] |= 1u << (index % 32);
+    }
+
+    /**
+     * @brief Number of bits set
+     */
+    constexpr size_t count() const noexcept {
+        size_t bits = 0;
+        for (uint32_t word : words) {
+            for (; word != 0; word &= word - 1) {
+                ++bits;
+            }
+        }
+        return bits;
+    }
+};
+
+/**
+ * @brief Outcome of a collect-all batch: which elements succeeded, and
+ *        the first error
+ * @tparam N Number of elements
+ * @tparam E Error type
+ */
+template<size_t N, typename E = ErrorCode>
+struct BatchStatus {
+    BatchMask<N> ok;            ///< Bit i set: element i succeeded
+    size_t size = N;            ///< Elements in the batch (at most N)
+    size_t firstErrorIndex = N; ///< Index of the first failed element; size if none
+    E firstError{};             ///< Error of that element; E{} if none
+
+    /**
+     * @brief Check if element index succeeded
+     */
+    constexpr bool isOk(size_t index) const noexcept {
+        return ok.test(index);
+    }
+
+    /**
+     * @brief Check if every element succeeded
+     */
+    constexpr bool allOk() const noexcept {
+        return firstErrorIndex >= size;
+    }
+
+    /**
+     * @brief Number of elements that succeeded
+     */
+    constexpr size_t okCount() const noexcept {
+        return ok.count();
+    }
+
+    /**
+     * @brief Number of elements that failed
+     */
+    constexpr size_t errorCount() const noexcept {
+        return size - ok.count();
+    }
+
+    /**
+     * @brief The first error as a Result<void>, for propagation
+     */
+    constexpr Result<void, E> toResult() const noexcept {
+        if (allOk()) {
+            return Result<void, E>::ok();
+        }
+        return Result<void, E>(detail::failureOf(firstError, ErrorLocation()));
+    }
+};
+
+namespace detail {
+
+template<typename R>
+struct IsResult : std::false_type {};
+
+template<typename T, typename E>
+struct IsResult<Result<T, E>> : std::true_type {};
+
+/// Result type returned by generator g for an index
+template<typename G>
+using GeneratedResult = std::decay_t<std::invoke_result_t<G&, size_t>>;
+
+template<typename R>
+using ValueOf = typename std::decay_t<R>::ValueType;
+
+template<typename R>
+using ErrorOf = typename std::decay_t<R>::ErrorType;
+
+/**
+ * @brief Check that each argument is a non-void Result with error type E
+ */
+template<typename E, typename... Rs>
+constexpr bool zippable() noexcept {
+    return ((IsResult<std::decay_t<Rs>>::value && ...)) && ((std::is_same_v<ErrorOf<Rs>, E> && ...)) &&
+           ((!std::is_void_v<ValueOf<Rs>>) && ...);
+}
+
+/**
+ * @brief Store the first error among results in failure
+ * @return true if any result is an error
+ */
+template<typename E, typename... Rs>
+constexpr bool firstFailure(Failure<E>& failure, const Rs&... results) noexcept {
+    return ((LIBCOMMON_UNLIKELY(results.isError()) ? (failure = results.failure(), true) : false) || ...);
+}
+
+template<typename T, typename E, size_t N, size_t... I>
+constexpr Result<std::array<T, N>, E> collectValues(const Result<T, E>* results, std::index_sequence<I...>) {
+    return Result<std::array<T, N>, E>(in_place, std::array<T, N>{{results[I].value()...}});
+}
+
+template<typename T, typename E, size_t N, size_t... I>
+constexpr Result<std::array<T, N>, E> collectMovedValues(Result<T, E>* results, std::index_sequence<I...>) {
+    return Result<std::array<T, N>, E>(in_place, std::array<T, N>{{std::move(results[I]).value()...}});
+}
+
+} // namespace detail
+
+/**
+ * @brief Check that every Result succeeded
+ * @param results First Result
+ * @param count Number of Results
+ * @return Success, or the first error (with its location)
+ */
+template<typename T, typename E>
+constexpr Result<void, E> all(const Result<T, E>* results, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        if (LIBCOMMON_UNLIKELY(results[i].isError())) {
+            return Result<void, E>(results[i].failure());
+        }
+    }
+    return Result<void, E>::ok();
+}
+
+/**
+ * @brief Check that every Result in an array succeeded
+ */
+template<typename T, typename E, size_t N>
+constexpr Result<void, E> all(const std::array<Result<T, E>, N>& results) noexcept {
+    return all(results.data(), N);
+}
+
+/**
+ * @brief Check that every Result in an array succeeded
+ */
+template<typename T, typename E, size_t N>
+constexpr Result<void, E> all(const Result<T, E> (&results)[N]) noexcept {
+    return all(results, N);
+}
+
+/**
+ * @brief Call generator(0) .. generator(N - 1) until one fails
+ * @tparam N Number of calls
+ * @param generator Callable taking the index and returning Result<T>
+ * @return Success, or the first error; later indices are not called
+ */
+template<size_t N, typename G>
+constexpr auto all(G&& generator) -> Result<void, typename detail::GeneratedResult<G>::ErrorType> {
+    using Generated = detail::GeneratedResult<G>;
+    using E = typename Generated::ErrorType;
+    static_assert(detail::IsResult<Generated>::value, "the generator must return a Result");
+
+    for (size_t i = 0; i < N; ++i) {
+        Generated result = generator(i);
+        if (LIBCOMMON_UNLIKELY(result.isError())) {
+            return Result<void, E>(result.failure());
+        }
+    }
+    return Result<void, E>::ok();
+}
+
+/**
+ * @brief Gather the values of an array of Results
+ * @return All values in order, or the first error (with its location)
+ */
+template<typename T, typename E, size_t N>
+constexpr Result<std::array<T, N>, E> collect(const std::array<Result<T, E>, N>& results) {
+    const Result<void, E> checked = all(results.data(), N);
+    if (LIBCOMMON_UNLIKELY(checked.isError())) {
+        return Result<std::array<T, N>, E>(checked.failure());
+    }
+    return detail::collectValues<T, E, N>(results.data(), std::make_index_sequence<N>());
+}
+
+/**
+ * @brief Gather the values of an array of Results, moving them out
+ */
+template<typename T, typename E, size_t N>
+constexpr Result<std::array<T, N>, E> collect(std::array<Result<T, E>, N>&& results) {
+    const Result<void, E> checked = all(results.data(), N);
+    if (LIBCOMMON_UNLIKELY(checked.isError())) {
+        return Result<std::array<T, N>, E>(checked.failure());
+    }
+    return detail::collectMovedValues<T, E, N>(results.data(), std::make_index_sequence<N>());
+}
+
+/**
+ * @brief Gather the values of an array of Results
+ */
+template<typename T, typename E, size_t N>
+constexpr Result<std::array<T, N>, E> collect(const Result<T, E> (&results)[N]) {
+    const Result<void, E> checked = all(results, N);
+    if (LIBCOMMON_UNLIKELY(checked.isError())) {
+        return Result<std::array<T, N>, E>(checked.failure());
+    }
+    return detail::collectValues<T, E, N>(results, std::make_index_sequence<N>());
+}
+
+/**
+ * @brief Call generator(0) .. generator(N - 1) and gather the values
+ * @tparam N Number of calls
+ * @param generator Callable taking the index and returning Result<T>
+ * @return All values in order, or the first error; later indices are
+ *         not called
+ * @note T must be default constructible (the array is filled in place)
+ */
+template<size_t N, typename G>
+constexpr auto collect(G&& generator)
+    -> Result<std::array<typename detail::GeneratedResult<G>::ValueType, N>,
+              typename detail::GeneratedResult<G>::ErrorType> {
+    using Generated = detail::GeneratedResult<G>;
+    using T = typename Generated::ValueType;
+    using E = typename Generated::ErrorType;
+    static_assert(detail::IsResult<Generated>::value, "the generator must return a Result");
+    static_assert(std::is_default_constructible_v<T>,
+                  "collect<N>(generator) fills the array in place; use partition() or an array of Results");
+
+    Result<std::array<T, N>, E> collected(in_place);
+    std::array<T, N>& values = collected.value();
+    for (size_t i = 0; i < N; ++i) {
+        Generated result = generator(i);
+        if (LIBCOMMON_UNLIKELY(result.isError())) {
+            return Result<std::array<T, N>, E>(result.failure());
+        }
+        values[i] = std::move(result).value();
+    }
+    return collected;
+}
+
+/**
+ * @brief Check each Result and record which ones succeeded
+ * @tparam N Capacity of the status (count is clamped to it)
+ * @param results First Result
+ * @param count Number of Results
+ * @return Success bitmap and the first error
+ */
+template<size_t N, typename T, typename E>
+constexpr BatchStatus<N, E> partition(const Result<T, E>* results, size_t count) noexcept {
+    BatchStatus<N, E> status;
+    status.size = count < N ? count : N;
+    status.firstErrorIndex = status.size;
+    for (size_t i = 0; i < status.size; ++i) {
+        if (LIBCOMMON_LIKELY(results[i].isOk())) {
+            status.ok.set(i);
+        } else if (status.firstErrorIndex == status.size) {
+            status.firstErrorIndex = i;
+            status.firstError = results[i].error();
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Check each Result of an array and record which ones succeeded
+ */
+template<typename T, typename E, size_t N>
+constexpr BatchStatus<N, E> partition(const std::array<Result<T, E>, N>& results) noexcept {
+    return partition<N>(results.data(), N);
+}
+
+/**
+ * @brief Check each Result of an array and record which ones succeeded
+ */
+template<typename T, typename E, size_t N>
+constexpr BatchStatus<N, E> partition(const Result<T, E> (&results)[N]) noexcept {
+    return partition<N>(results, N);
+}
+
+/**
+ * @brief Call generator(0) .. generator(N - 1), storing every value that
+ *        could be produced
+ * @tparam N Number of calls
+ * @param generator Callable taking the index and returning Result<T>
+ * @param values Receives the value of each successful call; slots of
+ *        failed calls are left untouched (e.g. the previous cycle's value)
+ * @return Success bitmap and the first error
+ */
+template<size_t N, typename G, typename T>
+constexpr auto partition(G&& generator, std::array<T, N>& values)
+    -> BatchStatus<N, typename detail::GeneratedResult<G>::ErrorType> {
+    using Generated = detail::GeneratedResult<G>;
+    using E = typename Generated::ErrorType;
+    static_assert(detail::IsResult<Generated>::value, "the generator must return a Result");
+    static_assert(std::is_assignable_v<T&, typename Generated::ValueType&&>,
+                  "the generator's values must be assignable to the array");
+
+    BatchStatus<N, E> status;
+    // Each mask word is built in a register and stored once
+    for (size_t word = 0; word * 32 < N; ++word) {
+        const size_t end = (word + 1) * 32 < N ? (word + 1) * 32 : N;
+        uint32_t bits = 0;
+        for (size_t i = word * 32; i < end; ++i) {
+            Generated result = generator(i);
+            if (LIBCOMMON_LIKELY(result.isOk())) {
+                values[i] = std::move(result).value();
+                bits |= 1u << (i % 32);
+            } else if (status.firstErrorIndex == N) {
+                status.firstErrorIndex = i;
+                status.firstError = result.error();
+            }
+        }
+        status.ok.words[word] = bits;
+    }
+    return status;
+}
+
+/**
+ * @brief Combine Results of different types into one Result of a tuple
+ *
+ * The values are moved out of rvalue arguments and copied from lvalues.
+ *
+ * @code
+ * auto inputs = zip(readTemperature(), readPressure(), readFlow());
+ * if (!inputs) {
+ *     return makeFailure(inputs.error());
+ * }
+ * auto [temperature, pressure, flow] = std::move(inputs).value();
+ * @endcode
+ *
+ * @param first, rest Results sharing one error type (not Result<void>)
+ * @return All values, or the first error in argument order (with its
+ *         location)
+ */
+template<typename R, typename... Rs>
+constexpr auto zip(R&& first, Rs&&... rest)
+    -> Result<std::tuple<detail::ValueOf<R>, detail::ValueOf<Rs>...>, detail::ErrorOf<R>> {
+    using E = detail::ErrorOf<R>;
+    using ResultType = Result<std::tuple<detail::ValueOf<R>, detail::ValueOf<Rs>...>, E>;
+    static_assert(detail::zippable<E, R, Rs...>(), "zip() takes non-void Results with the same error type");
+
+    Failure<E> failure{};
+    if (detail::firstFailure(failure, first, rest...)) {
+        return ResultType(failure);
+    }
+    return ResultType(in_place, std::forward<R>(first).value(), std::forward<Rs>(rest).value()...);
+}
+
+/**
+ * @brief Call f with the values of several Results if all succeeded
+ *
+ * Like zip() followed by map(), without building the tuple: each value
+ * goes straight from its Result to f (moved out of rvalue arguments).
+ *
+ * @code
+ * Result<float> power = apply([](float volts, float amps) { return volts * amps; },
+ *                             readVoltage(), readCurrent());
+ * @endcode
+ *
+ * @param f Callable taking the values; it may return a plain value, void
+ *          or a Result<U, E> (returned as is, like andThen())
+ * @param first, second, rest Two or more Results sharing one error type
+ *          (not Result<void>); for a single Result use map() or andThen()
+ * @return f's result, or the first error in argument order
+ */
+template<typename F, typename R1, typename R2, typename... Rs>
+constexpr auto apply(F&& f, R1&& first, R2&& second, Rs&&... rest) {
+    using E = detail::ErrorOf<R1>;
+    using Returned = detail::InvokeResult<F, decltype(std::forward<R1>(first).value()),
+                                          decltype(std::forward<R2>(second).value()),
+                                          decltype(std::forward<Rs>(rest).value())...>;
+    static_assert(detail::zippable<E, R1, R2, Rs...>(), "apply() takes non-void Results with the same error type");
+
+    if constexpr (detail::IsResult<Returned>::value) {
+        static_assert(std::is_same_v<typename Returned::ErrorType, E>, "f must return the same error type");
+        Failure<E> failure{};
+        if (detail::firstFailure(failure, first, second, rest...)) {
+            return Returned(failure);
+        }
+        return std::forward<F>(f)(std::forward<R1>(first).value(), std::forward<R2>(second).value(),
+                                  std::forward<Rs>(rest).value()...);
+    } else {
+        using ResultType = Result<Returned, E>;
+        Failure<E> failure{};
+        if (detail::firstFailure(failure, first, second, rest...)) {
+            return ResultType(failure);
+        }
+        return detail::invokeToResult<ResultType>(std::forward<F>(f), std::forward<R1>(first).value(),
+                                                  std::forward<R2>(second).value(),
+                                                  std::forward<Rs>(rest).value()...);
+    }
+}
+
+} // namespace common
@@ -0,0 +1,386 @@
+/**
+ * @file ResultCoroutine.h
+ * @brief C++20 coroutine support for Result<T, E>
+ *
+ * Optional header. Any function returning Result<T, E> may be written as a
+ * coroutine: `co_await someResult` yields the value or immediately returns
+ * the error, and `co_return` produces the value.
+ *
+ * @code
+ * Result<float> readTemperature() {
+ *     uint16_t raw = co_await readRegister(0x10);
+ *     co_await checkRange(raw);                    // Result<void>
+ *     co_return raw * 0.1f;
+ * }
+ * @endcode
+ *
+ * These coroutines never really suspend: they run to completion inside
+ * the call, so frames are created and destroyed in strict LIFO order. The
+ * frame allocator can be replaced (see setFrameAllocator()) so frames live
+ * in a StaticFrameArena instead of the heap.
+ *
+ * Requires -std=c++20 (or gnu++20) and GCC 11+ or Clang 16+. Otherwise
+ * this header defines LIBCOMMON_HAS_RESULT_COROUTINES to 0 and nothing
+ * else.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+// Clang before 16 and MSVC convert the return object before the body runs,
+// which ResultReturnObject cannot support
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && \
+    !(defined(__clang__) && __clang_major__ < 16) && !defined(_MSC_VER)
+#define LIBCOMMON_HAS_RESULT_COROUTINES 1
+#else
+#define LIBCOMMON_HAS_RESULT_COROUTINES 0
+#endif
+
+#if LIBCOMMON_HAS_RESULT_COROUTINES
+
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+
+namespace common {
+
+/**
+ * @brief Allocation hook for coroutine frames of Result coroutines
+ *
+ * allocate must return nullptr when out of memory; the coroutine call then
+ * returns ErrorCode::OUT_OF_MEMORY (or aborts if E is not ErrorCode).
+ */
+struct FrameAllocator {
+    void* (*allocate)(size_t size, void* context) noexcept;
+    void (*deallocate)(void* frame, size_t size, void* context) noexcept;
+    void* context;
+};
+
+namespace detail {
+
+inline void* heapAllocateFrame(size_t size, void*) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+inline void heapDeallocateFrame(void* frame, size_t, void*) noexcept {
+    ::operator delete(frame);
+}
+
+inline FrameAllocator frameAllocator{&heapAllocateFrame, &heapDeallocateFrame, nullptr};
+
+} // namespace detail
+
+/**
+ * @brief Install the allocator used for all subsequent coroutine frames
+ * @param allocator The allocator; frames allocated by the previous one
+ *        must all have been released
+ * @note Not synchronized: install it during startup
+ */
+inline void setFrameAllocator(const FrameAllocator& allocator) noexcept {
+    detail::frameAllocator = allocator;
+}
+
+/**
+ * @brief Get the allocator currently used for coroutine frames
+ */
+inline FrameAllocator getFrameAllocator() noexcept {
+    return detail::frameAllocator;
+}
+
+/**
+ * @brief Restore the default heap allocator for coroutine frames
+ */
+inline void resetFrameAllocator() noexcept {
+    detail::frameAllocator = {&detail::heapAllocateFrame, &detail::heapDeallocateFrame, nullptr};
+}
+
+/**
+ * @class StaticFrameArena
+ * @brief Fixed-size LIFO arena for Result coroutine frames
+ *
+ * Result coroutines complete before returning, so their frames are freed
+ * in reverse allocation order and a bump pointer is enough. Not
+ * thread-safe: use one arena per task or only one coroutine-running task.
+ *
+ * @code
+ * static StaticFrameArena<2048> arena;
+ * setFrameAllocator(arena.allocator());
+ * @endcode
+ *
+ * @tparam Size Arena capacity in bytes
+ */
+template<size_t Size>
+class StaticFrameArena {
+public:
+    StaticFrameArena() = default;
+    StaticFrameArena(const StaticFrameArena&) = delete;
+    StaticFrameArena& operator=(const StaticFrameArena&) = delete;
+
+    /**
+     * @brief Allocator handle that draws frames from this arena
+     */
+    FrameAllocator allocator() noexcept {
+        return {&allocateThunk, &deallocateThunk, this};
+    }
+
+    /**
+     * @brief Allocate size bytes, or nullptr if the arena is exhausted
+     */
+    void* allocate(size_t size) noexcept {
+        size = alignUp(size);
+        if (size > Size - top_) {
+            return nullptr;
+        }
+        void* frame = buffer_ + top_;
+        top_ += size;
+        if (top_ > highWater_) {
+            highWater_ = top_;
+        }
+        return frame;
+    }
+
+    /**
+     * @brief Release the most recent allocation
+     *
+     * Out-of-order releases are ignored and reclaimed by reset().
+     */
+    void deallocate(void* frame, size_t size) noexcept {
+        size = alignUp(size);
+        if (static_cast<unsigned char*>(frame) + size == buffer_ + top_) {
+            top_ -= size;
+        }
+    }
+
+    /**
+     * @brief Discard all allocations
+     */
+    void reset() noexcept { top_ = 0; }
+
+    /**
+     * @brief Bytes currently allocated
+     */
+    size_t used() const noexcept { return top_; }
+
+    /**
+     * @brief Largest number of bytes ever allocated at once
+     */
+    size_t highWater() const noexcept { return highWater_; }
+
+private:
+    static constexpr size_t kAlign = alignof(std::max_align_t);
+
+    static constexpr size_t alignUp(size_t size) noexcept {
+        return (size + kAlign - 1) & ~(kAlign - 1);
+    }
+
+    static void* allocateThunk(size_t size, void* context) noexcept {
+        return static_cast<StaticFrameArena*>(context)->allocate(size);
+    }
+
+    static void deallocateThunk(void* frame, size_t size, void* context) noexcept {
+        static_cast<StaticFrameArena*>(context)->deallocate(frame, size);
+    }
+
+    alignas(kAlign) unsigned char buffer_[Size];
+    size_t top_ = 0;
+    size_t highWater_ = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief Awaiter for co_await on a Result
+ *
+ * Refers to the awaited Result: temporaries live until the end of the
+ * co_await full-expression, which covers await_resume.
+ */
+template<typename R>
+class ResultAwaiter {
+public:
+    explicit ResultAwaiter(R&& result) noexcept : result_(std::forward<R>(result)) {}
+
+    bool await_ready() const noexcept { return result_.isOk(); }
+
+    template<typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        handle.promise().fail(result_.failure());
+        handle.destroy();
+    }
+
+    decltype(auto) await_resume() noexcept {
+        if constexpr (!std::is_void_v<typename std::remove_reference_t<R>::ValueType>) {
+            return std::forward<R>(result_).value();
+        }
+    }
+
+private:
+    R&& result_;
+};
+
+/**
+ * @brief Awaiter for co_await on a Failure: always returns the error
+ */
+template<typename E>
+class FailureAwaiter {
+public:
+    explicit FailureAwaiter(Failure<E> failure) noexcept : failure_(failure) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    template<typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        handle.promise().fail(failure_);
+        handle.destroy();
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Failure<E> failure_;
+};
+
+/**
+ * @brief Object returned by get_return_object(), converted to the Result
+ *
+ * Holds the coroutine's outcome. The promise writes into it through a
+ * pointer, so it must not move: it is only ever initialized from a
+ * prvalue. Relies on the conversion to Result happening after the body
+ * has run, as GCC and Clang 16+ do when the types differ; a conversion
+ * before anything was published aborts instead of returning the
+ * placeholder error.
+ */
+template<typename T, typename E>
+class ResultReturnObject {
+public:
+    using ResultType = Result<T, E>;
+
+    explicit ResultReturnObject(ResultReturnObject** slot) noexcept
+        : result_(detail::failureOf(detail::storableError(E{}), ErrorLocation())) {
+        *slot = this;
+    }
+
+    ResultReturnObject(const ResultReturnObject&) = delete;
+    ResultReturnObject& operator=(const ResultReturnObject&) = delete;
+
+    // Replace rather than assign: T need not be assignable
+    void publish(ResultType&& result) noexcept {
+        result_.~ResultType();
+        ::new (static_cast<void*>(&result_)) ResultType(std::move(result));
+        published_ = true;
+    }
+
+    operator ResultType() noexcept {
+        if (LIBCOMMON_UNLIKELY(!published_)) {
+            std::abort();  // converted before the coroutine body ran
+        }
+        return std::move(result_);
+    }
+
+private:
+    ResultType result_;
+    bool published_ = false;
+};
+
+/**
+ * @brief Promise machinery shared by value and void Result coroutines
+ */
+template<typename T, typename E>
+class ResultPromiseBase {
+public:
+    using ResultType = Result<T, E>;
+
+    ResultReturnObject<T, E> get_return_object() noexcept {
+        return ResultReturnObject<T, E>(&target_);
+    }
+
+    static ResultType get_return_object_on_allocation_failure() noexcept {
+        if constexpr (std::is_same_v<E, ErrorCode>) {
+            return ResultType::error(ErrorCode::OUT_OF_MEMORY);
+        } else {
+            std::abort();
+        }
+    }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+    static void* operator new(size_t size) noexcept {
+        return frameAllocator.allocate(size, frameAllocator.context);
+    }
+
+    static void operator delete(void* frame, size_t size) noexcept {
+        frameAllocator.deallocate(frame, size, frameAllocator.context);
+    }
+
+    template<typename U>
+    ResultAwaiter<Result<U, E>&&> await_transform(Result<U, E>&& result) const noexcept {
+        return ResultAwaiter<Result<U, E>&&>(std::move(result));
+    }
+
+    template<typename U>
+    ResultAwaiter<Result<U, E>&> await_transform(Result<U, E>& result) const noexcept {
+        return ResultAwaiter<Result<U, E>&>(result);
+    }
+
+    template<typename U>
+    ResultAwaiter<const Result<U, E>&> await_transform(const Result<U, E>& result) const noexcept {
+        return ResultAwaiter<const Result<U, E>&>(result);
+    }
+
+    FailureAwaiter<E> await_transform(Failure<E> failure) const noexcept {
+        return FailureAwaiter<E>(failure);
+    }
+
+    void fail(Failure<E> failure) noexcept {
+        publish(ResultType(failure));
+    }
+
+protected:
+    void publish(ResultType&& result) noexcept {
+        target_->publish(std::move(result));
+    }
+
+private:
+    ResultReturnObject<T, E>* target_ = nullptr;
+};
+
+template<typename T, typename E>
+class ResultPromise : public ResultPromiseBase<T, E> {
+    using Base = ResultPromiseBase<T, E>;
+
+public:
+    void return_value(Result<T, E> result) noexcept {
+        this->publish(std::move(result));
+    }
+
+    template<typename U, typename = std::enable_if_t<std::is_constructible_v<T, U&&>>>
+    void return_value(U&& value) noexcept {
+        this->publish(Result<T, E>(in_place, std::forward<U>(value)));
+    }
+};
+
+template<typename E>
+class ResultPromise<void, E> : public ResultPromiseBase<void, E> {
+public:
+    void return_void() noexcept {
+        this->publish(Result<void, E>::ok());
+    }
+};
+
+} // namespace detail
+
+} // namespace common
+
+/**
+ * @brief Make Result<T, E> usable as a coroutine return type
+ */
+template<typename T, typename E, typename... Args>
+struct std::coroutine_traits<common::Result<T, E>, Args...> {
+    static_assert(!std::is_reference_v<T>, "Result<T&> cannot be a coroutine return type");
+    using promise_type = common::detail::ResultPromise<T, E>;
+};
+
+#endif // LIBCOMMON_HAS_RESULT_COROUTINES
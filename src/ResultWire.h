@@ -0,0 +1,359 @@
+/**
+ * @file ResultWire.h
+ * @brief Compact binary encoding of Result<T> for telemetry frames
+ *
+ * Each Result starts with a varint tag whose low bit says which it is:
+ *
+ * - error:   tag = zigzag(error) << 1 | 1, nothing follows
+ * - success: integers, enums and bool of up to 32 bits travel in the tag
+ *   itself (tag = value << 1, signed values zigzag-encoded); wider values
+ *   follow a 0 tag (float and double as little-endian IEEE 754 bytes,
+ *   64-bit integers as a varint); Result<void> is the 0 tag alone
+ *
+ * so Result<uint16_t> and most ErrorCode errors take 1-3 bytes and
+ * Result<float> 5. Encoding writes into a caller-provided buffer and
+ * decoding reads from one; neither allocates. A batch is the Results
+ * back to back: both sides know the frame layout, so no count or type is
+ * sent. Error locations are not transmitted.
+ *
+ * @code
+ * std::array<Result<float>, 8> readings = pollSensors();
+ * uint8_t frame[8 * maxWireSize<float>()];
+ * auto length = encodeResults(readings, frame, sizeof(frame));
+ *
+ * // Gateway: each device's array of Results is overwritten per frame
+ * auto consumed = decodeResults(frame, length.value(), device.readings);
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "ErrorCodes.h"
+#include "Result.h"
+
+namespace common {
+
+namespace detail {
+
+constexpr size_t kMaxVarintSize = 10;
+
+template<typename T>
+using WireInteger = std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::common_type<T>>;
+
+template<typename T>
+constexpr bool isWireInteger() noexcept {
+    return std::is_integral_v<T> || std::is_enum_v<T>;
+}
+
+// Values that fit in the tag next to the error bit
+template<typename T>
+constexpr bool isWireTagged() noexcept {
+    if constexpr (isWireInteger<T>()) {
+        return sizeof(T) <= 4;
+    } else {
+        return false;
+    }
+}
+
+constexpr uint64_t wireZigzag(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t wireUnzigzag(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief Integer (or enum) as the unsigned number sent on the wire
+ */
+template<typename T>
+constexpr uint64_t wireFromInteger(T value) noexcept {
+    using U = typename WireInteger<T>::type;
+    if constexpr (std::is_signed_v<U>) {
+        return wireZigzag(static_cast<int64_t>(value));
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+/**
+ * @brief Inverse of wireFromInteger(); false if the number does not fit T
+ */
+template<typename T>
+constexpr bool wireToInteger(uint64_t wire, T& value) noexcept {
+    using U = typename WireInteger<T>::type;
+    if constexpr (std::is_same_v<U, bool>) {
+        if (wire > 1) {
+            return false;
+        }
+        value = static_cast<T>(wire != 0);
+    } else if constexpr (std::is_signed_v<U>) {
+        const int64_t decoded = wireUnzigzag(wire);
+        if (decoded < std::numeric_limits<U>::min() || decoded > std::numeric_limits<U>::max()) {
+            return false;
+        }
+        value = static_cast<T>(static_cast<U>(decoded));
+    } else {
+        if (wire > std::numeric_limits<U>::max()) {
+            return false;
+        }
+        value = static_cast<T>(static_cast<U>(wire));
+    }
+    return true;
+}
+
+// Caller guarantees room for the varint (at most kMaxVarintSize bytes)
+inline size_t wirePutVarint(uint8_t* out, uint64_t value) noexcept {
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+inline Result<size_t> wireGetVarint(const uint8_t* in, size_t size, uint64_t& value) noexcept {
+    // Float tags and most error tags are one byte
+    if (LIBCOMMON_LIKELY(size != 0 && in[0] < 0x80)) {
+        value = in[0];
+        return Result<size_t>::ok(1);
+    }
+    uint64_t decoded = 0;
+    const size_t limit = size < kMaxVarintSize ? size : kMaxVarintSize;
+    for (size_t i = 0; i < limit; ++i) {
+        const uint8_t byte = in[i];
+        if (LIBCOMMON_UNLIKELY(i == kMaxVarintSize - 1 && byte > 1)) {
+            return Result<size_t>::error(ErrorCode::INVALID_DATA);
+        }
+        decoded |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            value = decoded;
+            return Result<size_t>::ok(i + 1);
+        }
+    }
+    return Result<size_t>::error(size < kMaxVarintSize ? ErrorCode::BUFFER_UNDERFLOW : ErrorCode::INVALID_DATA);
+}
+
+template<typename T>
+constexpr size_t wireValueSize() noexcept {
+    if constexpr (std::is_void_v<T> || isWireTagged<T>()) {
+        return 0;
+    } else if constexpr (isWireInteger<T>()) {
+        return kMaxVarintSize;
+    } else {
+        return sizeof(T);
+    }
+}
+
+template<typename T>
+constexpr size_t wireTagSize() noexcept {
+    if constexpr (isWireTagged<T>()) {
+        return (sizeof(T) * 8 + 1 + 6) / 7;
+    } else {
+        return 1;
+    }
+}
+
+template<typename T, typename E>
+constexpr void checkWireTypes() noexcept {
+    static_assert(std::is_void_v<T> || isWireInteger<T>() || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "ResultWire encodes integers, enums, bool, float, double and void");
+    static_assert(isWireInteger<E>() && sizeof(E) <= 4, "ResultWire encodes error enums and integers of up to 32 bits");
+    static_assert(!std::is_floating_point_v<T> || std::numeric_limits<T>::is_iec559,
+                  "ResultWire sends floating-point values as IEEE 754");
+}
+
+} // namespace detail
+
+/**
+ * @brief Largest number of bytes one encoded Result<T, E> can take
+ */
+template<typename T, typename E = ErrorCode>
+constexpr size_t maxWireSize() noexcept {
+    detail::checkWireTypes<T, E>();
+    constexpr size_t success = detail::wireTagSize<T>() + detail::wireValueSize<T>();
+    constexpr size_t error = (sizeof(E) * 8 + 1 + 6) / 7;
+    return success > error ? success : error;
+}
+
+/**
+ * @brief Encode one Result
+ * @param result Result to encode
+ * @param out Destination buffer
+ * @param capacity Bytes available at out
+ * @return Bytes written, or BUFFER_OVERFLOW (nothing written)
+ */
+template<typename T, typename E>
+Result<size_t> encodeResult(const Result<T, E>& result, uint8_t* out, size_t capacity) noexcept {
+    detail::checkWireTypes<T, E>();
+    // Near the end of the buffer, encode to the side and copy if it fits
+    uint8_t spare[maxWireSize<T, E>()];
+    uint8_t* bytes = LIBCOMMON_LIKELY(capacity >= sizeof(spare)) ? out : spare;
+    size_t size;
+    if (LIBCOMMON_UNLIKELY(result.isError())) {
+        size = detail::wirePutVarint(bytes, (detail::wireFromInteger(result.error()) << 1) | 1);
+    } else if constexpr (std::is_void_v<T>) {
+        bytes[0] = 0;
+        size = 1;
+    } else if constexpr (detail::isWireTagged<T>()) {
+        size = detail::wirePutVarint(bytes, detail::wireFromInteger(result.value()) << 1);
+    } else if constexpr (detail::isWireInteger<T>()) {
+        bytes[0] = 0;
+        size = 1 + detail::wirePutVarint(bytes + 1, detail::wireFromInteger(result.value()));
+    } else {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        Bits bits;
+        const T value = result.value();
+        std::memcpy(&bits, &value, sizeof(bits));
+        bytes[0] = 0;
+        for (size_t i = 0; i < sizeof(bits); ++i) {
+            bytes[1 + i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        size = 1 + sizeof(bits);
+    }
+    if (LIBCOMMON_UNLIKELY(bytes == spare)) {
+        if (size > capacity) {
+            return Result<size_t>::error(ErrorCode::BUFFER_OVERFLOW);
+        }
+        std::memcpy(out, spare, size);
+    }
+    return Result<size_t>::ok(size);
+}
+
+/**
+ * @brief Decode one Result
+ * @param in Encoded bytes
+ * @param size Bytes available at in
+ * @param result Receives the decoded Result (unchanged on failure)
+ * @return Bytes consumed, BUFFER_UNDERFLOW if the input ends early, or
+ *         INVALID_DATA if it is malformed, out of range for T / E, or an
+ *         error tag holding 0 for an E that reserves 0 for success
+ */
+template<typename T, typename E>
+Result<size_t> decodeResult(const uint8_t* in, size_t size, Result<T, E>& result) noexcept {
+    detail::checkWireTypes<T, E>();
+    uint64_t tag = 0;
+    auto tagSize = detail::wireGetVarint(in, size, tag);
+    if (LIBCOMMON_UNLIKELY(tagSize.isError())) {
+        return tagSize;
+    }
+    size_t used = tagSize.value();
+
+    if (LIBCOMMON_UNLIKELY((tag & 1) != 0)) {
+        E error{};
+        if (LIBCOMMON_UNLIKELY(!detail::wireToInteger(tag >> 1, error))) {
+            return Result<size_t>::error(ErrorCode::INVALID_DATA);
+        }
+        // Where 0 means "no error" an error tag cannot carry it (tag 0x01)
+        if constexpr (ErrorTraits<E>::zeroIsSuccess) {
+            if (LIBCOMMON_UNLIKELY(error == E{})) {
+                return Result<size_t>::error(ErrorCode::INVALID_DATA);
+            }
+        }
+        result = Result<T, E>(detail::failureOf(error, ErrorLocation::current()));
+        return Result<size_t>::ok(used);
+    }
+
+    if constexpr (std::is_void_v<T>) {
+        if (LIBCOMMON_UNLIKELY(tag != 0)) {
+            return Result<size_t>::error(ErrorCode::INVALID_DATA);
+        }
+        result = Result<T, E>::ok();
+    } else if constexpr (detail::isWireTagged<T>()) {
+        T value{};
+        if (LIBCOMMON_UNLIKELY(!detail::wireToInteger(tag >> 1, value))) {
+            return Result<size_t>::error(ErrorCode::INVALID_DATA);
+        }
+        result = Result<T, E>::ok(value);
+    } else {
+        if (LIBCOMMON_UNLIKELY(tag != 0)) {
+            return Result<size_t>::error(ErrorCode::INVALID_DATA);
+        }
+        T value{};
+        if constexpr (detail::isWireInteger<T>()) {
+            uint64_t wire = 0;
+            auto valueSize = detail::wireGetVarint(in + used, size - used, wire);
+            if (LIBCOMMON_UNLIKELY(valueSize.isError())) {
+                return valueSize;
+            }
+            if (LIBCOMMON_UNLIKELY(!detail::wireToInteger(wire, value))) {
+                return Result<size_t>::error(ErrorCode::INVALID_DATA);
+            }
+            used += valueSize.value();
+        } else {
+            using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+            if (LIBCOMMON_UNLIKELY(size - used < sizeof(Bits))) {
+                return Result<size_t>::error(ErrorCode::BUFFER_UNDERFLOW);
+            }
+            Bits bits = 0;
+            for (size_t i = 0; i < sizeof(Bits); ++i) {
+                bits |= static_cast<Bits>(in[used + i]) << (8 * i);
+            }
+            std::memcpy(&value, &bits, sizeof(bits));
+            used += sizeof(Bits);
+        }
+        result = Result<T, E>::ok(value);
+    }
+    return Result<size_t>::ok(used);
+}
+
+/**
+ * @brief Encode count Results back to back
+ * @return Bytes written, or BUFFER_OVERFLOW (the Results that fit are
+ *         written, the rest are not)
+ */
+template<typename T, typename E>
+Result<size_t> encodeResults(const Result<T, E>* results, size_t count, uint8_t* out, size_t capacity) noexcept {
+    size_t used = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto size = encodeResult(results[i], out + used, capacity - used);
+        if (LIBCOMMON_UNLIKELY(size.isError())) {
+            return size;
+        }
+        used += size.value();
+    }
+    return Result<size_t>::ok(used);
+}
+
+/**
+ * @brief Encode an array of Results back to back
+ */
+template<typename T, typename E, size_t N>
+Result<size_t> encodeResults(const std::array<Result<T, E>, N>& results, uint8_t* out, size_t capacity) noexcept {
+    return encodeResults(results.data(), N, out, capacity);
+}
+
+/**
+ * @brief Decode count Results written by encodeResults()
+ * @return Bytes consumed, or the first decoding error (Results before it
+ *         are decoded, the rest unchanged)
+ */
+template<typename T, typename E>
+Result<size_t> decodeResults(const uint8_t* in, size_t size, Result<T, E>* results, size_t count) noexcept {
+    size_t used = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto consumed = decodeResult(in + used, size - used, results[i]);
+        if (LIBCOMMON_UNLIKELY(consumed.isError())) {
+            return consumed;
+        }
+        used += consumed.value();
+    }
+    return Result<size_t>::ok(used);
+}
+
+/**
+ * @brief Decode an array of Results written by encodeResults()
+ */
+template<typename T, typename E, size_t N>
+Result<size_t> decodeResults(const uint8_t* in, size_t size, std::array<Result<T, E>, N>& results) noexcept {
+    return decodeResults(in, size, results.data(), N);
+}
+
+} // namespace common
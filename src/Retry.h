@@ -0,0 +1,229 @@
+/**
+ * @file Retry.h
+ * @brief Retry a Result-returning operation with backoff, jitter and deadline
+ *
+ * retry() calls a callable returning Result<T> until it succeeds, fails
+ * with an error that is not worth retrying (isRetryable(), or the
+ * policy's own predicate), runs out of attempts, or would overrun the
+ * deadline. Between attempts it sleeps with exponential backoff, reduced
+ * by a random jitter so that devices sharing a bus do not retry in step.
+ * It returns the last Result; RetryStats tell how it went.
+ *
+ * No allocation: the callable is invoked in place, and time comes from a
+ * RetryTimer (two function pointers), which tests replace with a fake.
+ *
+ * @code
+ * RetryPolicy policy;
+ * policy.maxAttempts = 4;
+ * policy.initialDelayMs = 5;
+ * policy.deadlineMs = 200;
+ *
+ * RetryStats stats;
+ * auto reading = retry([&] { return modbus.readHolding(0x10); }, policy, &stats);
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "ErrorCodes.h"
+#include "Result.h"
+
+#if defined(ESP_PLATFORM)
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace common {
+
+/**
+ * @brief When to retry and how long to wait
+ */
+struct RetryPolicy {
+    uint16_t maxAttempts = 3;        ///< Attempts in total, including the first
+    uint32_t initialDelayMs = 10;    ///< Wait before the second attempt
+    uint32_t maxDelayMs = 1000;      ///< Upper bound of a single wait, the first included
+    uint8_t backoffFactor = 2;       ///< Each wait is this many times the previous one
+    uint8_t jitterPercent = 25;      ///< Each wait is shortened by a random 0..jitterPercent %
+    uint32_t deadlineMs = 0;         ///< Total time budget; 0 for none
+    bool (*shouldRetry)(ErrorCode error) = nullptr;  ///< nullptr: isRetryable()
+};
+
+/**
+ * @brief Why retry() stopped
+ */
+enum class RetryStop : uint8_t {
+    SUCCEEDED,           ///< An attempt succeeded
+    NOT_RETRYABLE,       ///< The error is not worth retrying
+    ATTEMPTS_EXHAUSTED,  ///< maxAttempts reached
+    DEADLINE,            ///< The next wait would overrun the deadline
+};
+
+/**
+ * @brief What retry() did
+ */
+struct RetryStats {
+    uint16_t attempts = 0;     ///< Calls of the operation
+    uint32_t delayMs = 0;      ///< Total time spent waiting
+    uint32_t elapsedMs = 0;    ///< Total time, from the first call to the return
+    RetryStop stop = RetryStop::SUCCEEDED;
+};
+
+/**
+ * @brief Time source for retry(): a millisecond clock and a sleep
+ */
+struct RetryTimer {
+    uint32_t (*now)(void* context) noexcept;
+    void (*sleep)(uint32_t ms, void* context) noexcept;
+    void* context;
+};
+
+namespace detail {
+
+inline uint32_t defaultRetryNow(void*) noexcept {
+#if defined(ESP_PLATFORM)
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+#else
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline void defaultRetrySleep(uint32_t ms, void*) noexcept {
+#if defined(ESP_PLATFORM)
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+inline RetryTimer retryTimer{&defaultRetryNow, &defaultRetrySleep, nullptr};
+
+/**
+ * @brief Shorten delay by a random 0..jitterPercent % (xorshift32 state)
+ */
+inline uint32_t jitterDelay(uint32_t delay, uint8_t jitterPercent, uint32_t& random) noexcept {
+    if (jitterPercent == 0 || delay == 0) {
+        return delay;
+    }
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    const uint64_t span = static_cast<uint64_t>(delay) * (jitterPercent > 100 ? 100 : jitterPercent) / 100;
+    return delay - static_cast<uint32_t>(span * (random % 1024) / 1023);
+}
+
+template<typename R>
+struct IsErrorCodeResult : std::false_type {};
+
+template<typename T>
+struct IsErrorCodeResult<Result<T, ErrorCode>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Install the timer used by retry() without an explicit timer
+ * @note Not synchronized: install it during startup
+ */
+inline void setRetryTimer(const RetryTimer& timer) noexcept {
+    detail::retryTimer = timer;
+}
+
+/**
+ * @brief Get the timer currently used by retry()
+ */
+inline RetryTimer getRetryTimer() noexcept {
+    return detail::retryTimer;
+}
+
+/**
+ * @brief Restore the default timer (esp_timer + vTaskDelay, or
+ *        steady_clock + sleep_for on native builds)
+ */
+inline void resetRetryTimer() noexcept {
+    detail::retryTimer = RetryTimer{&detail::defaultRetryNow, &detail::defaultRetrySleep, nullptr};
+}
+
+/**
+ * @brief Call fn until it succeeds or the policy says stop
+ *
+ * The clock is only read when a deadline or stats are requested, or after
+ * a failure, so an operation that succeeds at once costs one call.
+ *
+ * @param fn Callable returning Result<T> (ErrorCode errors)
+ * @param policy Attempts, backoff, jitter and deadline
+ * @param timer Clock and sleep to use
+ * @param stats Optional; receives attempt statistics
+ * @return The Result of the last attempt
+ */
+template<typename F>
+auto retry(F&& fn, const RetryPolicy& policy, const RetryTimer& timer, RetryStats* stats = nullptr)
+    -> std::invoke_result_t<F&> {
+    using ResultType = std::invoke_result_t<F&>;
+    static_assert(detail::IsErrorCodeResult<ResultType>::value, "retry() needs a callable returning Result<T>");
+
+    const bool timed = policy.deadlineMs != 0 || stats != nullptr;
+    const uint32_t start = timed ? timer.now(timer.context) : 0;
+    uint32_t delay = policy.initialDelayMs < policy.maxDelayMs ? policy.initialDelayMs : policy.maxDelayMs;
+    uint32_t delayed = 0;
+    uint32_t random = 0;
+    uint16_t attempts = 0;
+
+    for (;;) {
+        ++attempts;
+        ResultType result = fn();
+
+        RetryStop stop = RetryStop::SUCCEEDED;
+        uint32_t now = 0;
+        if (LIBCOMMON_UNLIKELY(result.isError())) {
+            const ErrorCode error = result.error();
+            now = timer.now(timer.context);
+            if (!(policy.shouldRetry != nullptr ? policy.shouldRetry(error) : isRetryable(error))) {
+                stop = RetryStop::NOT_RETRYABLE;
+            } else if (attempts >= policy.maxAttempts) {
+                stop = RetryStop::ATTEMPTS_EXHAUSTED;
+            } else {
+                if (random == 0) {
+                    random = (now * 2654435761u) | 1u;  // Seed the jitter on the first retry
+                }
+                const uint32_t wait = detail::jitterDelay(delay, policy.jitterPercent, random);
+                if (policy.deadlineMs != 0 && now - start + wait >= policy.deadlineMs) {
+                    stop = RetryStop::DEADLINE;
+                } else {
+                    timer.sleep(wait, timer.context);
+                    delayed += wait;
+                    const uint64_t next = static_cast<uint64_t>(delay) * policy.backoffFactor;
+                    delay = next < policy.maxDelayMs ? static_cast<uint32_t>(next) : policy.maxDelayMs;
+                    continue;
+                }
+            }
+        }
+
+        if (stats != nullptr) {
+            stats->attempts = attempts;
+            stats->delayMs = delayed;
+            stats->elapsedMs = (stop == RetryStop::SUCCEEDED ? timer.now(timer.context) : now) - start;
+            stats->stop = stop;
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Call fn until it succeeds or the policy says stop, using the
+ *        installed timer (see setRetryTimer())
+ */
+template<typename F>
+auto retry(F&& fn, const RetryPolicy& policy = RetryPolicy(), RetryStats* stats = nullptr)
+    -> std::invoke_result_t<F&> {
+    return retry(std::forward<F>(fn), policy, detail::retryTimer, stats);
+}
+
+} // namespace common
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Code-size accounting for Result on the native toolchain.
+
+Compiles the size fixtures in this directory to object files at -Os (as
+firmware is built) and reports the .text and .rodata bytes that each
+Result<T, E> instantiation and each propagation macro expansion adds:
+
+  codegen_size_instantiation.cpp
+         Compiled once with nothing instantiated and once per entry of
+         INSTANTIATIONS; the difference is the cost of that pair. "fns" is
+         the number of functions nm lists that the baseline does not have.
+  codegen_size_macros.cpp
+         Compiled with 3 and 9 expansions of each step in MACROS; the
+         difference divided by 6 is the cost of one expansion, shown next
+         to the equivalent hand-written step.
+
+Each measurement runs in three configurations: the default build, with
+LIBCOMMON_ERROR_STATS and LIBCOMMON_ERROR_TRACE ("instrumented"), and
+instrumented with LIBCOMMON_SHARED_ERROR_PATH ("shared"), which moves the
+per-error bookkeeping into one out-of-line function. The check fails if
+any measurement exceeds its BUDGETS entry or if the shared configuration
+makes the macro expansions larger in total. With GCC 12 the two tie: the
+error branches are cold, so the instrumented build already calls the
+bookkeeping out of line. The instantiation totals of the two are printed
+for comparison only: each driver has a single error exit, where a call
+costs about as much as the inline counter update it replaces on x86-64.
+
+Usage: python3 test/codegen/check_code_size.py [-v]
+       (-v lists the symbols each instantiation adds; honours $CXX,
+       default g++, $CODEGEN_EXTRA, extra compiler flags, $SIZE, default
+       size, and $NM, default nm)
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CXX = os.environ.get("CXX", "g++")
+SIZE = os.environ.get("SIZE", "size")
+NM = os.environ.get("NM", "nm")
+CXXFLAGS = ["-std=c++17", "-Os", "-c", "-ffunction-sections", "-fdata-sections",
+            "-fno-asynchronous-unwind-tables", "-fno-exceptions", "-fno-rtti"] + \
+           os.environ.get("CODEGEN_EXTRA", "").split()
+
+INSTRUMENTED = ["-DLIBCOMMON_ERROR_STATS=1", "-DLIBCOMMON_ERROR_TRACE=1"]
+CONFIGS = [
+    ("default", []),
+    ("instrumented", INSTRUMENTED),
+    ("shared", INSTRUMENTED + ["-DLIBCOMMON_SHARED_ERROR_PATH=1"]),
+]
+
+# (label, value type, error type)
+INSTANTIATIONS = [
+    ("void", "void", "common::ErrorCode"),
+    ("bool", "bool", "common::ErrorCode"),
+    ("uint8_t", "uint8_t", "common::ErrorCode"),
+    ("uint16_t", "uint16_t", "common::ErrorCode"),
+    ("int32_t", "int32_t", "common::ErrorCode"),
+    ("float", "float", "common::ErrorCode"),
+    ("double", "double", "common::ErrorCode"),
+    ("int64_t", "int64_t", "common::ErrorCode"),
+    ("Reading", "Reading", "common::ErrorCode"),
+    ("Frame32", "Frame32", "common::ErrorCode"),
+    ("unique_ptr", "std::unique_ptr<int32_t>", "common::ErrorCode"),
+    ("void/SensorError", "void", "SensorError"),
+    ("uint16_t/SensorError", "uint16_t", "SensorError"),
+    ("float/SensorError", "float", "SensorError"),
+    ("uint16_t/PlainError", "uint16_t", "PlainError"),
+]
+
+# (macro step, hand-written equivalent)
+MACROS = [
+    ("RETURN_IF_ERROR", "HAND_CHECK"),
+    ("ASSIGN_OR_RETURN", "HAND_ASSIGN"),
+    ("RESULT_TRY", "HAND_ASSIGN"),
+    ("RETURN_ERROR_IF", "HAND_ERROR_IF"),
+]
+
+# Upper bounds in bytes (.text + .rodata), per configuration
+BUDGETS = {
+    "default": {"instantiation": 288, "expansion": 40},
+    "instrumented": {"instantiation": 320, "expansion": 136},
+    "shared": {"instantiation": 320, "expansion": 60},
+}
+
+
+def compile_object(source, defines, obj):
+    subprocess.run([CXX] + CXXFLAGS + defines + ["-o", obj, os.path.join(HERE, source)],
+                   check=True, capture_output=True, text=True)
+
+
+def section_sizes(obj):
+    """(text, rodata) bytes of obj, from size -A."""
+    out = subprocess.run([SIZE, "-A", obj], check=True, capture_output=True, text=True).stdout
+    text = rodata = 0
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) < 2 or not fields[1].isdigit():
+            continue
+        if fields[0].startswith(".text"):
+            text += int(fields[1])
+        elif fields[0].startswith(".rodata"):
+            rodata += int(fields[1])
+    return text, rodata
+
+
+def functions(obj):
+    """Map demangled function name -> size, from nm."""
+    out = subprocess.run([NM, "-S", "-C", "--defined-only", obj],
+                         check=True, capture_output=True, text=True).stdout
+    result = {}
+    for line in out.splitlines():
+        fields = line.split(maxsplit=3)
+        if len(fields) == 4 and fields[2] in "tTwW":
+            result[fields[3]] = int(fields[1], 16)
+    return result
+
+
+def measure(source, defines):
+    with tempfile.TemporaryDirectory() as tmp:
+        obj = os.path.join(tmp, "fixture.o")
+        compile_object(source, defines, obj)
+        return section_sizes(obj), functions(obj)
+
+
+def check_instantiations(config, flags, verbose):
+    (base_text, base_rodata), base_fns = measure("codegen_size_instantiation.cpp", flags)
+    budget = BUDGETS[config]["instantiation"]
+    failures = total = 0
+    for label, value, error in INSTANTIATIONS:
+        (text, rodata), fns = measure("codegen_size_instantiation.cpp",
+                                      flags + [f"-DSIZE_T={value}", f"-DSIZE_E={error}"])
+        text, rodata = text - base_text, rodata - base_rodata
+        added = {name: size for name, size in fns.items() if name not in base_fns}
+        over = text + rodata > budget
+        print(f"{'FAIL' if over else 'ok':4} {config:12} Result<{label}>: "
+              f"text {text}, rodata {rodata}, fns {len(added)}")
+        if verbose:
+            for name, size in sorted(added.items(), key=lambda item: -item[1]):
+                print(f"       {size:6} {name}")
+        failures += over
+        total += text + rodata
+    return failures, total
+
+
+def check_macros(config, flags):
+    budget = BUDGETS[config]["expansion"]
+
+    def per_expansion(step):
+        sizes = [sum(measure("codegen_size_macros.cpp",
+                             flags + [f"-DSIZE_STEP_{step}", f"-DSIZE_EXPANSIONS={n}"])[0])
+                 for n in (3, 9)]
+        return (sizes[1] - sizes[0]) / 6
+
+    failures = 0
+    total = 0.0
+    for macro, hand in MACROS:
+        ours, theirs = per_expansion(macro), per_expansion(hand)
+        over = ours > budget
+        print(f"{'FAIL' if over else 'ok':4} {config:12} {macro}: {ours:.1f} bytes per expansion "
+              f"({theirs:.1f} hand-written)")
+        failures += over
+        total += ours
+    return failures, total
+
+
+def main():
+    if os.uname().machine not in ("x86_64", "amd64"):
+        print("code size budgets are for x86-64 only; skipping")
+        return 0
+
+    verbose = "-v" in sys.argv[1:]
+    failures = 0
+    totals = {}
+    for config, flags in CONFIGS:
+        instantiation_failures, instantiation_total = check_instantiations(config, flags, verbose)
+        macro_failures, macro_total = check_macros(config, flags)
+        failures += instantiation_failures + macro_failures
+        totals[config] = (instantiation_total, macro_total)
+
+    for index, kind in enumerate(("instantiations", "macro expansions")):
+        instrumented, shared = totals["instrumented"][index], totals["shared"][index]
+        enforced = kind == "macro expansions"
+        worse = enforced and shared > instrumented
+        saving = 100.0 * (instrumented - shared) / instrumented if instrumented else 0.0
+        status = ("FAIL" if worse else "ok") if enforced else "info"
+        print(f"{status:4} shared error path, {kind}: {shared:.0f} vs {instrumented:.0f} bytes "
+              f"instrumented ({saving:.0f}% smaller); default build {totals['default'][index]:.0f}")
+        failures += worse
+
+    print(f"{failures} failure(s)")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
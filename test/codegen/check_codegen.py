@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Codegen checks for LibraryCommon on the native (x86-64) toolchain.
+
+Compiles each fixture in this directory to assembly with optimizations and
+verifies properties of the generated functions:
+
+  reg_*  The Result is returned in registers, i.e. the function never
+         writes through the hidden return-slot pointer (%rdi).
+  try_*  The function performs no more memory accesses than its hand_*
+         twin, i.e. the macro or helper (RESULT_TRY, ASSIGN_OR_RETURN,
+         zip, apply) adds no copy or move of the value. (Total
+         instruction counts may differ through tail duplication.)
+  hint_* The success path falls through from entry to the first ret
+         without taking a branch: error exits are forward jumps to code
+         placed after it (or in a .cold partition), i.e. the branch hints
+         (LIBCOMMON_BRANCH_HINTS) reach the optimizer.
+  load_* The function reads memory at most once (e.g. one table load).
+  nofill_* The function neither calls memset/memcpy nor runs a rep
+         string instruction, i.e. an error return with a large T writes
+         the code and flag only instead of zero-filling the value.
+
+Size fixtures are compiled to object files with and without a baseline
+define; the .text + .rodata bytes of the default build must not exceed
+the baseline (e.g. the errorCodeToString string pool vs the former
+switch).
+
+Usage: python3 test/codegen/check_codegen.py  (honours $CXX, default g++,
+       $CODEGEN_EXTRA, extra compiler flags, and $SIZE, default size)
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CXX = os.environ.get("CXX", "g++")
+CXXFLAGS = ["-std=c++17", "-O2", "-S", "-o", "-",
+            "-fno-asynchronous-unwind-tables", "-fno-exceptions"] + os.environ.get("CODEGEN_EXTRA", "").split()
+
+FIXTURES = [
+    "codegen_register_return.cpp",
+    "codegen_try.cpp",
+    "codegen_branch_hints.cpp",
+    "codegen_error_class.cpp",
+    "codegen_zip.cpp",
+    "codegen_error_storage.cpp",
+]
+
+# (fixture, define selecting the baseline implementation)
+SIZE_FIXTURES = [
+    ("codegen_error_strings.cpp", "-DERROR_STRINGS_SWITCH"),
+]
+
+
+def compile_to_asm(source):
+    cmd = [CXX] + CXXFLAGS + [os.path.join(HERE, source)]
+    return subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+
+
+def code_and_data_size(source, extra):
+    """Bytes in .text* and .rodata* sections of source compiled with extra."""
+    flags = [f for f in CXXFLAGS if f not in ("-S", "-o", "-")]
+    with tempfile.TemporaryDirectory() as tmp:
+        obj = os.path.join(tmp, "fixture.o")
+        subprocess.run([CXX] + flags + ["-c", "-ffunction-sections", "-fdata-sections",
+                                        "-o", obj, os.path.join(HERE, source)] + extra,
+                       check=True, capture_output=True, text=True)
+        sections = subprocess.run([os.environ.get("SIZE", "size"), "-A", obj],
+                                  check=True, capture_output=True, text=True).stdout
+    total = 0
+    for line in sections.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith((".text", ".rodata")) and fields[1].isdigit():
+            total += int(fields[1])
+    return total
+
+
+def split_functions(asm):
+    """Map function name -> list of instruction lines.
+
+    GCC moves code reached only through cold branches into a separate
+    "<name>.cold" partition; it is counted as part of <name>. Local labels
+    (".L<n>:") are kept so branch targets can be located.
+    """
+    functions = {}
+    current = None
+    for line in asm.splitlines():
+        label = re.match(r"^([A-Za-z_.][\w.$]*):", line)
+        if label and not label.group(1).startswith(".L"):
+            current = label.group(1)
+            if current.endswith(".cold"):
+                current = current[:-len(".cold")]
+            functions.setdefault(current, [])
+        elif current and label:
+            functions[current].append(line.strip())
+        elif current and line.startswith("\t") and not line.strip().startswith("."):
+            functions[current].append(line.strip())
+        elif line.strip().startswith(".size") and current:
+            current = None
+    return functions
+
+
+def check_register_return(name, body):
+    if any(re.search(r"\(%rdi\)", insn) for insn in body):
+        return "returns through memory (stores via %rdi)"
+    return None
+
+
+def memory_accesses(body):
+    """Instructions that copy data through memory, excluding push/pop/lea."""
+    count = 0
+    for insn in body:
+        mnemonic = insn.split()[0]
+        if mnemonic.startswith(("push", "pop", "lea")):
+            continue
+        if "(" in insn or "memcpy" in insn or "memmove" in insn or mnemonic.startswith("rep"):
+            count += 1
+    return count
+
+
+def check_no_extra_copies(name, body, functions):
+    twin = "hand_" + name[len("try_"):]
+    if twin not in functions:
+        return f"missing twin {twin}"
+    ours, theirs = memory_accesses(body), memory_accesses(functions[twin])
+    if ours > theirs:
+        return f"{ours} memory accesses vs {theirs} in {twin}"
+    return None
+
+
+def check_single_load(name, body):
+    accesses = memory_accesses(body)
+    if accesses > 1:
+        return f"{accesses} memory accesses"
+    return None
+
+
+def is_label(line):
+    return line.endswith(":")
+
+
+def check_fall_through(name, body, functions):
+    position = {line[:-1]: index for index, line in enumerate(body) if is_label(line)}
+    first_ret = next((i for i, line in enumerate(body) if line.split()[0] == "ret"), None)
+    if first_ret is None:
+        return "no ret instruction"
+    # Branching straight to the epilogue (pops before ret) is an error exit
+    epilogue = first_ret
+    while epilogue > 0 and (is_label(body[epilogue - 1]) or
+                            body[epilogue - 1].split()[0].startswith(("pop", "leave"))):
+        epilogue -= 1
+    for line in body[:first_ret]:
+        if is_label(line) or not line.startswith("j"):
+            continue
+        mnemonic, target = line.split()[0], line.split()[-1]
+        if mnemonic == "jmp":
+            return f"success path jumps ({line})"
+        if position.get(target, len(body)) < epilogue:
+            return f"success path takes a branch ({line})"
+    return None
+
+
+def check_no_fill(name, body):
+    for insn in body:
+        if insn.split()[0].startswith("rep") or re.search(r"\bmem(set|cpy|move)\b", insn):
+            return f"fills or copies the value ({insn})"
+    return None
+
+
+CHECKS = [
+    ("reg_", lambda name, body, functions: check_register_return(name, body)),
+    ("try_", check_no_extra_copies),
+    ("hint_", check_fall_through),
+    ("load_", lambda name, body, functions: check_single_load(name, body)),
+    ("nofill_", lambda name, body, functions: check_no_fill(name, body)),
+]
+
+
+def main():
+    if os.uname().machine not in ("x86_64", "amd64"):
+        print("codegen checks target x86-64 only; skipping")
+        return 0
+
+    failures = 0
+    for fixture in FIXTURES:
+        functions = split_functions(compile_to_asm(fixture))
+        for prefix, check in CHECKS:
+            for name, body in sorted(functions.items()):
+                if not name.startswith(prefix):
+                    continue
+                problem = check(name, body, functions)
+                status = "FAIL" if problem else "ok"
+                print(f"{status:4} {fixture}:{name}" + (f" - {problem}" if problem else ""))
+                failures += bool(problem)
+
+    for fixture, baseline in SIZE_FIXTURES:
+        ours, theirs = code_and_data_size(fixture, []), code_and_data_size(fixture, [baseline])
+        status = "FAIL" if ours > theirs else "ok"
+        print(f"{status:4} {fixture}: {ours} bytes (.text+.rodata) vs {theirs} with {baseline}")
+        failures += ours > theirs
+
+    print(f"{failures} failure(s)")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,45 @@
+/**
+ * @file codegen_branch_hints.cpp
+ * @brief Codegen fixture: error paths of Result checks are laid out cold
+ *
+ * Compiled to assembly by check_codegen.py. Every "hint_<name>" function
+ * must have its error exit in a separate "hint_<name>.cold" partition, so
+ * the success path is straight-line fall-through code.
+ */
+
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+extern "C" {
+
+Result<uint16_t> readRegister(uint16_t address);
+Result<void> writeRegister(uint16_t address, uint16_t value);
+void logFailure(ErrorCode error);
+
+Result<void> hint_return_if_error(uint16_t address) {
+    RETURN_IF_ERROR(writeRegister(address, 1));
+    RETURN_IF_ERROR(writeRegister(address + 1, 2));
+    return Result<void>::ok();
+}
+
+Result<uint32_t> hint_assign_or_return(uint16_t address) {
+    ASSIGN_OR_RETURN(uint16_t value, readRegister(address));
+    return Result<uint32_t>::ok(value * 3u);
+}
+
+Result<uint32_t> hint_error_if(uint32_t value) {
+    RETURN_ERROR_IF(value > 1000, ErrorCode::INVALID_PARAMETER);
+    return Result<uint32_t>::ok(value * 3u);
+}
+
+uint32_t hint_is_error(uint16_t address) {
+    auto result = readRegister(address);
+    if (result.isError()) {
+        logFailure(result.error());
+        return 0;
+    }
+    return result.value() * 3u;
+}
+
+} // extern "C"
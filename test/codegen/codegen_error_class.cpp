@@ -0,0 +1,35 @@
+/**
+ * @file codegen_error_class.cpp
+ * @brief Codegen fixture: error classification is a single table load
+ *
+ * Compiled to assembly by check_codegen.py. Every "load_<name>" function
+ * may read memory at most once.
+ */
+
+#include "../../src/ErrorCodes.h"
+
+using namespace common;
+
+extern "C" {
+
+ErrorCategory load_category(ErrorCode code) {
+    return category(code);
+}
+
+ErrorSeverity load_severity(ErrorCode code) {
+    return severity(code);
+}
+
+bool load_is_retryable(ErrorCode code) {
+    return isRetryable(code);
+}
+
+bool load_is_transient(ErrorCode code) {
+    return isTransient(code);
+}
+
+bool load_is_fatal(ErrorCode code) {
+    return isFatal(code);
+}
+
+}
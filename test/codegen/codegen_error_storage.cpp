@@ -0,0 +1,37 @@
+/**
+ * @file codegen_error_storage.cpp
+ * @brief Codegen fixture: error returns must not touch the value storage
+ *
+ * Compiled to assembly by check_codegen.py. Every function prefixed with
+ * "nofill_" returns an error Result with a large T and must not zero-fill
+ * or copy it: creating an error stores the code and the flag only.
+ */
+
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+struct Frame {
+    uint8_t data[4096];
+};
+
+} // namespace
+
+extern "C" {
+
+Result<Frame> nofill_constant_error() {
+    return Result<Frame>::error(ErrorCode::TIMEOUT);
+}
+
+Result<Frame> nofill_runtime_error(ErrorCode code) {
+    return Result<Frame>::error(code);
+}
+
+Result<Frame> nofill_failure(int fail) {
+    RETURN_ERROR_IF(fail, ErrorCode::CRC_ERROR);
+    return Result<Frame>::error(ErrorCode::DATA_NOT_READY);
+}
+
+} // extern "C"
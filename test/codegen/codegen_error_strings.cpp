@@ -0,0 +1,23 @@
+/**
+ * @file codegen_error_strings.cpp
+ * @brief Size fixture: errorCodeToString string pool vs the former switch
+ *
+ * Compiled to an object file twice by check_codegen.py, once as is and
+ * once with -DERROR_STRINGS_SWITCH; the .text and .rodata sizes of the
+ * two builds are compared.
+ */
+
+#include "../../src/ErrorCodes.h"
+#include "../error_strings_switch.h"
+
+extern "C" {
+
+const char* size_error_code_to_string(common::ErrorCode code) {
+#ifdef ERROR_STRINGS_SWITCH
+    return baseline::switchErrorCodeToString(code);
+#else
+    return common::errorCodeToString(code);
+#endif
+}
+
+}
@@ -0,0 +1,57 @@
+/**
+ * @file codegen_register_return.cpp
+ * @brief Codegen fixture: packed Results must be returned in registers
+ *
+ * Compiled to assembly by check_codegen.py. Every function prefixed with
+ * "reg_" must return its Result without a hidden return-slot pointer.
+ */
+
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+extern "C" {
+
+Result<void> reg_void_ok() {
+    return Result<void>::ok();
+}
+
+Result<void> reg_void_error(int fail) {
+    if (fail) {
+        return Result<void>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<void>::ok();
+}
+
+Result<uint16_t> reg_u16(uint16_t raw, int fail) {
+    if (fail) {
+        return Result<uint16_t>::error(ErrorCode::CRC_ERROR);
+    }
+    return Result<uint16_t>::ok(raw);
+}
+
+Result<int16_t> reg_i16(int16_t raw) {
+    return Result<int16_t>::ok(raw);
+}
+
+Result<float> reg_float(float raw, int fail) {
+    if (fail) {
+        return Result<float>::error(ErrorCode::DATA_NOT_READY);
+    }
+    return Result<float>::ok(raw);
+}
+
+// Unpacked but trivially copyable: returned in a register pair
+Result<double> reg_double(double raw, int fail) {
+    if (fail) {
+        return Result<double>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<double>::ok(raw);
+}
+
+Result<double> reg_double_propagate(Result<double> (*step)()) {
+    RETURN_IF_ERROR(step());
+    return step();
+}
+
+} // extern "C"
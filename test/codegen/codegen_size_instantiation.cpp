@@ -0,0 +1,150 @@
+/**
+ * @file codegen_size_instantiation.cpp
+ * @brief Size fixture: code emitted per Result<T, E> instantiation
+ *
+ * Compiled to an object file by check_code_size.py, once without SIZE_T
+ * and once per value/error type pair passed as -DSIZE_T=... -DSIZE_E=...;
+ * the difference in .text and .rodata is the cost of that instantiation.
+ * Every pair runs the same driver: create ok and error Results, propagate
+ * through ASSIGN_OR_RETURN (or RETURN_IF_ERROR for void), then map() and
+ * valueOr(). Both builds also run the driver for Anchor with each error
+ * type, and for AnchorPair with ErrorCode, so code shared by all
+ * instantiations (error statistics, trace rings) is in the baseline and
+ * compiled as it is with several callers; only the per-instantiation part
+ * is counted.
+ */
+
+#include <array>
+#include <memory>
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+/// Error enum reserving 0 for success, like most driver libraries
+enum class SensorError : uint8_t {
+    NONE = 0,
+    TIMEOUT,
+    CRC_MISMATCH,
+};
+
+template<>
+struct common::ErrorTraits<SensorError> {
+    static constexpr bool zeroIsSuccess = true;
+};
+
+/// Error enum without ErrorTraits (separate flag byte)
+enum class PlainError : uint8_t {
+    BUS_FAULT,
+    NOT_READY,
+};
+
+struct Reading {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
+using Frame32 = std::array<uint8_t, 32>;
+
+struct Anchor {
+    int32_t value;
+};
+
+// Second ErrorCode driver: with a single caller the compiler inlines
+// shared helpers such as ErrorStatistics::record() into the baseline
+struct AnchorPair {
+    int32_t value;
+};
+
+namespace {
+
+template<typename E>
+E failureFor();
+template<>
+ErrorCode failureFor<ErrorCode>() { return ErrorCode::TIMEOUT; }
+template<>
+SensorError failureFor<SensorError>() { return SensorError::TIMEOUT; }
+template<>
+PlainError failureFor<PlainError>() { return PlainError::NOT_READY; }
+
+template<typename T>
+T sampleOf(int32_t i) {
+    if constexpr (std::is_same_v<T, Anchor> || std::is_same_v<T, AnchorPair>) {
+        return T{i};
+    } else if constexpr (std::is_same_v<T, Reading>) {
+        return Reading{static_cast<int16_t>(i), 0, 0};
+    } else if constexpr (std::is_same_v<T, Frame32>) {
+        Frame32 frame{};
+        frame[0] = static_cast<uint8_t>(i);
+        return frame;
+    } else if constexpr (std::is_same_v<T, std::unique_ptr<int32_t>>) {
+        return std::make_unique<int32_t>(i);
+    } else {
+        return static_cast<T>(i);
+    }
+}
+
+template<typename T>
+int32_t scoreOf(const T& value) {
+    if constexpr (std::is_same_v<T, Anchor> || std::is_same_v<T, AnchorPair>) {
+        return value.value;
+    } else if constexpr (std::is_same_v<T, Reading>) {
+        return value.x;
+    } else if constexpr (std::is_same_v<T, Frame32>) {
+        return value[0];
+    } else if constexpr (std::is_same_v<T, std::unique_ptr<int32_t>>) {
+        return *value;
+    } else {
+        return static_cast<int32_t>(value);
+    }
+}
+
+template<typename T, typename E>
+__attribute__((noinline)) Result<T, E> sizeRead(int32_t i) {
+    if (i < 0) {
+        return Result<T, E>::error(failureFor<E>());
+    }
+    if constexpr (std::is_void_v<T>) {
+        return Result<T, E>::ok();
+    } else {
+        return Result<T, E>::ok(sampleOf<T>(i));
+    }
+}
+
+template<typename T, typename E>
+__attribute__((noinline)) Result<T, E> sizeForward(int32_t i) {
+    if constexpr (std::is_void_v<T>) {
+        RETURN_IF_ERROR((sizeRead<T, E>(i)));
+        return Result<T, E>::ok();
+    } else {
+        ASSIGN_OR_RETURN(T value, (sizeRead<T, E>(i)));
+        return Result<T, E>::ok(std::move(value));
+    }
+}
+
+template<typename T, typename E>
+int32_t sizeConsume(int32_t i) {
+    auto result = sizeForward<T, E>(i);
+    if (result.isError()) {
+        return -static_cast<int32_t>(result.error());
+    }
+    if constexpr (std::is_void_v<T>) {
+        return 0;
+    } else {
+        return std::move(result).map([](T&& value) { return scoreOf(value); }).valueOr(0);
+    }
+}
+
+} // namespace
+
+extern "C" int32_t size_anchor(int32_t i) {
+    return sizeConsume<Anchor, ErrorCode>(i) + sizeConsume<Anchor, SensorError>(i) +
+           sizeConsume<Anchor, PlainError>(i) + sizeConsume<AnchorPair, ErrorCode>(i);
+}
+
+#ifdef SIZE_T
+extern "C" int32_t size_entry(int32_t i) {
+    return sizeConsume<SIZE_T, SIZE_E>(i);
+}
+
+#endif // SIZE_T
@@ -0,0 +1,55 @@
+/**
+ * @file codegen_size_macros.cpp
+ * @brief Size fixture: code emitted per propagation macro expansion
+ *
+ * Compiled to an object file by check_code_size.py with one SIZE_STEP_*
+ * define selecting the step and SIZE_EXPANSIONS set to 3 and then 9; the
+ * difference in .text and .rodata divided by 6 is the cost of one
+ * expansion. Starting from 3 rather than 1 keeps code the compiler only
+ * moves out of line once a function has several error exits (such as the
+ * error counter) out of the per-expansion figure. The HAND_* steps are the
+ * equivalent hand-written code.
+ */
+
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+Result<int32_t> sizeStep(int32_t i);
+int32_t sizeRaw(int32_t i);
+
+// Each step is its own block so the temporaries do not clash
+#if defined(SIZE_STEP_RETURN_IF_ERROR)
+#define SIZE_STEP(i) { RETURN_IF_ERROR(sizeStep(i)); }
+#elif defined(SIZE_STEP_HAND_CHECK)
+#define SIZE_STEP(i) { auto r = sizeStep(i); if (!r) { return r; } }
+#elif defined(SIZE_STEP_ASSIGN_OR_RETURN)
+#define SIZE_STEP(i) { ASSIGN_OR_RETURN(int32_t v, sizeStep(i)); sum += v; }
+#elif defined(SIZE_STEP_RESULT_TRY)
+#define SIZE_STEP(i) { sum += RESULT_TRY(sizeStep(i)); }
+#elif defined(SIZE_STEP_HAND_ASSIGN)
+#define SIZE_STEP(i) { auto r = sizeStep(i); if (!r) { return r.failure(); } sum += r.value(); }
+#elif defined(SIZE_STEP_RETURN_ERROR_IF)
+#define SIZE_STEP(i) { RETURN_ERROR_IF(sizeRaw(i) < 0, ErrorCode::INVALID_DATA); }
+#elif defined(SIZE_STEP_HAND_ERROR_IF)
+#define SIZE_STEP(i) { if (sizeRaw(i) < 0) { return Result<int32_t>::error(ErrorCode::INVALID_DATA); } }
+#else
+#error "define one SIZE_STEP_* selector"
+#endif
+
+// One step per line, so each has its own location tag when tracing
+extern "C" Result<int32_t> size_chain() {
+    [[maybe_unused]] int32_t sum = 0;
+    SIZE_STEP(1)
+    SIZE_STEP(2)
+    SIZE_STEP(3)
+#if SIZE_EXPANSIONS > 3
+    SIZE_STEP(4)
+    SIZE_STEP(5)
+    SIZE_STEP(6)
+    SIZE_STEP(7)
+    SIZE_STEP(8)
+    SIZE_STEP(9)
+#endif
+    return Result<int32_t>::ok(sum);
+}
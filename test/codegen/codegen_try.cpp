@@ -0,0 +1,73 @@
+/**
+ * @file codegen_try.cpp
+ * @brief Codegen fixture: RESULT_TRY / ASSIGN_OR_RETURN vs hand-written code
+ *
+ * Compiled to assembly by check_codegen.py. Every "try_<name>" function
+ * performs no more memory accesses than its "hand_<name>" twin, i.e. the
+ * macros add no copy or move of the value. The twins propagate the
+ * error with makeFailure() like the macros do, so only the value path is
+ * compared.
+ */
+
+#include <cstring>
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+struct Frame {
+    uint8_t data[64];
+};
+
+extern "C" {
+
+Result<uint16_t> readRegister(uint16_t address);
+Result<Frame> readFrame(uint8_t slave);
+void consume(const Frame& frame);
+
+Result<uint32_t> hand_sum(uint16_t a, uint16_t b) {
+    auto first = readRegister(a);
+    if (!first) {
+        return makeFailure(first.error());
+    }
+    auto second = readRegister(b);
+    if (!second) {
+        return makeFailure(second.error());
+    }
+    return Result<uint32_t>::ok(uint32_t(first.value()) + second.value());
+}
+
+Result<uint32_t> try_sum(uint16_t a, uint16_t b) {
+    return Result<uint32_t>::ok(uint32_t(RESULT_TRY(readRegister(a))) + RESULT_TRY(readRegister(b)));
+}
+
+Result<uint32_t> hand_assign(uint16_t a) {
+    auto result = readRegister(a);
+    if (!result) {
+        return makeFailure(result.error());
+    }
+    uint16_t value = std::move(result).value();
+    return Result<uint32_t>::ok(value * 2u);
+}
+
+Result<uint32_t> try_assign(uint16_t a) {
+    ASSIGN_OR_RETURN(uint16_t value, readRegister(a));
+    return Result<uint32_t>::ok(value * 2u);
+}
+
+Result<void> hand_frame(uint8_t slave) {
+    auto result = readFrame(slave);
+    if (!result) {
+        return makeFailure(result.error());
+    }
+    Frame frame = std::move(result).value();
+    consume(frame);
+    return Result<void>::ok();
+}
+
+Result<void> try_frame(uint8_t slave) {
+    Frame frame = RESULT_TRY(readFrame(slave));
+    consume(frame);
+    return Result<void>::ok();
+}
+
+} // extern "C"
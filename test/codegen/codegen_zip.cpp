@@ -0,0 +1,100 @@
+/**
+ * @file codegen_zip.cpp
+ * @brief Codegen fixture: zip() / apply() vs hand-written if-chains
+ *
+ * Compiled to assembly by check_codegen.py. Every "try_<name>" function
+ * must perform no more memory accesses than its "hand_<name>" twin, i.e.
+ * zip() and apply() add no copy of the values compared with checking each
+ * Result and moving its value out by hand.
+ */
+
+#include <cstring>
+#include "../../src/LibraryCommon.h"
+
+using namespace common;
+
+struct Frame {
+    uint8_t data[64];
+};
+
+using Inputs = std::tuple<uint16_t, float, int32_t>;
+
+extern "C" {
+
+Result<uint16_t> readTemperature();
+Result<float> readPressure();
+Result<int32_t> readFlow();
+Result<Frame> readFrame(uint8_t slave);
+Result<void> sendFrame(const Frame& frame, uint16_t address);
+
+Result<Inputs> hand_zip3() {
+    auto temperature = readTemperature();
+    auto pressure = readPressure();
+    auto flow = readFlow();
+    if (!temperature) {
+        return makeFailure(temperature.error());
+    }
+    if (!pressure) {
+        return makeFailure(pressure.error());
+    }
+    if (!flow) {
+        return makeFailure(flow.error());
+    }
+    return Result<Inputs>(in_place, temperature.value(), pressure.value(), flow.value());
+}
+
+Result<Inputs> try_zip3() {
+    return zip(readTemperature(), readPressure(), readFlow());
+}
+
+Result<std::tuple<Frame, uint16_t>> hand_zip_frame(uint8_t slave) {
+    auto frame = readFrame(slave);
+    auto temperature = readTemperature();
+    if (!frame) {
+        return makeFailure(frame.error());
+    }
+    if (!temperature) {
+        return makeFailure(temperature.error());
+    }
+    return Result<std::tuple<Frame, uint16_t>>(in_place, std::move(frame).value(), temperature.value());
+}
+
+Result<std::tuple<Frame, uint16_t>> try_zip_frame(uint8_t slave) {
+    return zip(readFrame(slave), readTemperature());
+}
+
+Result<float> hand_apply() {
+    auto temperature = readTemperature();
+    auto pressure = readPressure();
+    if (!temperature) {
+        return makeFailure(temperature.error());
+    }
+    if (!pressure) {
+        return makeFailure(pressure.error());
+    }
+    return Result<float>::ok(temperature.value() * pressure.value());
+}
+
+Result<float> try_apply() {
+    return apply([](uint16_t temperature, float pressure) { return temperature * pressure; },
+                 readTemperature(), readPressure());
+}
+
+Result<void> hand_apply_send(uint8_t slave) {
+    auto frame = readFrame(slave);
+    auto temperature = readTemperature();
+    if (!frame) {
+        return makeFailure(frame.error());
+    }
+    if (!temperature) {
+        return makeFailure(temperature.error());
+    }
+    return sendFrame(frame.value(), temperature.value());
+}
+
+Result<void> try_apply_send(uint8_t slave) {
+    return apply([](const Frame& frame, uint16_t address) { return sendFrame(frame, address); },
+                 readFrame(slave), readTemperature());
+}
+
+} // extern "C"
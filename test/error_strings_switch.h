@@ -0,0 +1,76 @@
+/**
+ * @file error_strings_switch.h
+ * @brief The former switch-based errorCodeToString, kept as a baseline
+ *
+ * Used by bench_error_strings.cpp and the size comparison in
+ * codegen/check_codegen.py to measure the string pool against it.
+ */
+
+#pragma once
+
+#include "../src/ErrorCodes.h"
+
+namespace baseline {
+
+inline const char* switchErrorCodeToString(common::ErrorCode code) {
+    using common::ErrorCode;
+    switch (code) {
+        case ErrorCode::OK: return "OK";
+        case ErrorCode::UNKNOWN_ERROR: return "Unknown error";
+        case ErrorCode::NOT_INITIALIZED: return "Not initialized";
+        case ErrorCode::ALREADY_INITIALIZED: return "Already initialized";
+        case ErrorCode::INVALID_PARAMETER: return "Invalid parameter";
+        case ErrorCode::INVALID_STATE: return "Invalid state";
+        case ErrorCode::NOT_SUPPORTED: return "Not supported";
+        case ErrorCode::NOT_IMPLEMENTED: return "Not implemented";
+        case ErrorCode::BUSY: return "Busy";
+        case ErrorCode::WOULD_BLOCK: return "Would block";
+        case ErrorCode::OUT_OF_MEMORY: return "Out of memory";
+        case ErrorCode::RESOURCE_EXHAUSTED: return "Resource exhausted";
+        case ErrorCode::RESOURCE_NOT_FOUND: return "Resource not found";
+        case ErrorCode::RESOURCE_LOCKED: return "Resource locked";
+        case ErrorCode::RESOURCE_UNAVAILABLE: return "Resource unavailable";
+        case ErrorCode::TIMEOUT: return "Timeout";
+        case ErrorCode::MUTEX_ERROR: return "Mutex error";
+        case ErrorCode::SEMAPHORE_ERROR: return "Semaphore error";
+        case ErrorCode::DEADLOCK_DETECTED: return "Deadlock detected";
+        case ErrorCode::QUEUE_FULL: return "Queue full";
+        case ErrorCode::QUEUE_EMPTY: return "Queue empty";
+        case ErrorCode::IO_ERROR: return "I/O error";
+        case ErrorCode::READ_ERROR: return "Read error";
+        case ErrorCode::WRITE_ERROR: return "Write error";
+        case ErrorCode::PERMISSION_DENIED: return "Permission denied";
+        case ErrorCode::DATA_NOT_READY: return "Data not ready";
+        case ErrorCode::DATA_CORRUPTED: return "Data corrupted";
+        case ErrorCode::CRC_ERROR: return "CRC error";
+        case ErrorCode::CHECKSUM_ERROR: return "Checksum error";
+        case ErrorCode::BUFFER_OVERFLOW: return "Buffer overflow";
+        case ErrorCode::BUFFER_UNDERFLOW: return "Buffer underflow";
+        case ErrorCode::INVALID_DATA: return "Invalid data";
+        case ErrorCode::DEVICE_NOT_FOUND: return "Device not found";
+        case ErrorCode::DEVICE_ERROR: return "Device error";
+        case ErrorCode::DEVICE_BUSY: return "Device busy";
+        case ErrorCode::DEVICE_DISCONNECTED: return "Device disconnected";
+        case ErrorCode::HARDWARE_FAILURE: return "Hardware failure";
+        case ErrorCode::COMMUNICATION_ERROR: return "Communication error";
+        case ErrorCode::CONNECTION_FAILED: return "Connection failed";
+        case ErrorCode::CONNECTION_LOST: return "Connection lost";
+        case ErrorCode::CONNECTION_REFUSED: return "Connection refused";
+        case ErrorCode::PROTOCOL_ERROR: return "Protocol error";
+        case ErrorCode::SEND_FAILED: return "Send failed";
+        case ErrorCode::RECEIVE_FAILED: return "Receive failed";
+        case ErrorCode::STORAGE_ERROR: return "Storage error";
+        case ErrorCode::STORAGE_FULL: return "Storage full";
+        case ErrorCode::FILE_NOT_FOUND: return "File not found";
+        case ErrorCode::FILE_EXISTS: return "File exists";
+        case ErrorCode::MOUNT_FAILED: return "Mount failed";
+        case ErrorCode::NETWORK_ERROR: return "Network error";
+        case ErrorCode::NETWORK_UNREACHABLE: return "Network unreachable";
+        case ErrorCode::HOST_UNREACHABLE: return "Host unreachable";
+        case ErrorCode::DNS_FAILED: return "DNS failed";
+        case ErrorCode::SSL_ERROR: return "SSL error";
+        default: return "Unknown error code";
+    }
+}
+
+} // namespace baseline
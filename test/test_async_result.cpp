@@ -0,0 +1,296 @@
+/**
+ * @file test_async_result.cpp
+ * @brief Unit tests for AsyncSlot / Promise / AsyncResult (AsyncResult.h)
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../src/LibraryCommon.h"
+#include "../src/AsyncResult.h"
+
+using namespace common;
+
+namespace {
+
+AsyncSlot<uint16_t> g_pressure;
+
+struct Counted {
+    static int alive;
+    uint16_t value;
+
+    explicit Counted(uint16_t v) : value(v) { ++alive; }
+    Counted(Counted&& other) noexcept : value(other.value) { ++alive; }
+    ~Counted() { --alive; }
+};
+
+int Counted::alive = 0;
+
+struct BackendCalls {
+    std::atomic<int> waits{0};
+    std::atomic<int> wakes{0};
+};
+
+BackendCalls g_calls;
+AsyncWaitBackend g_defaultBackend = getAsyncWaitBackend();
+
+// Counts calls, then forwards to the default backend
+AsyncWaitBackend countingBackend() {
+    return AsyncWaitBackend{
+        [](AsyncSignal& signal, uint32_t expected, uint32_t timeoutMs, void* context) noexcept {
+            ++g_calls.waits;
+            auto* inner = static_cast<const AsyncWaitBackend*>(context);
+            inner->wait(signal, expected, timeoutMs, inner->context);
+        },
+        [](AsyncSignal& signal, void* context) noexcept {
+            ++g_calls.wakes;
+            auto* inner = static_cast<const AsyncWaitBackend*>(context);
+            inner->wake(signal, inner->context);
+        },
+        &g_defaultBackend};
+}
+
+struct Delivery {
+    int calls = 0;
+    uint16_t value = 0;
+    std::thread::id thread;
+};
+
+void deliver(Result<uint16_t>&& result, void* context) {
+    auto* delivery = static_cast<Delivery*>(context);
+    ++delivery->calls;
+    delivery->value = result.valueOr(0);
+    delivery->thread = std::this_thread::get_id();
+}
+
+} // namespace
+
+void test_async_handoff_in_one_task() {
+    g_pressure.reset();
+    auto promise = g_pressure.promise();
+    auto pending = g_pressure.result();
+
+    TEST_ASSERT_FALSE(pending.isReady());
+    TEST_ASSERT_TRUE(promise.isPending());
+    TEST_ASSERT_TRUE(promise.setValue(0x1234));
+    TEST_ASSERT_FALSE(promise.isPending());
+    TEST_ASSERT_TRUE(pending.isReady());
+
+    // A Promise completes once, an AsyncResult is taken once
+    TEST_ASSERT_FALSE(promise.setValue(0x4321));
+    auto value = pending.tryGet();
+    TEST_ASSERT_TRUE(value.isOk());
+    TEST_ASSERT_EQUAL_UINT16(0x1234, value.value());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_STATE, pending.tryGet().error());
+}
+
+void test_async_not_ready_yet() {
+    g_pressure.reset();
+    auto promise = g_pressure.promise();
+    auto pending = g_pressure.result();
+
+    TEST_ASSERT_EQUAL(ErrorCode::WOULD_BLOCK, pending.tryGet().error());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, pending.wait(0).error());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, pending.wait(5).error());
+
+    // Still usable after a timeout
+    promise.complete(Result<uint16_t>::ok(7));
+    TEST_ASSERT_EQUAL_UINT16(7, pending.wait(0).value());
+}
+
+void test_async_errors_and_void() {
+    AsyncSlot<uint16_t> reading;
+    auto promise = reading.promise();
+    auto pending = reading.result();
+    promise.setError(ErrorCode::CRC_ERROR);
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, pending.tryGet().error());
+
+    AsyncSlot<void> written;
+    auto done = written.promise();
+    auto acknowledged = written.result();
+    TEST_ASSERT_TRUE(done.setValue());
+    TEST_ASSERT_TRUE(acknowledged.tryGet().isOk());
+
+    written.reset();
+    auto failed = written.promise();
+    auto rejected = written.result();
+    failed.complete(Result<void>::error(ErrorCode::SEND_FAILED));
+    TEST_ASSERT_EQUAL(ErrorCode::SEND_FAILED, rejected.wait(0).error());
+}
+
+void test_async_wait_across_threads() {
+    g_pressure.reset();
+    auto pending = g_pressure.result();
+
+    std::thread bus([promise = g_pressure.promise()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        promise.setValue(0xBEEF);
+    });
+    auto value = pending.wait();
+    bus.join();
+    TEST_ASSERT_TRUE(value.isOk());
+    TEST_ASSERT_EQUAL_UINT16(0xBEEF, value.value());
+}
+
+void test_async_timed_wait_then_late_result() {
+    g_pressure.reset();
+    auto pending = g_pressure.result();
+    auto promise = g_pressure.promise();
+
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, pending.wait(20).error());
+    const auto waited = std::chrono::steady_clock::now() - start;
+    TEST_ASSERT_GREATER_OR_EQUAL(20, std::chrono::duration_cast<std::chrono::milliseconds>(waited).count());
+
+    std::thread bus([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        promise.setError(ErrorCode::DEVICE_BUSY);
+    });
+    auto late = pending.wait(5000);
+    bus.join();
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_BUSY, late.error());
+}
+
+void test_async_continuation() {
+    // Registered first: runs in the producer's thread
+    g_pressure.reset();
+    Delivery early;
+    TEST_ASSERT_TRUE(g_pressure.result().then(&deliver, &early));
+    TEST_ASSERT_EQUAL(0, early.calls);
+    std::thread bus([promise = g_pressure.promise()]() mutable { promise.setValue(11); });
+    const std::thread::id busId = bus.get_id();
+    bus.join();
+    TEST_ASSERT_EQUAL(1, early.calls);
+    TEST_ASSERT_EQUAL_UINT16(11, early.value);
+    TEST_ASSERT_TRUE(early.thread == busId);
+
+    // Registered after completion: runs at once in the caller
+    g_pressure.reset();
+    Delivery late;
+    auto pending = g_pressure.result();
+    g_pressure.promise().setValue(12);
+    TEST_ASSERT_TRUE(pending.then(&deliver, &late));
+    TEST_ASSERT_EQUAL(1, late.calls);
+    TEST_ASSERT_EQUAL_UINT16(12, late.value);
+    TEST_ASSERT_TRUE(late.thread == std::this_thread::get_id());
+    TEST_ASSERT_FALSE(pending.then(&deliver, &late));
+}
+
+void test_async_wakes_only_a_waiting_consumer() {
+    g_calls.waits = 0;
+    g_calls.wakes = 0;
+    setAsyncWaitBackend(countingBackend());
+
+    // Consumer not blocked: completion is the atomic step alone
+    g_pressure.reset();
+    auto promise = g_pressure.promise();
+    auto pending = g_pressure.result();
+    promise.setValue(1);
+    TEST_ASSERT_EQUAL_UINT16(1, pending.wait(100).value());
+    TEST_ASSERT_EQUAL(0, g_calls.waits.load());
+    TEST_ASSERT_EQUAL(0, g_calls.wakes.load());
+
+    // Consumer blocked: one wake-up
+    g_pressure.reset();
+    auto blocked = g_pressure.result();
+    std::thread bus([promise = g_pressure.promise()]() mutable {
+        while (g_calls.waits.load() == 0) {
+            std::this_thread::yield();
+        }
+        promise.setValue(2);
+    });
+    auto value = blocked.wait(5000);
+    bus.join();
+    resetAsyncWaitBackend();
+    TEST_ASSERT_EQUAL_UINT16(2, value.value());
+    TEST_ASSERT_EQUAL(1, g_calls.waits.load());
+    TEST_ASSERT_EQUAL(1, g_calls.wakes.load());
+}
+
+void test_async_dropped_promise_releases_consumer() {
+    g_pressure.reset();
+    auto pending = g_pressure.result();
+
+    // Producer bails out without completing: its Promise dies in the thread
+    std::thread bus([promise = g_pressure.promise()]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+    auto broken = pending.wait(5000);
+    bus.join();
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_STATE, broken.error());
+
+    // Overwriting a pending Promise breaks it too
+    AsyncSlot<uint16_t> next;
+    g_pressure.reset();
+    auto promise = g_pressure.promise();
+    auto overwritten = g_pressure.result();
+    promise = next.promise();
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_STATE, overwritten.wait(0).error());
+    TEST_ASSERT_TRUE(promise.setValue(3));
+    TEST_ASSERT_EQUAL_UINT16(3, next.result().wait(0).value());
+}
+
+void test_async_slot_destroys_value() {
+    Counted::alive = 0;
+    {
+        AsyncSlot<Counted> slot;
+        slot.promise().setValue(uint16_t{5});
+        TEST_ASSERT_EQUAL(1, Counted::alive);
+
+        // Taking moves the value out; the slot keeps the moved-from one
+        auto pending = slot.result();
+        {
+            auto taken = pending.tryGet();
+            TEST_ASSERT_EQUAL_UINT16(5, taken.value().value);
+            TEST_ASSERT_EQUAL(2, Counted::alive);
+        }
+        slot.reset();
+        TEST_ASSERT_EQUAL(0, Counted::alive);
+        TEST_ASSERT_FALSE(slot.isReady());
+
+        // Never taken: the slot's destructor cleans up
+        slot.promise().setValue(uint16_t{6});
+        TEST_ASSERT_EQUAL(1, Counted::alive);
+    }
+    TEST_ASSERT_EQUAL(0, Counted::alive);
+}
+
+// Test runner
+void runAsyncResultTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_async_handoff_in_one_task);
+    RUN_TEST(test_async_not_ready_yet);
+    RUN_TEST(test_async_errors_and_void);
+    RUN_TEST(test_async_wait_across_threads);
+    RUN_TEST(test_async_timed_wait_then_late_result);
+    RUN_TEST(test_async_continuation);
+    RUN_TEST(test_async_wakes_only_a_waiting_consumer);
+    RUN_TEST(test_async_dropped_promise_releases_consumer);
+    RUN_TEST(test_async_slot_destroys_value);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Async Result Tests ===\n");
+    runAsyncResultTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runAsyncResultTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,326 @@
+/**
+ * @file test_circuit_breaker.cpp
+ * @brief Unit tests for CircuitBreaker (CircuitBreaker.h) with a fake clock
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/LibraryCommon.h"
+#include "../src/CircuitBreaker.h"
+
+using namespace common;
+
+namespace {
+
+struct FakeClock {
+    std::atomic<uint32_t> now{1000};
+
+    RetryTimer timer() {
+        return RetryTimer{
+            [](void* context) noexcept {
+                return static_cast<FakeClock*>(context)->now.load();
+            },
+            [](uint32_t ms, void* context) noexcept {
+                static_cast<FakeClock*>(context)->now += ms;
+            },
+            this};
+    }
+};
+
+struct Slave {
+    ErrorCode reply = ErrorCode::OK;
+    int calls = 0;
+
+    Result<uint16_t> readHolding() {
+        ++calls;
+        return reply == ErrorCode::OK ? Result<uint16_t>::ok(0x1234) : Result<uint16_t>::error(reply);
+    }
+};
+
+CircuitBreakerConfig smallWindow() {
+    CircuitBreakerConfig config;
+    config.windowSize = 4;
+    config.minimumCalls = 4;
+    config.failureThresholdPercent = 50;
+    config.openMs = 1000;
+    return config;
+}
+
+} // namespace
+
+void test_breaker_passes_calls_while_closed() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreaker breaker(smallWindow(), &timer);
+    Slave slave;
+
+    auto value = breaker.call([&] { return slave.readHolding(); });
+    TEST_ASSERT_TRUE(value.isOk());
+    TEST_ASSERT_EQUAL_UINT16(0x1234, value.value());
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+    TEST_ASSERT_EQUAL(1, breaker.calls());
+    TEST_ASSERT_EQUAL(0, breaker.failures());
+}
+
+void test_breaker_trips_on_failure_rate() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreaker breaker(smallWindow(), &timer);
+    Slave slave;
+    auto poll = [&] { return breaker.call([&] { return slave.readHolding(); }); };
+
+    // Below minimumCalls nothing trips, even with only failures
+    slave.reply = ErrorCode::TIMEOUT;
+    poll();
+    poll();
+    slave.reply = ErrorCode::OK;
+    poll();
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+    TEST_ASSERT_EQUAL(3, breaker.calls());
+    TEST_ASSERT_EQUAL(2, breaker.failures());
+
+    // Fourth outcome: 3 of 4 failed
+    slave.reply = ErrorCode::DEVICE_DISCONNECTED;
+    auto result = poll();
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_DISCONNECTED, result.error());
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, breaker.state());
+    TEST_ASSERT_EQUAL_UINT32(1, breaker.trips());
+
+    // Open: fail fast without touching the bus
+    const int calls = slave.calls;
+    result = poll();
+    TEST_ASSERT_EQUAL(ErrorCode::RESOURCE_UNAVAILABLE, result.error());
+    TEST_ASSERT_EQUAL(calls, slave.calls);
+}
+
+void test_breaker_window_slides() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreakerConfig config = smallWindow();
+    config.failureThresholdPercent = 75;
+    CircuitBreaker breaker(config, &timer);
+
+    // F F S S: 50 %, below 75 %
+    breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    TEST_ASSERT_EQUAL(2, breaker.failures());
+
+    // The two old failures slide out
+    breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    TEST_ASSERT_EQUAL(4, breaker.calls());
+    TEST_ASSERT_EQUAL(0, breaker.failures());
+
+    breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+    breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, breaker.state());
+}
+
+void test_breaker_ignores_caller_errors() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreaker breaker(smallWindow(), &timer);
+    Slave slave;
+
+    // The slave answers, just not with what we wanted
+    slave.reply = ErrorCode::INVALID_PARAMETER;
+    for (int i = 0; i < 10; ++i) {
+        breaker.call([&] { return slave.readHolding(); });
+    }
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+    TEST_ASSERT_EQUAL(0, breaker.failures());
+
+    // A custom predicate can count it anyway
+    CircuitBreakerConfig config = smallWindow();
+    config.isFailure = [](ErrorCode error) { return error != ErrorCode::OK; };
+    CircuitBreaker strict(config, &timer);
+    for (int i = 0; i < 4; ++i) {
+        strict.call([&] { return slave.readHolding(); });
+    }
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, strict.state());
+}
+
+void test_breaker_half_open_probe() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreaker breaker(smallWindow(), &timer);
+    for (int i = 0; i < 4; ++i) {
+        breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    }
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, breaker.state());
+
+    clock.now += 999;
+    TEST_ASSERT_EQUAL(CircuitPermit::REJECTED, breaker.acquire());
+
+    // After openMs exactly one caller gets to probe
+    clock.now += 1;
+    TEST_ASSERT_EQUAL(CircuitPermit::PROBE, breaker.acquire());
+    TEST_ASSERT_EQUAL(CircuitState::HALF_OPEN, breaker.state());
+    TEST_ASSERT_EQUAL(CircuitPermit::REJECTED, breaker.acquire());
+
+    // A call that started before the trip does not decide
+    breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    TEST_ASSERT_EQUAL(CircuitState::HALF_OPEN, breaker.state());
+
+    // Failed probe: open for another openMs
+    breaker.record(CircuitPermit::PROBE, ErrorCode::TIMEOUT);
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, breaker.state());
+    TEST_ASSERT_EQUAL_UINT32(2, breaker.trips());
+    clock.now += 500;
+    TEST_ASSERT_EQUAL(CircuitPermit::REJECTED, breaker.acquire());
+    clock.now += 500;
+
+    // Successful probe: closed with an empty window
+    Slave slave;
+    TEST_ASSERT_TRUE(breaker.call([&] { return slave.readHolding(); }).isOk());
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+    TEST_ASSERT_EQUAL(0, breaker.calls());
+    TEST_ASSERT_EQUAL(CircuitPermit::CALL, breaker.acquire());
+}
+
+void test_breaker_lost_probe_is_replaced() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreaker breaker(smallWindow(), &timer);
+    for (int i = 0; i < 4; ++i) {
+        breaker.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    }
+    clock.now += 1000;
+    TEST_ASSERT_EQUAL(CircuitPermit::PROBE, breaker.acquire());
+
+    // The probing task never reports back
+    clock.now += 999;
+    TEST_ASSERT_EQUAL(CircuitPermit::REJECTED, breaker.acquire());
+    clock.now += 1;
+    TEST_ASSERT_EQUAL(CircuitPermit::PROBE, breaker.acquire());
+
+    breaker.record(CircuitPermit::PROBE, ErrorCode::OK);
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+
+    // The first probe's late report changes nothing
+    breaker.record(CircuitPermit::PROBE, ErrorCode::TIMEOUT);
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, breaker.state());
+}
+
+void test_breaker_config_clamped_and_reset() {
+    CircuitBreakerConfig config;
+    config.windowSize = 40;
+    config.minimumCalls = 0;
+    CircuitBreaker breaker(config);
+    TEST_ASSERT_EQUAL(CircuitBreaker::kMaxWindow, breaker.config().windowSize);
+    TEST_ASSERT_EQUAL(1, breaker.config().minimumCalls);
+
+    config.windowSize = 0;
+    config.minimumCalls = 9;
+    CircuitBreaker tiny(config);
+    TEST_ASSERT_EQUAL(1, tiny.config().windowSize);
+    TEST_ASSERT_EQUAL(1, tiny.config().minimumCalls);
+
+    // Full 24-outcome window
+    for (int i = 0; i < 30; ++i) {
+        breaker.record(CircuitPermit::CALL, ErrorCode::OK);
+    }
+    TEST_ASSERT_EQUAL(24, breaker.calls());
+
+    tiny.record(CircuitPermit::CALL, ErrorCode::TIMEOUT);
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, tiny.state());
+    tiny.reset();
+    TEST_ASSERT_EQUAL(CircuitState::CLOSED, tiny.state());
+    TEST_ASSERT_EQUAL_UINT32(0, tiny.trips());
+}
+
+void test_breaker_shared_between_tasks() {
+    FakeClock clock;
+    const RetryTimer timer = clock.timer();
+    CircuitBreakerConfig config;
+    config.windowSize = 16;
+    config.minimumCalls = 16;
+    config.openMs = 10;
+    CircuitBreaker breaker(config, &timer);
+
+    constexpr int kThreads = 4;
+    std::atomic<int> probes{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+
+    // Every call fails: the breaker trips, and each time it half-opens
+    // only one thread may get the probe
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            while (!stop.load()) {
+                const CircuitPermit permit = breaker.acquire();
+                if (permit == CircuitPermit::PROBE) {
+                    ++probes;
+                }
+                breaker.record(permit, ErrorCode::TIMEOUT);
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (breaker.trips() == 0) {
+        std::this_thread::yield();
+    }
+    constexpr int kPeriods = 20;
+    for (int period = 0; period < kPeriods; ++period) {
+        const int before = probes.load();
+        clock.now += config.openMs;
+        for (int spin = 0; spin < 10000 && probes.load() == before; ++spin) {
+            std::this_thread::yield();
+        }
+    }
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // At most one probe per openMs; each failed probe reopened the breaker
+    TEST_ASSERT_GREATER_OR_EQUAL(1, probes.load());
+    TEST_ASSERT_LESS_OR_EQUAL(kPeriods, probes.load());
+    TEST_ASSERT_GREATER_OR_EQUAL(2, breaker.trips());
+    TEST_ASSERT_LESS_OR_EQUAL(static_cast<uint32_t>(probes.load()) + 1, breaker.trips());
+    TEST_ASSERT_EQUAL(CircuitState::OPEN, breaker.state());
+}
+
+// Test runner
+void runCircuitBreakerTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_breaker_passes_calls_while_closed);
+    RUN_TEST(test_breaker_trips_on_failure_rate);
+    RUN_TEST(test_breaker_window_slides);
+    RUN_TEST(test_breaker_ignores_caller_errors);
+    RUN_TEST(test_breaker_half_open_probe);
+    RUN_TEST(test_breaker_lost_probe_is_replaced);
+    RUN_TEST(test_breaker_config_clamped_and_reset);
+    RUN_TEST(test_breaker_shared_between_tasks);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Circuit Breaker Tests ===\n");
+    runCircuitBreakerTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runCircuitBreakerTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
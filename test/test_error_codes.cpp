@@ -10,6 +10,31 @@
 
 using namespace common;
 
+#if LIBCOMMON_HAS_ENUMERATOR_CHECK
+namespace {
+
+// Cross-check of kErrorCodeInfo against the enum: every enumerator in
+// 0-499 must be in the table. Kept out of ErrorCodes.h because it
+// instantiates isEnumerator() once per value.
+template<int... Values>
+constexpr bool everyEnumeratorClassified(std::integer_sequence<int, Values...>) noexcept {
+    return ((!detail::isEnumerator<ErrorCode, static_cast<ErrorCode>(Values)>() ||
+             errorCodeIndex(static_cast<ErrorCode>(Values)) != kErrorCodeCount) && ...);
+}
+
+template<int... Values>
+constexpr size_t enumeratorCount(std::integer_sequence<int, Values...>) noexcept {
+    return (static_cast<size_t>(detail::isEnumerator<ErrorCode, static_cast<ErrorCode>(Values)>()) + ...);
+}
+
+} // namespace
+
+static_assert(everyEnumeratorClassified(std::make_integer_sequence<int, 500>()),
+              "an ErrorCode enumerator is missing from kErrorCodeInfo");
+static_assert(enumeratorCount(std::make_integer_sequence<int, 500>()) == kErrorCodeCount,
+              "kErrorCodeInfo and the ErrorCode enum list different values");
+#endif
+
 void test_error_code_success_check() {
     TEST_ASSERT_TRUE(isSuccess(ErrorCode::OK));
     TEST_ASSERT_TRUE(isSuccess(ErrorCode::SUCCESS));
@@ -72,6 +97,155 @@ void test_error_code_unknown() {
     TEST_ASSERT_EQUAL_STRING("Unknown error code", errorCodeToString(unknown));
 }
 
+void test_error_code_index() {
+    // Dense indices in ascending code order; SUCCESS aliases OK
+    TEST_ASSERT_EQUAL(0, errorCodeIndex(ErrorCode::SUCCESS));
+    static_assert(errorCodeIndex(kAllErrorCodes[0]) == 0, "first code has index 0");
+    for (size_t i = 0; i < kErrorCodeCount; ++i) {
+        TEST_ASSERT_EQUAL(i, errorCodeIndex(kAllErrorCodes[i]));
+        if (i > 0) {
+            TEST_ASSERT_LESS_THAN(static_cast<int>(kAllErrorCodes[i]),
+                                  static_cast<int>(kAllErrorCodes[i - 1]));
+        }
+    }
+
+    // Values outside the enum share the index kErrorCodeCount
+    TEST_ASSERT_EQUAL(kErrorCodeCount, errorCodeIndex(static_cast<ErrorCode>(150)));
+    TEST_ASSERT_EQUAL(kErrorCodeCount, errorCodeIndex(static_cast<ErrorCode>(9999)));
+    TEST_ASSERT_EQUAL(kErrorCodeCount, errorCodeIndex(static_cast<ErrorCode>(-1)));
+}
+
+void test_error_code_string_pool() {
+    // All texts live in one block, addressed by 16-bit offsets
+    const char* first = errorCodeToString(kAllErrorCodes[0]);
+    const char* unknown = errorCodeToString(static_cast<ErrorCode>(9999));
+    for (auto code : kAllErrorCodes) {
+        const char* text = errorCodeToString(code);
+        TEST_ASSERT_TRUE(text >= first && text < unknown);
+    }
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", unknown);
+    TEST_ASSERT_EQUAL_PTR(unknown, errorCodeToString(static_cast<ErrorCode>(150)));
+
+    static_assert(errorCodeToString(ErrorCode::SSL_ERROR)[0] == 'S', "usable at compile time");
+}
+
+void test_error_code_from_string() {
+    // Every text parses back to its code
+    for (auto code : kAllErrorCodes) {
+        ErrorCode parsed = ErrorCode::OK;
+        TEST_ASSERT_TRUE(errorCodeFromString(errorCodeToString(code), parsed));
+        TEST_ASSERT_EQUAL(code, parsed);
+    }
+
+    // Case is ignored
+    ErrorCode parsed = ErrorCode::OK;
+    TEST_ASSERT_TRUE(errorCodeFromString("timeout", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString("i/o ERROR", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::IO_ERROR, parsed);
+
+    // Enumerator names, including those that differ from the text
+    TEST_ASSERT_TRUE(errorCodeFromString("CRC_ERROR", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString("RESOURCE_NOT_FOUND", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::RESOURCE_NOT_FOUND, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString("IO_ERROR", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::IO_ERROR, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString("io_error", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::IO_ERROR, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString("SUCCESS", parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::OK, parsed);
+
+    // Tokens that are not NUL-terminated
+    const char line[] = "Busy,CRC error";
+    TEST_ASSERT_TRUE(errorCodeFromString(line, 4, parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, parsed);
+    TEST_ASSERT_TRUE(errorCodeFromString(line + 5, 9, parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, parsed);
+
+    // Unknown texts, prefixes and extensions are rejected; parsed is untouched
+    parsed = ErrorCode::OK;
+    TEST_ASSERT_FALSE(errorCodeFromString("", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString("Time", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString("Timeouts", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString("TIMEOUT_", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString("IO ERROR_", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString("Unknown error code", parsed));
+    TEST_ASSERT_FALSE(errorCodeFromString(line, 3, parsed));
+    TEST_ASSERT_EQUAL(ErrorCode::OK, parsed);
+
+    constexpr ErrorCode dns = [] {
+        ErrorCode code = ErrorCode::OK;
+        errorCodeFromString("DNS failed", code);
+        return code;
+    }();
+    static_assert(dns == ErrorCode::DNS_FAILED, "usable at compile time");
+}
+
+void test_error_code_category() {
+    TEST_ASSERT_EQUAL(ErrorCategory::NONE, category(ErrorCode::OK));
+    TEST_ASSERT_EQUAL(ErrorCategory::GENERAL, category(ErrorCode::INVALID_PARAMETER));
+    TEST_ASSERT_EQUAL(ErrorCategory::RESOURCE, category(ErrorCode::OUT_OF_MEMORY));
+    TEST_ASSERT_EQUAL(ErrorCategory::SYNCHRONIZATION, category(ErrorCode::TIMEOUT));
+    TEST_ASSERT_EQUAL(ErrorCategory::IO, category(ErrorCode::PERMISSION_DENIED));
+    TEST_ASSERT_EQUAL(ErrorCategory::DATA, category(ErrorCode::CRC_ERROR));
+    TEST_ASSERT_EQUAL(ErrorCategory::DEVICE, category(ErrorCode::HARDWARE_FAILURE));
+    TEST_ASSERT_EQUAL(ErrorCategory::COMMUNICATION, category(ErrorCode::SEND_FAILED));
+    TEST_ASSERT_EQUAL(ErrorCategory::STORAGE, category(ErrorCode::MOUNT_FAILED));
+    TEST_ASSERT_EQUAL(ErrorCategory::NETWORK, category(ErrorCode::SSL_ERROR));
+
+    // Values outside the enum
+    TEST_ASSERT_EQUAL(ErrorCategory::UNKNOWN, category(static_cast<ErrorCode>(150)));
+    TEST_ASSERT_EQUAL(ErrorCategory::UNKNOWN, category(static_cast<ErrorCode>(-5)));
+    TEST_ASSERT_EQUAL(ErrorCategory::LIBRARY, category(static_cast<ErrorCode>(512)));
+
+    // Every code lies in the band of its category
+    for (auto code : kAllErrorCodes) {
+        const int value = static_cast<int>(code);
+        const int bands[] = {0, 1, 10, 30, 50, 70, 100, 200, 300, 400, 500};
+        const auto index = static_cast<size_t>(category(code));
+        TEST_ASSERT_TRUE(index + 1 < sizeof(bands) / sizeof(bands[0]));
+        TEST_ASSERT_GREATER_OR_EQUAL(bands[index], value);
+        TEST_ASSERT_LESS_THAN(bands[index + 1], value);
+    }
+}
+
+void test_error_code_classification() {
+    TEST_ASSERT_EQUAL(ErrorSeverity::NONE, severity(ErrorCode::OK));
+    TEST_ASSERT_FALSE(isRetryable(ErrorCode::OK));
+
+    TEST_ASSERT_TRUE(isTransient(ErrorCode::TIMEOUT));
+    TEST_ASSERT_TRUE(isRetryable(ErrorCode::TIMEOUT));
+    TEST_ASSERT_EQUAL(ErrorSeverity::WARNING, severity(ErrorCode::TIMEOUT));
+
+    TEST_ASSERT_FALSE(isTransient(ErrorCode::CRC_ERROR));
+    TEST_ASSERT_TRUE(isRetryable(ErrorCode::CRC_ERROR));
+    TEST_ASSERT_EQUAL(ErrorSeverity::ERROR, severity(ErrorCode::CRC_ERROR));
+
+    TEST_ASSERT_FALSE(isRetryable(ErrorCode::INVALID_PARAMETER));
+    TEST_ASSERT_FALSE(isFatal(ErrorCode::INVALID_PARAMETER));
+    TEST_ASSERT_TRUE(isFatal(ErrorCode::OUT_OF_MEMORY));
+    TEST_ASSERT_TRUE(isFatal(ErrorCode::HARDWARE_FAILURE));
+
+    for (auto code : kAllErrorCodes) {
+        // Transient implies retryable; only OK is not an error
+        TEST_ASSERT_TRUE(!isTransient(code) || isRetryable(code));
+        TEST_ASSERT_EQUAL(code == ErrorCode::OK, severity(code) == ErrorSeverity::NONE);
+        TEST_ASSERT_FALSE(isFatal(code) && isRetryable(code));
+    }
+
+    // Values outside the enum are plain, permanent errors
+    for (int value : {-1, 150, 405, 999}) {
+        const auto code = static_cast<ErrorCode>(value);
+        TEST_ASSERT_EQUAL(ErrorSeverity::ERROR, severity(code));
+        TEST_ASSERT_FALSE(isRetryable(code));
+        TEST_ASSERT_FALSE(isTransient(code));
+    }
+
+    static_assert(isTransient(ErrorCode::QUEUE_FULL), "usable at compile time");
+    static_assert(category(ErrorCode::DNS_FAILED) == ErrorCategory::NETWORK, "usable at compile time");
+}
+
 // Test runner
 void runErrorCodeTests() {
     UNITY_BEGIN();
@@ -82,6 +256,11 @@ void runErrorCodeTests() {
     RUN_TEST(test_error_code_ranges);
     RUN_TEST(test_error_code_constexpr);
     RUN_TEST(test_error_code_unknown);
+    RUN_TEST(test_error_code_index);
+    RUN_TEST(test_error_code_string_pool);
+    RUN_TEST(test_error_code_from_string);
+    RUN_TEST(test_error_code_category);
+    RUN_TEST(test_error_code_classification);
 
     UNITY_END();
 }
@@ -0,0 +1,191 @@
+/**
+ * @file test_error_domain.cpp
+ * @brief Unit tests for library error domains (ErrorDomain.h)
+ *
+ * Three mock libraries declare their own error enums; the application
+ * merges them into one ErrorDomainSet.
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+// Mock library 1: a Modbus driver
+namespace modbus {
+enum class Error : uint8_t {
+    ILLEGAL_FUNCTION,
+    ILLEGAL_ADDRESS,
+    ILLEGAL_VALUE,
+    SLAVE_FAILURE,
+};
+} // namespace modbus
+
+template<>
+struct common::ErrorDomain<modbus::Error> {
+    static constexpr ErrorValue first = 600;
+    static constexpr const char* names[] = {
+        "Illegal function", "Illegal address", "Illegal value", "Slave failure"};
+};
+
+// Mock library 2: a WiFi manager (unscoped enum)
+namespace wifi {
+enum Error {
+    AUTH_FAILED,
+    AP_NOT_FOUND,
+};
+} // namespace wifi
+
+template<>
+struct common::ErrorDomain<wifi::Error> {
+    static constexpr ErrorValue first = 500;
+    static constexpr const char* names[] = {"Authentication failed", "Access point not found"};
+};
+
+// Mock library 3: a flash log store
+namespace flashlog {
+enum class Error : int16_t {
+    SECTOR_WORN,
+    JOURNAL_REPLAY_FAILED,
+    SCHEMA_MISMATCH,
+};
+} // namespace flashlog
+
+template<>
+struct common::ErrorDomain<flashlog::Error> {
+    static constexpr ErrorValue first = 1000;
+    static constexpr const char* names[] = {"Sector worn", "Journal replay failed", "Schema mismatch"};
+};
+
+// A library that picked a range overlapping Modbus (603-604)
+namespace overlapping {
+enum class Error : uint8_t { A, B };
+} // namespace overlapping
+
+template<>
+struct common::ErrorDomain<overlapping::Error> {
+    static constexpr ErrorValue first = 603;
+    static constexpr const char* names[] = {"A", "B"};
+};
+
+using AppErrors = ErrorDomainSet<modbus::Error, wifi::Error, flashlog::Error>;
+
+// Ranges are checked for overlap at compile time
+static_assert(errorDomainsDisjoint<modbus::Error, wifi::Error, flashlog::Error>(), "mock ranges are disjoint");
+static_assert(!errorDomainsDisjoint<modbus::Error, overlapping::Error>(), "overlap is detected");
+static_assert(!errorDomainsDisjoint<overlapping::Error, wifi::Error, modbus::Error>(), "in any order");
+static_assert(!errorDomainsDisjoint<modbus::Error, modbus::Error>(), "a domain overlaps itself");
+
+static_assert(isErrorDomain<modbus::Error> && isErrorDomain<wifi::Error>, "declared domains");
+static_assert(!isErrorDomain<ErrorCode> && !isErrorDomain<int>, "ErrorCode is not a domain");
+static_assert(ErrorDomainRange<modbus::Error>::last == 603, "range covers every name");
+static_assert(AppErrors::kNameCount == 9, "all names merged");
+static_assert(AppErrors::contains<wifi::Error> && !AppErrors::contains<overlapping::Error>, "membership");
+
+namespace {
+
+Result<uint16_t> readHoldingRegister(uint16_t address) {
+    RETURN_ERROR_IF(address > 100, toErrorCode(modbus::Error::ILLEGAL_ADDRESS));
+    return Result<uint16_t>::ok(static_cast<uint16_t>(address * 2));
+}
+
+Result<int32_t> readTemperature() {
+    ASSIGN_OR_RETURN(uint16_t raw, readHoldingRegister(200));
+    return Result<int32_t>::ok(raw);
+}
+
+} // namespace
+
+void test_domain_error_values() {
+    TEST_ASSERT_EQUAL_INT32(600, toErrorValue(modbus::Error::ILLEGAL_FUNCTION));
+    TEST_ASSERT_EQUAL_INT32(603, toErrorValue(modbus::Error::SLAVE_FAILURE));
+    TEST_ASSERT_EQUAL_INT32(501, toErrorValue(wifi::AP_NOT_FOUND));
+    TEST_ASSERT_EQUAL_INT32(1002, toErrorValue(flashlog::Error::SCHEMA_MISMATCH));
+    TEST_ASSERT_EQUAL_INT32(30, toErrorValue(ErrorCode::TIMEOUT));
+
+    modbus::Error modbusError = modbus::Error::ILLEGAL_FUNCTION;
+    TEST_ASSERT_TRUE(fromErrorValue(602, modbusError));
+    TEST_ASSERT_EQUAL(modbus::Error::ILLEGAL_VALUE, modbusError);
+    TEST_ASSERT_FALSE(fromErrorValue(604, modbusError));
+    TEST_ASSERT_FALSE(fromErrorValue(599, modbusError));
+    TEST_ASSERT_FALSE(fromErrorValue(30, modbusError));
+    TEST_ASSERT_EQUAL(modbus::Error::ILLEGAL_VALUE, modbusError);
+
+    flashlog::Error flashError = flashlog::Error::SECTOR_WORN;
+    TEST_ASSERT_TRUE(fromErrorValue(toErrorValue(flashlog::Error::JOURNAL_REPLAY_FAILED), flashError));
+    TEST_ASSERT_EQUAL(flashlog::Error::JOURNAL_REPLAY_FAILED, flashError);
+
+    static_assert(toErrorValue(wifi::AUTH_FAILED) == 500, "usable at compile time");
+}
+
+void test_domain_error_strings() {
+    TEST_ASSERT_EQUAL_STRING("Slave failure", errorCodeToString(modbus::Error::SLAVE_FAILURE));
+    TEST_ASSERT_EQUAL_STRING("Authentication failed", errorCodeToString(wifi::AUTH_FAILED));
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", errorCodeToString(static_cast<modbus::Error>(9)));
+
+    // The merged table covers ErrorCode and every domain of the set
+    TEST_ASSERT_EQUAL_STRING("Timeout", AppErrors::toString(ErrorCode::TIMEOUT));
+    TEST_ASSERT_EQUAL_STRING("Illegal address", AppErrors::toString(602 - 1));
+    TEST_ASSERT_EQUAL_STRING("Access point not found", AppErrors::toString(wifi::AP_NOT_FOUND));
+    TEST_ASSERT_EQUAL_STRING("Schema mismatch", AppErrors::toString(flashlog::Error::SCHEMA_MISMATCH));
+    TEST_ASSERT_EQUAL_STRING("Sector worn", AppErrors::toString(toErrorCode(flashlog::Error::SECTOR_WORN)));
+
+    // Gaps between ranges and values beyond them
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", AppErrors::toString(502));
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", AppErrors::toString(604));
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", AppErrors::toString(1003));
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", AppErrors::toString(150));
+    TEST_ASSERT_EQUAL_STRING("Unknown error code", AppErrors::toString(-100000));
+
+    static_assert(AppErrors::toString(1001)[0] == 'J', "usable at compile time");
+}
+
+void test_domain_errors_in_result() {
+    auto result = readTemperature();
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL_INT32(601, toErrorValue(result.error()));
+    TEST_ASSERT_EQUAL_STRING("Illegal address", AppErrors::toString(result.error()));
+    TEST_ASSERT_EQUAL(ErrorCategory::LIBRARY, category(result.error()));
+
+    modbus::Error error = modbus::Error::ILLEGAL_FUNCTION;
+    TEST_ASSERT_TRUE(fromErrorValue(toErrorValue(result.error()), error));
+    TEST_ASSERT_EQUAL(modbus::Error::ILLEGAL_ADDRESS, error);
+
+    // A Result over the domain enum converts with mapError
+    auto typed = Result<int, modbus::Error>::error(modbus::Error::SLAVE_FAILURE);
+    Result<int> common = typed.mapError(toErrorCode<modbus::Error>);
+    TEST_ASSERT_EQUAL_INT32(603, toErrorValue(common.error()));
+}
+
+// Test runner
+void runErrorDomainTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_domain_error_values);
+    RUN_TEST(test_domain_error_strings);
+    RUN_TEST(test_domain_errors_in_result);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Error Domain Tests ===\n");
+    runErrorDomainTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runErrorDomainTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
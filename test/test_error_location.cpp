@@ -0,0 +1,161 @@
+/**
+ * @file test_error_location.cpp
+ * @brief Unit tests for error source-location tags (LIBCOMMON_ERROR_LOCATION)
+ *
+ * Enables the option for this test program only. Expected lines are
+ * taken with __LINE__ next to the statement that creates the error.
+ */
+
+#ifdef UNIT_TEST
+
+#define LIBCOMMON_ERROR_LOCATION 1
+
+#include <unity.h>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+constexpr uint32_t kThisFile = detail::locationFileId(__FILE__);
+
+uint32_t g_timeoutLine = 0;
+
+Result<int> readSensor(bool fail) {
+    if (fail) {
+        g_timeoutLine = __LINE__ + 1;
+        return Result<int>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<int>::ok(42);
+}
+
+Result<int> viaAssign(bool fail) {
+    ASSIGN_OR_RETURN(int value, readSensor(fail));
+    return Result<int>::ok(value + 1);
+}
+
+Result<void> viaReturnIfError(bool fail) {
+    RETURN_IF_ERROR(viaAssign(fail).map([](int) {}));
+    return Result<void>::ok();
+}
+
+uint32_t g_rangeLine = 0;
+
+Result<int> checkRange(int value) {
+    g_rangeLine = __LINE__ + 1;
+    RETURN_ERROR_IF(value > 100, ErrorCode::INVALID_PARAMETER);
+    return Result<int>::ok(value);
+}
+
+} // namespace
+
+void test_location_error_factory() {
+    auto result = Result<int>::error(ErrorCode::BUSY); const uint32_t line = __LINE__;
+
+    TEST_ASSERT_TRUE(result.location().isKnown());
+    TEST_ASSERT_EQUAL(kThisFile, result.location().fileId());
+    TEST_ASSERT_EQUAL(line, result.location().line());
+}
+
+void test_location_other_constructors() {
+    auto viaCtor = Result<void>(ErrorCode::BUSY); const uint32_t ctorLine = __LINE__;
+    auto viaMake = makeError<int>(ErrorCode::BUSY); const uint32_t makeLine = __LINE__;
+    int target = 0;
+    auto viaRef = Result<int&>::error(ErrorCode::BUSY); const uint32_t refLine = __LINE__;
+    static_cast<void>(target);
+
+    TEST_ASSERT_EQUAL(ctorLine, viaCtor.location().line());
+    TEST_ASSERT_EQUAL(makeLine, viaMake.location().line());
+    TEST_ASSERT_EQUAL(refLine, viaRef.location().line());
+}
+
+void test_location_survives_propagation() {
+    auto assigned = viaAssign(true);
+    auto chained = viaReturnIfError(true);
+
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, chained.error());
+    TEST_ASSERT_EQUAL(g_timeoutLine, assigned.location().line());
+    TEST_ASSERT_EQUAL(g_timeoutLine, chained.location().line());
+    TEST_ASSERT_EQUAL(kThisFile, chained.location().fileId());
+}
+
+void test_location_survives_chaining() {
+    auto mapped = readSensor(true).map([](int v) { return v * 2; });
+    auto chained = readSensor(true).andThen([](int v) { return Result<float>::ok(v * 0.5f); });
+    auto remapped = readSensor(true).mapError([](ErrorCode) { return ErrorCode::DEVICE_ERROR; });
+
+    TEST_ASSERT_EQUAL(g_timeoutLine, mapped.location().line());
+    TEST_ASSERT_EQUAL(g_timeoutLine, chained.location().line());
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_ERROR, remapped.error());
+    TEST_ASSERT_EQUAL(g_timeoutLine, remapped.location().line());
+}
+
+void test_location_return_error_if() {
+    auto result = checkRange(500);
+
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_PARAMETER, result.error());
+    TEST_ASSERT_EQUAL(g_rangeLine, result.location().line());
+}
+
+void test_location_success_is_unknown() {
+    TEST_ASSERT_FALSE(readSensor(false).location().isKnown());
+    TEST_ASSERT_FALSE(ErrorLocation().isKnown());
+}
+
+void test_location_tag_layout() {
+    // Same values as tools/error_tag.py: file_id("Result.h") == 0x2e082
+    static_assert(detail::locationFileId("Result.h") == 0x2e082, "file id hash changed");
+    static_assert(detail::locationFileId("src/Result.h") == 0x2e082, "directories must be ignored");
+    static_assert(detail::locationTag("Result.h", 17) == ((0x2e082u << 12) | 17), "tag layout changed");
+    static_assert(detail::locationTag("Result.h", 99999) % 4096 == 4095, "long lines clamp");
+
+    ErrorLocation location(detail::locationTag("Result.h", 17));
+    TEST_ASSERT_EQUAL_HEX32(0x2e082, location.fileId());
+    TEST_ASSERT_EQUAL(17, location.line());
+}
+
+#if !LIBCOMMON_EXPECTED_STORAGE
+void test_location_size_cost() {
+    TEST_ASSERT_EQUAL(sizeof(uint32_t), sizeof(ErrorLocation));
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(uint64_t), sizeof(Result<void>));
+    TEST_ASSERT_TRUE(std::is_trivially_copyable_v<Result<uint16_t>>);
+}
+#endif
+
+// Test runner
+void runErrorLocationTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_location_error_factory);
+    RUN_TEST(test_location_other_constructors);
+    RUN_TEST(test_location_survives_propagation);
+    RUN_TEST(test_location_survives_chaining);
+    RUN_TEST(test_location_return_error_if);
+    RUN_TEST(test_location_success_is_unknown);
+    RUN_TEST(test_location_tag_layout);
+#if !LIBCOMMON_EXPECTED_STORAGE
+    RUN_TEST(test_location_size_cost);
+#endif
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Error Location Tests ===\n");
+    runErrorLocationTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runErrorLocationTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
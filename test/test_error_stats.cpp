@@ -0,0 +1,234 @@
+/**
+ * @file test_error_stats.cpp
+ * @brief Unit tests for the per-ErrorCode statistics (ErrorStats.h)
+ *
+ * Enables LIBCOMMON_ERROR_STATS for this test program only.
+ */
+
+#ifdef UNIT_TEST
+
+#define LIBCOMMON_ERROR_STATS 1
+
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+Result<int> readSensor(bool fail) {
+    RETURN_ERROR_IF(fail, ErrorCode::TIMEOUT);
+    return Result<int>::ok(21);
+}
+
+Result<int> scaleSensor(bool fail) {
+    ASSIGN_OR_RETURN(int raw, readSensor(fail));
+    return Result<int>::ok(raw * 2);
+}
+
+Result<int> checkSensor(bool fail) {
+    RETURN_IF_ERROR(scaleSensor(fail));
+    return Result<int>::ok(0);
+}
+
+// Constant evaluation must not try to count
+constexpr Result<int> kConstantError = Result<int>::error(ErrorCode::BUSY);
+static_assert(kConstantError.error() == ErrorCode::BUSY, "constexpr errors still work");
+
+} // namespace
+
+void setUp() {
+    errorStats().reset();
+}
+
+void tearDown() {}
+
+void test_stats_count_created_errors() {
+    auto a = Result<int>::error(ErrorCode::TIMEOUT);
+    Result<void> b(ErrorCode::TIMEOUT);
+    auto c = makeError<float>(ErrorCode::BUSY);
+    Result<int> d = makeFailure(ErrorCode::BUSY);
+    Result<int> e(err_tag, ErrorCode::CRC_ERROR);
+    (void)a; (void)b; (void)c; (void)d; (void)e;
+
+    TEST_ASSERT_EQUAL_UINT32(2, errorStats().total(ErrorCode::TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(2, errorStats().total(ErrorCode::BUSY));
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(ErrorCode::CRC_ERROR));
+    TEST_ASSERT_EQUAL_UINT32(0, errorStats().total(ErrorCode::NOT_SUPPORTED));
+}
+
+void test_stats_ignore_success_and_copies() {
+    auto ok = Result<int>::ok(1);
+    auto err = Result<int>::error(ErrorCode::INVALID_DATA);
+    auto copy = err;
+    auto moved = std::move(copy);
+    (void)ok; (void)moved;
+
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(ErrorCode::INVALID_DATA));
+    TEST_ASSERT_EQUAL_UINT32(0, errorStats().total(ErrorCode::OK));
+}
+
+void test_stats_count_propagation_once() {
+    auto result = checkSensor(true);
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(ErrorCode::TIMEOUT));
+
+    TEST_ASSERT_TRUE(checkSensor(false).isOk());
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(ErrorCode::TIMEOUT));
+}
+
+void test_stats_chaining_does_not_count() {
+    auto err = Result<int>::error(ErrorCode::RECEIVE_FAILED);
+    auto mapped = err.map([](int v) { return v + 1; })
+                     .andThen([](int v) { return Result<int>::ok(v); })
+                     .mapError([](ErrorCode) { return ErrorCode::COMMUNICATION_ERROR; });
+
+    TEST_ASSERT_EQUAL(ErrorCode::COMMUNICATION_ERROR, mapped.error());
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(ErrorCode::RECEIVE_FAILED));
+    TEST_ASSERT_EQUAL_UINT32(0, errorStats().total(ErrorCode::COMMUNICATION_ERROR));
+}
+
+void test_stats_unknown_values() {
+    auto err = Result<int>::error(static_cast<ErrorCode>(9999));
+    (void)err;
+
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().otherTotal());
+    TEST_ASSERT_EQUAL_UINT32(1, errorStats().total(static_cast<ErrorCode>(150)));
+}
+
+void test_stats_tick_windows() {
+    ErrorStatistics stats;
+    uint16_t seconds[ErrorStatistics::kWindow];
+    TEST_ASSERT_EQUAL(0, stats.history(ErrorCode::TIMEOUT, seconds, ErrorStatistics::kWindow));
+
+    // Seconds with 1, 2, ... occurrences, one more than the window holds
+    for (uint32_t second = 1; second <= ErrorStatistics::kWindow + 1; ++second) {
+        for (uint32_t i = 0; i < second; ++i) {
+            stats.record(ErrorCode::TIMEOUT);
+        }
+        stats.tick();
+    }
+
+    const size_t count = stats.history(ErrorCode::TIMEOUT, seconds, ErrorStatistics::kWindow);
+    TEST_ASSERT_EQUAL(ErrorStatistics::kWindow, count);
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL_UINT16(i + 2, seconds[i]);
+    }
+
+    // A short buffer gets the newest seconds
+    uint16_t newest[2];
+    TEST_ASSERT_EQUAL(2, stats.history(ErrorCode::TIMEOUT, newest, 2));
+    TEST_ASSERT_EQUAL_UINT16(ErrorStatistics::kWindow, newest[0]);
+    TEST_ASSERT_EQUAL_UINT16(ErrorStatistics::kWindow + 1, newest[1]);
+
+    const ErrorStat stat = stats.stat(ErrorCode::TIMEOUT);
+    const uint32_t n = ErrorStatistics::kWindow + 1;
+    TEST_ASSERT_EQUAL_UINT32(n * (n + 1) / 2, stat.total);
+    TEST_ASSERT_EQUAL_UINT32(n * (n + 1) / 2 - 1, stat.windowTotal);
+    TEST_ASSERT_EQUAL_UINT16(n, stat.lastSecond);
+    TEST_ASSERT_EQUAL_UINT16(n, stat.peak);
+
+    // A quiet second
+    stats.tick();
+    TEST_ASSERT_EQUAL_UINT16(0, stats.stat(ErrorCode::TIMEOUT).lastSecond);
+    TEST_ASSERT_EQUAL_UINT16(n, stats.stat(ErrorCode::TIMEOUT).peak);
+}
+
+void test_stats_snapshot() {
+    ErrorStatistics stats;
+    stats.record(ErrorCode::SSL_ERROR);
+    stats.record(ErrorCode::TIMEOUT);
+    stats.record(ErrorCode::TIMEOUT);
+    stats.record(static_cast<ErrorCode>(9999));
+    stats.tick();
+
+    ErrorStat out[kErrorCodeCount];
+    const size_t n = stats.snapshot(out, kErrorCodeCount);
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, out[0].code);
+    TEST_ASSERT_EQUAL_UINT32(2, out[0].total);
+    TEST_ASSERT_EQUAL_UINT16(2, out[0].lastSecond);
+    TEST_ASSERT_EQUAL(ErrorCode::SSL_ERROR, out[1].code);
+    TEST_ASSERT_EQUAL_UINT32(1, out[1].total);
+
+    TEST_ASSERT_EQUAL(1, stats.snapshot(out, 1));
+
+    stats.reset();
+    TEST_ASSERT_EQUAL(0, stats.snapshot(out, kErrorCodeCount));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.ticks());
+}
+
+void test_stats_rate_saturates() {
+    ErrorStatistics stats;
+    for (uint32_t i = 0; i < 70000; ++i) {
+        stats.record(ErrorCode::BUSY);
+    }
+    stats.tick();
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, stats.stat(ErrorCode::BUSY).lastSecond);
+    TEST_ASSERT_EQUAL_UINT32(70000, stats.total(ErrorCode::BUSY));
+}
+
+void test_stats_concurrent_recording() {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 20000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            const ErrorCode code = (t % 2 == 0) ? ErrorCode::TIMEOUT : ErrorCode::BUSY;
+            for (int i = 0; i < kPerThread; ++i) {
+                auto result = Result<int>::error(code);
+                (void)result;
+            }
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        errorStats().tick();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    errorStats().tick();
+
+    TEST_ASSERT_EQUAL_UINT32(2 * kPerThread, errorStats().total(ErrorCode::TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(2 * kPerThread, errorStats().total(ErrorCode::BUSY));
+}
+
+// Test runner
+void runErrorStatsTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_stats_count_created_errors);
+    RUN_TEST(test_stats_ignore_success_and_copies);
+    RUN_TEST(test_stats_count_propagation_once);
+    RUN_TEST(test_stats_chaining_does_not_count);
+    RUN_TEST(test_stats_unknown_values);
+    RUN_TEST(test_stats_tick_windows);
+    RUN_TEST(test_stats_snapshot);
+    RUN_TEST(test_stats_rate_saturates);
+    RUN_TEST(test_stats_concurrent_recording);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Error Stats Tests ===\n");
+    runErrorStatsTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runErrorStatsTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,262 @@
+/**
+ * @file test_error_trace.cpp
+ * @brief Unit tests for the error propagation trace rings (ErrorTrace.h)
+ *
+ * Enables LIBCOMMON_ERROR_TRACE for this test program only.
+ */
+
+#ifdef UNIT_TEST
+
+#define LIBCOMMON_ERROR_TRACE 1
+
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+std::atomic<uint32_t> g_ticks{0};
+
+uint32_t fakeClock() {
+    return g_ticks.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+uint32_t g_originLine = 0;
+uint32_t g_assignLine = 0;
+uint32_t g_returnLine = 0;
+
+Result<int> readSensor() {
+    g_originLine = __LINE__ + 1;
+    RETURN_ERROR_IF(true, ErrorCode::TIMEOUT);
+    return Result<int>::ok(0);
+}
+
+Result<int> scaleSensor() {
+    g_assignLine = __LINE__ + 1;
+    ASSIGN_OR_RETURN(int raw, readSensor());
+    return Result<int>::ok(raw * 2);
+}
+
+Result<int> controlStep() {
+    g_returnLine = __LINE__ + 1;
+    RETURN_IF_ERROR(scaleSensor());
+    return Result<int>::ok(1);
+}
+
+uint32_t get32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace
+
+void test_trace_records_hops() {
+    setErrorTraceClock(&fakeClock);
+    auto result = controlStep();
+    setErrorTraceClock(nullptr);
+
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, result.error());
+
+    TraceEntry entries[ErrorTraceRing::kDepth];
+    const size_t count = snapshotErrorTrace(entries, ErrorTraceRing::kDepth);
+    TEST_ASSERT_GREATER_OR_EQUAL(3, count);
+
+    const TraceEntry* hops = entries + count - 3;
+    const uint32_t lines[] = {g_originLine, g_assignLine, g_returnLine};
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL(static_cast<int32_t>(ErrorCode::TIMEOUT), hops[i].code);
+        TEST_ASSERT_EQUAL_HEX32(detail::locationTag(__FILE__, lines[i]), hops[i].location);
+    }
+    TEST_ASSERT_TRUE(hops[0].timestamp < hops[1].timestamp);
+    TEST_ASSERT_TRUE(hops[1].timestamp < hops[2].timestamp);
+}
+
+void test_trace_keeps_newest_entries() {
+    const uint32_t total = ErrorTraceRing::kDepth + 5;
+    for (uint32_t i = 0; i < total; ++i) {
+        recordErrorHop(7, 1000 + i);
+    }
+
+    TraceEntry entries[ErrorTraceRing::kDepth];
+    const size_t count = snapshotErrorTrace(entries, ErrorTraceRing::kDepth);
+
+    TEST_ASSERT_EQUAL(ErrorTraceRing::kDepth, count);
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL(1000 + total - ErrorTraceRing::kDepth + i, entries[i].location);
+    }
+
+    // A smaller destination keeps the newest entries
+    TEST_ASSERT_EQUAL(4, snapshotErrorTrace(entries, 4));
+    TEST_ASSERT_EQUAL(1000 + total - 1, entries[3].location);
+}
+
+void test_trace_dump_format() {
+    recordErrorHop(-3, 0xABCDE123);
+
+    static uint8_t blob[kErrorTraceDumpMaxSize];
+    const size_t size = dumpErrorTrace(blob, sizeof(blob));
+
+    TEST_ASSERT_GREATER_THAN(kErrorTraceDumpHeaderSize, size);
+    TEST_ASSERT_EQUAL_MEMORY("ETR1", blob, 4);
+    TEST_ASSERT_EQUAL(kErrorTraceDumpEntrySize, get16(blob + 6));
+
+    // Walk all rings; the sizes must add up and our entry must be present
+    const uint16_t rings = get16(blob + 4);
+    const uint8_t* p = blob + kErrorTraceDumpHeaderSize;
+    bool found = false;
+    for (uint16_t r = 0; r < rings; ++r) {
+        TEST_ASSERT_NOT_EQUAL(0, get32(p));
+        const uint16_t entries = get16(p + 4);
+        p += kErrorTraceDumpRingHeaderSize;
+        for (uint16_t e = 0; e < entries; ++e, p += kErrorTraceDumpEntrySize) {
+            found |= get32(p + 4) == 0xABCDE123 && static_cast<int32_t>(get32(p + 8)) == -3;
+        }
+    }
+    TEST_ASSERT_EQUAL(size, static_cast<size_t>(p - blob));
+    TEST_ASSERT_TRUE(found);
+
+    TEST_ASSERT_EQUAL(0, dumpErrorTrace(blob, kErrorTraceDumpHeaderSize - 1));
+}
+
+void test_trace_concurrent_writers_and_reader() {
+    constexpr int kWriters = 4;
+    constexpr uint32_t kHops = 200000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> snapshots{0};
+    std::atomic<uint32_t> torn{0};
+
+    // Each writer records (code = writer id, location = sequence number), so
+    // every consistent snapshot holds one code and consecutive locations
+    std::thread reader([&] {
+        TraceEntry entries[ErrorTraceRing::kDepth];
+        while (!done.load()) {
+            const ErrorTraceRing* rings = detail::traceRings();
+            for (size_t r = 0; r < LIBCOMMON_ERROR_TRACE_THREADS; ++r) {
+                const size_t count = rings[r].snapshot(entries, ErrorTraceRing::kDepth);
+                for (size_t i = 1; i < count; ++i) {
+                    if (entries[i].code < 100) {
+                        continue;  // ring of another test's thread
+                    }
+                    if (entries[i].code != entries[0].code ||
+                        entries[i].location != entries[i - 1].location + 1) {
+                        torn.fetch_add(1);
+                    }
+                }
+                snapshots.fetch_add(1);
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([w] {
+            for (uint32_t i = 0; i < kHops; ++i) {
+                recordErrorHop(100 + w, i);
+            }
+            TraceEntry entries[ErrorTraceRing::kDepth];
+            const size_t count = snapshotErrorTrace(entries, ErrorTraceRing::kDepth);
+            if (count != ErrorTraceRing::kDepth || entries[count - 1].location != kHops - 1) {
+                TEST_FAIL_MESSAGE("writer lost its newest entries");
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    TEST_ASSERT_GREATER_THAN(0, snapshots.load());
+    TEST_ASSERT_EQUAL(0, torn.load());
+}
+
+void test_trace_pool_exhaustion() {
+    constexpr int kThreads = LIBCOMMON_ERROR_TRACE_THREADS + 2;
+    const uint32_t untracedBefore = untracedThreadCount();
+    std::atomic<int> recorded{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            recordErrorHop(1, 1);
+            recorded.fetch_add(1);
+            // Hold the ring until every thread has tried to claim one
+            while (recorded.load() < kThreads) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The main thread holds a ring too, so at least three threads missed out
+    TEST_ASSERT_GREATER_OR_EQUAL(3, untracedThreadCount() - untracedBefore);
+}
+
+void test_trace_explicit_release() {
+    ErrorTraceRing* released = nullptr;
+    size_t entriesAfterRelease = 1;
+    size_t entriesAfterRestart = 0;
+
+    // As a FreeRTOS task would before vTaskDelete(NULL)
+    std::thread task([&] {
+        recordErrorHop(1, 1);
+        released = detail::currentTraceRing;
+        releaseErrorTraceRing();
+
+        TraceEntry entries[LIBCOMMON_ERROR_TRACE_DEPTH];
+        entriesAfterRelease = snapshotErrorTrace(entries, LIBCOMMON_ERROR_TRACE_DEPTH);
+        recordErrorHop(2, 2);
+        entriesAfterRestart = snapshotErrorTrace(entries, LIBCOMMON_ERROR_TRACE_DEPTH);
+        releaseErrorTraceRing();
+    });
+    task.join();
+
+    TEST_ASSERT_NOT_NULL(released);
+    TEST_ASSERT_EQUAL(0, entriesAfterRelease);
+    TEST_ASSERT_EQUAL(1, entriesAfterRestart);
+    // Back in the pool: claimable by someone else
+    TEST_ASSERT_TRUE(released->tryClaim(0xFFFF));
+    released->release();
+}
+
+// Test runner
+void runErrorTraceTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_trace_records_hops);
+    RUN_TEST(test_trace_keeps_newest_entries);
+    RUN_TEST(test_trace_dump_format);
+    RUN_TEST(test_trace_concurrent_writers_and_reader);
+    RUN_TEST(test_trace_pool_exhaustion);
+    RUN_TEST(test_trace_explicit_release);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Error Trace Tests ===\n");
+    runErrorTraceTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runErrorTraceTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,233 @@
+/**
+ * @file test_macros.cpp
+ * @brief Unit tests for the error-propagation macros in LibraryCommon.h
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+// Payload that counts copies and moves
+struct Counted {
+    static int copies;
+    static int moves;
+
+    static void reset() { copies = moves = 0; }
+
+    explicit Counted(int v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { ++copies; }
+    Counted(Counted&& other) noexcept : value(other.value) { ++moves; }
+    Counted& operator=(const Counted&) = delete;
+    Counted& operator=(Counted&&) = delete;
+
+    int value;
+};
+
+int Counted::copies = 0;
+int Counted::moves = 0;
+
+Result<int> readRegister(int value, bool fail) {
+    if (fail) {
+        return Result<int>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<int>::ok(value);
+}
+
+Result<Counted> readCounted(int value) {
+    return Result<Counted>::emplace(value);
+}
+
+struct Device {
+    int polls = 0;
+};
+
+Device g_device;
+
+Result<Device&> findDevice(bool fail) {
+    if (fail) {
+        return Result<Device&>::error(ErrorCode::DEVICE_NOT_FOUND);
+    }
+    return Result<Device&>::ok(g_device);
+}
+
+Result<void> step(bool fail) {
+    if (fail) {
+        return Result<void>::error(ErrorCode::IO_ERROR);
+    }
+    return Result<void>::ok();
+}
+
+Result<void> runSteps(bool failFirst, bool failSecond) {
+    RETURN_IF_ERROR(step(failFirst));
+    RETURN_IF_ERROR(step(failSecond));
+    return Result<void>::ok();
+}
+
+Result<int> checkPositive(int x) {
+    RETURN_ERROR_IF(x <= 0, ErrorCode::INVALID_PARAMETER);
+    return Result<int>::ok(x);
+}
+
+Result<int> sumTwice(bool failSecond) {
+    ASSIGN_OR_RETURN(int a, readRegister(20, false));
+    ASSIGN_OR_RETURN(int b, readRegister(22, failSecond));
+    return Result<int>::ok(a + b);
+}
+
+Result<void> assignIntoVoid(bool fail) {
+    ASSIGN_OR_RETURN(int value, readRegister(1, fail));
+    (void)value;
+    return Result<void>::ok();
+}
+
+#if LIBCOMMON_HAS_TRY_EXPR
+Result<int> trySum(bool failA, bool failB) {
+    return Result<int>::ok(RESULT_TRY(readRegister(40, failA)) + RESULT_TRY(readRegister(2, failB)));
+}
+
+Result<long> tryNested(bool fail) {
+    return Result<long>::ok(RESULT_TRY(readRegister(RESULT_TRY(readRegister(5, false)) * 2, fail)));
+}
+
+Result<int> tryCounted() {
+    Counted counted = RESULT_TRY(readCounted(17));
+    return Result<int>::ok(counted.value);
+}
+
+Result<int> handCounted() {
+    auto result = readCounted(17);
+    if (!result) {
+        return Result<int>::error(result.error());
+    }
+    Counted counted = std::move(result).value();
+    return Result<int>::ok(counted.value);
+}
+#endif
+
+} // namespace
+
+void test_return_if_error_success() {
+    TEST_ASSERT_TRUE(runSteps(false, false).isOk());
+}
+
+void test_return_if_error_propagates() {
+    auto result = runSteps(false, true);
+
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::IO_ERROR, result.error());
+}
+
+void test_return_error_if() {
+    TEST_ASSERT_EQUAL(3, checkPositive(3).value());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_PARAMETER, checkPositive(-1).error());
+}
+
+void test_assign_or_return_twice_per_scope() {
+    TEST_ASSERT_EQUAL(42, sumTwice(false).value());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, sumTwice(true).error());
+}
+
+void test_assign_or_return_binds_reference() {
+    Device* seen = nullptr;
+    auto poll = [&seen](bool fail) -> Result<void> {
+        ASSIGN_OR_RETURN(auto& device, findDevice(fail));
+        ++device.polls;
+        seen = &device;
+        return Result<void>::ok();
+    };
+
+    g_device.polls = 0;
+    TEST_ASSERT_TRUE(poll(false).isOk());
+    TEST_ASSERT_EQUAL_PTR(&g_device, seen);
+    TEST_ASSERT_EQUAL(1, g_device.polls);
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, poll(true).error());
+}
+
+void test_assign_or_return_converts_error() {
+    TEST_ASSERT_TRUE(assignIntoVoid(false).isOk());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, assignIntoVoid(true).error());
+}
+
+#if LIBCOMMON_HAS_TRY_EXPR
+void test_try_in_expression() {
+    TEST_ASSERT_EQUAL(42, trySum(false, false).value());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, trySum(true, false).error());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, trySum(false, true).error());
+}
+
+void test_try_nested_and_converted() {
+    TEST_ASSERT_EQUAL(10, tryNested(false).value());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, tryNested(true).error());
+}
+
+void test_try_moves_like_hand_written() {
+    Counted::reset();
+    TEST_ASSERT_EQUAL(17, handCounted().value());
+    const int handMoves = Counted::moves;
+
+    Counted::reset();
+    TEST_ASSERT_EQUAL(17, tryCounted().value());
+
+    TEST_ASSERT_EQUAL(0, Counted::copies);
+    TEST_ASSERT_EQUAL(handMoves, Counted::moves);
+}
+
+void test_try_does_not_move_from_lvalue() {
+    auto source = readCounted(9);
+    Counted::reset();
+
+    auto copy = [&source]() -> Result<int> {
+        Counted counted = RESULT_TRY(source);
+        return Result<int>::ok(counted.value);
+    }();
+
+    TEST_ASSERT_EQUAL(9, copy.value());
+    TEST_ASSERT_EQUAL(1, Counted::copies);
+    TEST_ASSERT_EQUAL(9, source.value().value);
+}
+#endif
+
+// Test runner
+void runMacroTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_return_if_error_success);
+    RUN_TEST(test_return_if_error_propagates);
+    RUN_TEST(test_return_error_if);
+    RUN_TEST(test_assign_or_return_twice_per_scope);
+    RUN_TEST(test_assign_or_return_binds_reference);
+    RUN_TEST(test_assign_or_return_converts_error);
+#if LIBCOMMON_HAS_TRY_EXPR
+    RUN_TEST(test_try_in_expression);
+    RUN_TEST(test_try_nested_and_converted);
+    RUN_TEST(test_try_moves_like_hand_written);
+    RUN_TEST(test_try_does_not_move_from_lvalue);
+#endif
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Macro Tests ===\n");
+    runMacroTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runMacroTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
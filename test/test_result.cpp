@@ -6,6 +6,7 @@
 #ifdef UNIT_TEST
 
 #include <unity.h>
+#include <string>
 #include "../src/Result.h"
 
 using namespace common;
@@ -18,6 +19,49 @@ enum class TestError {
     UNDERFLOW
 };
 
+// Payload without a default constructor
+struct NoDefault {
+    explicit NoDefault(int v) : value(v) {}
+    int value;
+};
+
+// Aggregate payload
+struct Point {
+    int x;
+    int y;
+};
+
+// Payload that can neither be copied nor moved
+struct Pinned {
+    explicit Pinned(int v) : value(v) {}
+    Pinned(const Pinned&) = delete;
+    Pinned& operator=(const Pinned&) = delete;
+    int value;
+};
+
+// Payload that counts its special member calls
+struct Tracked {
+    static int constructed;
+    static int destroyed;
+    static int copies;
+    static int moves;
+
+    static void reset() { constructed = destroyed = copies = moves = 0; }
+
+    Tracked() { ++constructed; }
+    Tracked(int, int) { ++constructed; }
+    Tracked(const Tracked&) { ++constructed; ++copies; }
+    Tracked(Tracked&&) noexcept { ++constructed; ++moves; }
+    Tracked& operator=(const Tracked&) { ++copies; return *this; }
+    Tracked& operator=(Tracked&&) noexcept { ++moves; return *this; }
+    ~Tracked() { ++destroyed; }
+};
+
+int Tracked::constructed = 0;
+int Tracked::destroyed = 0;
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
 void test_result_ok_creation() {
     auto result = Result<int>::ok(42);
 
@@ -135,6 +179,168 @@ void test_make_void_ok_helper() {
     TEST_ASSERT_TRUE(result.isOk());
 }
 
+void test_result_error_does_not_construct_value() {
+    Tracked::reset();
+    {
+        auto result = Result<Tracked>::error(ErrorCode::TIMEOUT);
+        TEST_ASSERT_TRUE(result.isError());
+    }
+
+    TEST_ASSERT_EQUAL(0, Tracked::constructed);
+    TEST_ASSERT_EQUAL(0, Tracked::destroyed);
+}
+
+void test_result_value_lifetime_balanced() {
+    Tracked::reset();
+    {
+        auto result = Result<Tracked>::ok(Tracked());
+        auto copy = result;
+        auto moved = std::move(copy);
+        TEST_ASSERT_TRUE(moved.isOk());
+    }
+
+    TEST_ASSERT_EQUAL(Tracked::constructed, Tracked::destroyed);
+}
+
+void test_result_copy_touches_active_member_only() {
+    auto failure = Result<Tracked>::error(ErrorCode::BUSY);
+    Tracked::reset();
+
+    auto copy = failure;
+    auto moved = std::move(copy);
+
+    TEST_ASSERT_EQUAL(0, Tracked::copies);
+    TEST_ASSERT_EQUAL(0, Tracked::moves);
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, moved.error());
+}
+
+void test_result_copied_success_reports_ok() {
+    auto success = Result<std::string>::ok(std::string("frame"));
+
+    auto copy = success;
+    auto moved = std::move(copy);
+
+    TEST_ASSERT_EQUAL(ErrorCode::OK, success.error());
+    TEST_ASSERT_EQUAL(ErrorCode::OK, copy.error());
+    TEST_ASSERT_EQUAL(ErrorCode::OK, moved.error());
+    TEST_ASSERT_EQUAL_STRING("frame", moved.value().c_str());
+}
+
+void test_result_assignment_switches_active_member() {
+    Tracked::reset();
+    {
+        auto result = Result<Tracked>::error(ErrorCode::BUSY);
+        result = Result<Tracked>::ok(Tracked());
+        TEST_ASSERT_TRUE(result.isOk());
+
+        result = Result<Tracked>::error(ErrorCode::IO_ERROR);
+        TEST_ASSERT_TRUE(result.isError());
+        TEST_ASSERT_EQUAL(ErrorCode::IO_ERROR, result.error());
+        TEST_ASSERT_EQUAL(Tracked::constructed, Tracked::destroyed);
+    }
+
+    TEST_ASSERT_EQUAL(Tracked::constructed, Tracked::destroyed);
+}
+
+void test_result_non_default_constructible() {
+    auto success = Result<NoDefault>::ok(NoDefault(7));
+    auto failure = Result<NoDefault>::error(ErrorCode::NOT_SUPPORTED);
+
+    TEST_ASSERT_EQUAL(7, success.value().value);
+    TEST_ASSERT_EQUAL(ErrorCode::NOT_SUPPORTED, failure.error());
+}
+
+// Layout checks hold for the library's own storage without locations
+#if !LIBCOMMON_EXPECTED_STORAGE && !LIBCOMMON_ERROR_LOCATION
+void test_result_packed_layout() {
+    TEST_ASSERT_EQUAL(sizeof(ErrorCode), sizeof(Result<void>));
+    TEST_ASSERT_EQUAL(sizeof(uint32_t), sizeof(Result<uint16_t>));
+    TEST_ASSERT_TRUE(std::is_trivially_copyable_v<Result<uint16_t>>);
+    TEST_ASSERT_TRUE(std::is_trivially_copyable_v<Result<float>>);
+}
+#endif
+
+#if !LIBCOMMON_ERROR_LOCATION
+void test_result_error_location_disabled() {
+    // LIBCOMMON_ERROR_LOCATION defaults to 0: no storage, unknown locations
+    auto failure = Result<int>::error(ErrorCode::TIMEOUT);
+
+    TEST_ASSERT_TRUE(std::is_empty_v<ErrorLocation>);
+    TEST_ASSERT_FALSE(failure.location().isKnown());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, failure.failure().error);
+}
+#endif
+
+void test_result_packed_value_and_error() {
+    auto success = Result<uint16_t>::ok(0xBEEF);
+    auto failure = Result<uint16_t>::error(ErrorCode::CRC_ERROR);
+
+    TEST_ASSERT_TRUE(success.isOk());
+    TEST_ASSERT_EQUAL(0xBEEF, success.value());
+    TEST_ASSERT_EQUAL(ErrorCode::OK, success.error());
+    TEST_ASSERT_TRUE(failure.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, failure.error());
+    TEST_ASSERT_EQUAL(7, failure.valueOr(7));
+}
+
+void test_result_custom_error_not_packed() {
+    // TestError does not opt in to ErrorTraits, so 0 is a real error value
+    auto result = Result<void, TestError>::error(TestError::NONE);
+
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL(TestError::NONE, result.error());
+}
+
+void test_result_zero_error_is_error() {
+    // OK means success in packed layouts; as an error it becomes UNKNOWN_ERROR everywhere
+    auto packed = Result<int>::error(ErrorCode::OK);
+    auto empty = Result<void>::error(ErrorCode::OK);
+    auto unpacked = Result<double>::error(ErrorCode::OK);
+    Result<int> propagated = makeFailure(ErrorCode::OK);
+
+    TEST_ASSERT_TRUE(packed.isError());
+    TEST_ASSERT_TRUE(empty.isError());
+    TEST_ASSERT_TRUE(unpacked.isError());
+    TEST_ASSERT_TRUE(propagated.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::UNKNOWN_ERROR, packed.error());
+    TEST_ASSERT_EQUAL(ErrorCode::UNKNOWN_ERROR, empty.error());
+    TEST_ASSERT_EQUAL(ErrorCode::UNKNOWN_ERROR, unpacked.error());
+    TEST_ASSERT_EQUAL(ErrorCode::UNKNOWN_ERROR, propagated.error());
+    TEST_ASSERT_EQUAL(5, packed.valueOr(5));
+}
+
+void test_result_emplace_constructs_once() {
+    Tracked::reset();
+    {
+        auto result = Result<Tracked>::emplace(1, 2);
+        TEST_ASSERT_TRUE(result.isOk());
+    }
+
+    TEST_ASSERT_EQUAL(1, Tracked::constructed);
+    TEST_ASSERT_EQUAL(0, Tracked::copies);
+    TEST_ASSERT_EQUAL(0, Tracked::moves);
+    TEST_ASSERT_EQUAL(1, Tracked::destroyed);
+}
+
+void test_result_in_place_constructor() {
+    Result<Tracked> result(in_place, 3, 4);
+
+    TEST_ASSERT_TRUE(result.isOk());
+}
+
+void test_result_emplace_aggregate() {
+    auto result = Result<Point>::emplace(3, 4);
+
+    TEST_ASSERT_EQUAL(3, result.value().x);
+    TEST_ASSERT_EQUAL(4, result.value().y);
+}
+
+void test_result_emplace_non_movable() {
+    auto result = Result<Pinned>::emplace(9);
+
+    TEST_ASSERT_EQUAL(9, result.value().value);
+}
+
 // Test runner
 void runResultTests() {
     UNITY_BEGIN();
@@ -153,6 +359,25 @@ void runResultTests() {
     RUN_TEST(test_make_ok_helper);
     RUN_TEST(test_make_error_helper);
     RUN_TEST(test_make_void_ok_helper);
+    RUN_TEST(test_result_error_does_not_construct_value);
+    RUN_TEST(test_result_value_lifetime_balanced);
+    RUN_TEST(test_result_copy_touches_active_member_only);
+    RUN_TEST(test_result_copied_success_reports_ok);
+    RUN_TEST(test_result_assignment_switches_active_member);
+    RUN_TEST(test_result_non_default_constructible);
+#if !LIBCOMMON_EXPECTED_STORAGE && !LIBCOMMON_ERROR_LOCATION
+    RUN_TEST(test_result_packed_layout);
+#endif
+#if !LIBCOMMON_ERROR_LOCATION
+    RUN_TEST(test_result_error_location_disabled);
+#endif
+    RUN_TEST(test_result_packed_value_and_error);
+    RUN_TEST(test_result_custom_error_not_packed);
+    RUN_TEST(test_result_zero_error_is_error);
+    RUN_TEST(test_result_emplace_constructs_once);
+    RUN_TEST(test_result_in_place_constructor);
+    RUN_TEST(test_result_emplace_aggregate);
+    RUN_TEST(test_result_emplace_non_movable);
 
     UNITY_END();
 }
@@ -0,0 +1,280 @@
+/**
+ * @file test_result_algorithms.cpp
+ * @brief Unit tests for collect(), all(), partition(), zip() and apply()
+ *        (ResultAlgorithms.h)
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <memory>
+#include <string>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+/// A register bank where some addresses do not answer
+struct RegisterBank {
+    uint64_t failing = 0;  ///< Bit i set: register i times out
+    size_t reads = 0;
+
+    Result<uint16_t> read(size_t index) {
+        ++reads;
+        if ((failing >> index) & 1u) {
+            return Result<uint16_t>::error(index % 2 == 0 ? ErrorCode::TIMEOUT : ErrorCode::CRC_ERROR);
+        }
+        return Result<uint16_t>::ok(static_cast<uint16_t>(1000 + index));
+    }
+};
+
+/// A type without a default constructor
+struct Reading {
+    explicit Reading(int v) : value(v) {}
+    int value;
+};
+
+constexpr Result<int> kGood[] = {Result<int>::ok(1), Result<int>::ok(2), Result<int>::ok(3)};
+static_assert(all(kGood).isOk(), "all() is constexpr");
+static_assert(collect(kGood).value()[2] == 3, "collect() is constexpr");
+static_assert(partition(kGood).allOk(), "partition() is constexpr");
+static_assert(std::get<1>(zip(Result<int>::ok(1), Result<char>::ok('x')).value()) == 'x', "zip() is constexpr");
+
+} // namespace
+
+void test_all_over_arrays() {
+    std::array<Result<uint16_t>, 4> results = {Result<uint16_t>::ok(1), Result<uint16_t>::ok(2),
+                                               Result<uint16_t>::ok(3), Result<uint16_t>::ok(4)};
+    TEST_ASSERT_TRUE(all(results).isOk());
+
+    results[1] = Result<uint16_t>::error(ErrorCode::TIMEOUT);
+    results[3] = Result<uint16_t>::error(ErrorCode::CRC_ERROR);
+    Result<void> checked = all(results);
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, checked.error());
+
+    // Pointer and count: only the first element
+    TEST_ASSERT_TRUE(all(results.data(), 1).isOk());
+    TEST_ASSERT_TRUE(all(results.data(), 0).isOk());
+}
+
+void test_collect_array() {
+    std::array<Result<uint16_t>, 3> results = {Result<uint16_t>::ok(10), Result<uint16_t>::ok(20),
+                                               Result<uint16_t>::ok(30)};
+    auto collected = collect(results);
+    TEST_ASSERT_TRUE(collected.isOk());
+    TEST_ASSERT_EQUAL_UINT16(10, collected.value()[0]);
+    TEST_ASSERT_EQUAL_UINT16(30, collected.value()[2]);
+
+    results[2] = Result<uint16_t>::error(ErrorCode::DEVICE_DISCONNECTED);
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_DISCONNECTED, collect(results).error());
+
+    // No default constructor needed when every Result is already there
+    Result<Reading> readings[] = {Result<Reading>::ok(Reading(7)), Result<Reading>::ok(Reading(8))};
+    auto gathered = collect(readings);
+    TEST_ASSERT_EQUAL(8, gathered.value()[1].value);
+}
+
+void test_collect_moves_values() {
+    std::array<Result<std::unique_ptr<int>>, 2> buffers = {
+        Result<std::unique_ptr<int>>::ok(std::make_unique<int>(1)),
+        Result<std::unique_ptr<int>>::ok(std::make_unique<int>(2))};
+    auto collected = collect(std::move(buffers));
+    TEST_ASSERT_TRUE(collected.isOk());
+    TEST_ASSERT_EQUAL(2, *collected.value()[1]);
+}
+
+void test_collect_generator_short_circuits() {
+    RegisterBank bank;
+    auto block = collect<32>([&](size_t i) { return bank.read(i); });
+    TEST_ASSERT_TRUE(block.isOk());
+    TEST_ASSERT_EQUAL(32, bank.reads);
+    TEST_ASSERT_EQUAL_UINT16(1031, block.value()[31]);
+
+    bank.failing = 1ull << 5;
+    bank.reads = 0;
+    block = collect<32>([&](size_t i) { return bank.read(i); });
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, block.error());
+    TEST_ASSERT_EQUAL(6, bank.reads);
+
+    bank.reads = 0;
+    Result<void> checked = all<32>([&](size_t i) { return bank.read(i); });
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, checked.error());
+    TEST_ASSERT_EQUAL(6, bank.reads);
+
+    // Result<void> operations
+    int writes = 0;
+    TEST_ASSERT_TRUE(all<4>([&](size_t) { ++writes; return Result<void>::ok(); }).isOk());
+    TEST_ASSERT_EQUAL(4, writes);
+}
+
+void test_partition_array() {
+    Result<uint16_t> results[] = {Result<uint16_t>::ok(1), Result<uint16_t>::error(ErrorCode::BUSY),
+                                  Result<uint16_t>::ok(3), Result<uint16_t>::error(ErrorCode::TIMEOUT)};
+    BatchStatus<4> status = partition(results);
+    TEST_ASSERT_FALSE(status.allOk());
+    TEST_ASSERT_TRUE(status.isOk(0));
+    TEST_ASSERT_FALSE(status.isOk(1));
+    TEST_ASSERT_TRUE(status.isOk(2));
+    TEST_ASSERT_FALSE(status.isOk(3));
+    TEST_ASSERT_EQUAL_UINT32(0x5, status.ok.words[0]);
+    TEST_ASSERT_EQUAL(2, status.okCount());
+    TEST_ASSERT_EQUAL(2, status.errorCount());
+    TEST_ASSERT_EQUAL(1, status.firstErrorIndex);
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, status.firstError);
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, status.toResult().error());
+
+    // A pointer and count smaller than the capacity
+    BatchStatus<8> head = partition<8>(results, 1);
+    TEST_ASSERT_EQUAL(1, head.size);
+    TEST_ASSERT_TRUE(head.allOk());
+    TEST_ASSERT_EQUAL(1, head.firstErrorIndex);
+    TEST_ASSERT_EQUAL(ErrorCode::OK, head.firstError);
+    TEST_ASSERT_TRUE(head.toResult().isOk());
+}
+
+void test_partition_generator_keeps_going() {
+    RegisterBank bank;
+    std::array<uint16_t, 64> registers;
+    registers.fill(0xFFFF);
+
+    // Registers 3, 40 and 63 time out; the rest of the cycle is kept
+    bank.failing = (1ull << 3) | (1ull << 40) | (1ull << 63);
+    BatchStatus<64> status = partition<64>([&](size_t i) { return bank.read(i); }, registers);
+    TEST_ASSERT_EQUAL(64, bank.reads);
+    TEST_ASSERT_EQUAL(61, status.okCount());
+    TEST_ASSERT_EQUAL(3, status.errorCount());
+    TEST_ASSERT_EQUAL(3, status.firstErrorIndex);
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, status.firstError);
+    TEST_ASSERT_EQUAL_UINT32(~0x00000008u, status.ok.words[0]);
+    TEST_ASSERT_EQUAL_UINT32(~0x80000100u, status.ok.words[1]);
+
+    // Failed slots keep their previous value
+    TEST_ASSERT_EQUAL_UINT16(1000, registers[0]);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, registers[3]);
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, registers[40]);
+    TEST_ASSERT_EQUAL_UINT16(1062, registers[62]);
+
+    // Next cycle register 3 answers again
+    bank.failing = 0;
+    status = partition<64>([&](size_t i) { return bank.read(i); }, registers);
+    TEST_ASSERT_TRUE(status.allOk());
+    TEST_ASSERT_EQUAL(64, status.firstErrorIndex);
+    TEST_ASSERT_EQUAL_UINT16(1003, registers[3]);
+}
+
+void test_batch_mask_sizes() {
+    TEST_ASSERT_EQUAL(1, BatchMask<1>::kWords);
+    TEST_ASSERT_EQUAL(1, BatchMask<32>::kWords);
+    TEST_ASSERT_EQUAL(2, BatchMask<33>::kWords);
+    TEST_ASSERT_EQUAL(2, BatchMask<64>::kWords);
+    TEST_ASSERT_EQUAL(8, sizeof(BatchMask<64>));
+
+    BatchMask<40> mask;
+    mask.set(0);
+    mask.set(31);
+    mask.set(39);
+    TEST_ASSERT_TRUE(mask.test(31));
+    TEST_ASSERT_TRUE(mask.test(39));
+    TEST_ASSERT_FALSE(mask.test(32));
+    TEST_ASSERT_EQUAL(3, mask.count());
+}
+
+void test_zip_heterogeneous() {
+    auto inputs = zip(Result<uint16_t>::ok(215), Result<float>::ok(1.5f), Result<int32_t>::ok(-40));
+    static_assert(std::is_same_v<decltype(inputs), Result<std::tuple<uint16_t, float, int32_t>>>,
+                  "zip() yields a tuple of the value types");
+    TEST_ASSERT_TRUE(inputs.isOk());
+    auto [temperature, pressure, flow] = std::move(inputs).value();
+    TEST_ASSERT_EQUAL_UINT16(215, temperature);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, pressure);
+    TEST_ASSERT_EQUAL_INT32(-40, flow);
+
+    // The first error in argument order wins
+    auto failed = zip(Result<uint16_t>::ok(1), Result<float>::error(ErrorCode::TIMEOUT),
+                      Result<int32_t>::error(ErrorCode::CRC_ERROR));
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, failed.error());
+
+    // A single Result
+    TEST_ASSERT_EQUAL(7, std::get<0>(zip(Result<int>::ok(7)).value()));
+}
+
+void test_zip_moves_rvalues_and_copies_lvalues() {
+    Result<std::string> name = Result<std::string>::ok(std::string(40, 'n'));
+    auto zipped = zip(name, Result<std::unique_ptr<int>>::ok(std::make_unique<int>(5)));
+    TEST_ASSERT_TRUE(zipped.isOk());
+    TEST_ASSERT_EQUAL(40, std::get<0>(zipped.value()).size());
+    TEST_ASSERT_EQUAL(5, *std::get<1>(zipped.value()));
+    // The lvalue was copied, not moved from
+    TEST_ASSERT_EQUAL(40, name.value().size());
+
+    auto moved = zip(std::move(name), Result<int>::ok(1));
+    TEST_ASSERT_EQUAL(40, std::get<0>(moved.value()).size());
+}
+
+void test_apply() {
+    auto power = apply([](float volts, float amps) { return volts * amps; },
+                       Result<float>::ok(12.0f), Result<float>::ok(0.5f));
+    static_assert(std::is_same_v<decltype(power), Result<float>>, "apply() wraps a plain value");
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, power.value());
+
+    int calls = 0;
+    auto failed = apply([&](float, uint16_t) { ++calls; return 0; },
+                        Result<float>::ok(1.0f), Result<uint16_t>::error(ErrorCode::DEVICE_BUSY));
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_BUSY, failed.error());
+    TEST_ASSERT_EQUAL(0, calls);
+
+    // A function returning a Result is not wrapped again (like andThen)
+    auto checked = apply([](int low, int high) {
+        return low < high ? Result<int>::ok(high - low) : Result<int>::error(ErrorCode::INVALID_PARAMETER);
+    }, Result<int>::ok(3), Result<int>::ok(10));
+    static_assert(std::is_same_v<decltype(checked), Result<int>>, "apply() flattens a Result");
+    TEST_ASSERT_EQUAL(7, checked.value());
+
+    // void becomes Result<void>; rvalue values are moved into the function
+    std::unique_ptr<int> sink;
+    Result<void> stored = apply([&](std::unique_ptr<int> buffer, int offset) {
+        sink = std::move(buffer);
+        *sink += offset;
+    }, Result<std::unique_ptr<int>>::ok(std::make_unique<int>(9)), Result<int>::ok(1));
+    TEST_ASSERT_TRUE(stored.isOk());
+    TEST_ASSERT_EQUAL(10, *sink);
+}
+
+// Test runner
+void runResultAlgorithmsTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_all_over_arrays);
+    RUN_TEST(test_collect_array);
+    RUN_TEST(test_collect_moves_values);
+    RUN_TEST(test_collect_generator_short_circuits);
+    RUN_TEST(test_partition_array);
+    RUN_TEST(test_partition_generator_keeps_going);
+    RUN_TEST(test_batch_mask_sizes);
+    RUN_TEST(test_zip_heterogeneous);
+    RUN_TEST(test_zip_moves_rvalues_and_copies_lvalues);
+    RUN_TEST(test_apply);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Algorithms Tests ===\n");
+    runResultAlgorithmsTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultAlgorithmsTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
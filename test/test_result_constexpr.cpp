@@ -0,0 +1,160 @@
+/**
+ * @file test_result_constexpr.cpp
+ * @brief Compile-time tests for common::Result
+ *
+ * Every operation is exercised inside a static_assert, so this file stops
+ * compiling if any of them loses constexpr-ness. The runtime tests show a
+ * typical use: validating a register map at compile time.
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+enum class TestError {
+    NONE = 0,
+    OUT_OF_RANGE
+};
+
+struct Calibration {
+    int16_t offset;
+    int16_t gain;
+};
+
+constexpr Result<int> half(int x) {
+    if (x % 2 != 0) {
+        return Result<int>::error(ErrorCode::INVALID_PARAMETER);
+    }
+    return Result<int>::ok(x / 2);
+}
+
+// Construction and observers
+static_assert(Result<int>::ok(4).isOk());
+static_assert(Result<int>::ok(4).value() == 4);
+static_assert(Result<int>::error(ErrorCode::TIMEOUT).isError());
+static_assert(Result<int>::error(ErrorCode::TIMEOUT).error() == ErrorCode::TIMEOUT);
+static_assert(!Result<int>::error(ErrorCode::TIMEOUT));
+static_assert(static_cast<bool>(Result<int>(ok_tag, 1)));
+static_assert(Result<int>(err_tag, ErrorCode::BUSY).error() == ErrorCode::BUSY);
+static_assert(Result<Calibration>::emplace(int16_t{-3}, int16_t{100}).value().gain == 100);
+static_assert(Result<Calibration>(in_place, int16_t{1}, int16_t{2}).value().offset == 1);
+static_assert(Result<double>::ok(2.5).value() == 2.5);
+static_assert(Result<int, TestError>::error(TestError::OUT_OF_RANGE).isError());
+
+// valueOr
+static_assert(Result<int>::ok(4).valueOr(0) == 4);
+static_assert(Result<int>::error(ErrorCode::TIMEOUT).valueOr(7) == 7);
+constexpr Result<int> kStoredError = Result<int>::error(ErrorCode::BUSY);
+static_assert(kStoredError.valueOr(9) == 9);
+
+// Monadic operations
+static_assert(Result<int>::ok(8).andThen(half).andThen(half).value() == 2);
+static_assert(Result<int>::ok(6).andThen(half).andThen(half).error() == ErrorCode::INVALID_PARAMETER);
+static_assert(Result<int>::ok(3).map([](int x) { return x * 3; }).value() == 9);
+static_assert(Result<int>::ok(3).transform([](int x) { return x + 1; }).value() == 4);
+static_assert(kStoredError.map([](int x) { return x; }).error() == ErrorCode::BUSY);
+static_assert(kStoredError.mapError([](ErrorCode) { return TestError::OUT_OF_RANGE; }).error() ==
+              TestError::OUT_OF_RANGE);
+static_assert(kStoredError.orElse([](ErrorCode) { return Result<int>::ok(0); }).value() == 0);
+
+// Result<void>
+static_assert(Result<void>::ok().isOk());
+static_assert(Result<void>::error(ErrorCode::IO_ERROR).error() == ErrorCode::IO_ERROR);
+static_assert(Result<void>::ok().map([] { return 5; }).value() == 5);
+static_assert(Result<void>::ok().andThen([] { return half(10); }).value() == 5);
+static_assert(Result<void, TestError>::error(TestError::OUT_OF_RANGE).isError());
+
+// Result<T&>
+constexpr int kRegister = 42;
+static_assert(Result<const int&>::ok(kRegister).value() == 42);
+static_assert(&Result<const int&>::ok(kRegister).value() == &kRegister);
+static_assert(Result<const int&>::error(ErrorCode::DEVICE_NOT_FOUND).valueOr(kRegister) == 42);
+static_assert(Result<const int&>::ok(kRegister).map([](const int& r) { return r + 1; }).value() == 43);
+
+// Helpers
+static_assert(makeOk<int>(3).value() == 3);
+static_assert(makeOk<>().isOk());
+static_assert(makeError<int>(ErrorCode::CRC_ERROR).error() == ErrorCode::CRC_ERROR);
+
+// Example: validate a register map at compile time
+struct RegisterDef {
+    uint16_t address;
+    uint16_t count;
+};
+
+constexpr RegisterDef kRegisterMap[] = {
+    {0x0000, 2},
+    {0x0002, 4},
+    {0x0010, 1},
+};
+
+template<size_t N>
+constexpr Result<void> validateRegisterMap(const RegisterDef (&map)[N]) {
+    for (size_t i = 1; i < N; ++i) {
+        if (map[i].address < map[i - 1].address + map[i - 1].count) {
+            return Result<void>::error(ErrorCode::INVALID_DATA);
+        }
+    }
+    return Result<void>::ok();
+}
+
+static_assert(validateRegisterMap(kRegisterMap).isOk(), "register map entries overlap");
+
+constexpr RegisterDef kOverlappingMap[] = {
+    {0x0000, 4},
+    {0x0002, 1},
+};
+
+static_assert(validateRegisterMap(kOverlappingMap).error() == ErrorCode::INVALID_DATA);
+
+} // namespace
+
+void test_constexpr_value_is_folded() {
+    constexpr auto result = half(42);
+
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(21, result.value());
+}
+
+void test_constexpr_register_map_validation() {
+    constexpr auto valid = validateRegisterMap(kRegisterMap);
+    constexpr auto invalid = validateRegisterMap(kOverlappingMap);
+
+    TEST_ASSERT_TRUE(valid.isOk());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, invalid.error());
+}
+
+// Test runner
+void runResultConstexprTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_constexpr_value_is_folded);
+    RUN_TEST(test_constexpr_register_map_validation);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Constexpr Tests ===\n");
+    runResultConstexprTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultConstexprTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
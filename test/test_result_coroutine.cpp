@@ -0,0 +1,233 @@
+/**
+ * @file test_result_coroutine.cpp
+ * @brief Unit tests for Result coroutines (ResultCoroutine.h)
+ *
+ * Needs C++20; run with: pio test -e native_cxx20. Under C++17 the suite
+ * builds and runs no tests.
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include "../src/ResultCoroutine.h"
+
+using namespace common;
+
+#if LIBCOMMON_HAS_RESULT_COROUTINES
+
+#include <string>
+
+namespace {
+
+int g_stepsRun = 0;
+
+Result<uint16_t> readRegister(uint8_t reg) {
+    if (reg == 0xFF) {
+        return Result<uint16_t>::error(ErrorCode::DEVICE_NOT_FOUND);
+    }
+    return Result<uint16_t>::ok(static_cast<uint16_t>(reg * 10));
+}
+
+Result<void> checkRange(uint16_t raw) {
+    if (raw > 1000) {
+        return Result<void>::error(ErrorCode::INVALID_DATA);
+    }
+    return Result<void>::ok();
+}
+
+Result<float> readTemperature(uint8_t reg) {
+    uint16_t raw = co_await readRegister(reg);
+    ++g_stepsRun;
+    co_await checkRange(raw);
+    ++g_stepsRun;
+    co_return raw * 0.5f;
+}
+
+Result<void> configure(uint8_t reg) {
+    float temperature = co_await readTemperature(reg);
+    if (temperature < 1.0f) {
+        co_await makeFailure(ErrorCode::INVALID_PARAMETER);
+    }
+}
+
+Result<std::string> describe(uint8_t reg) {
+    float temperature = co_await readTemperature(reg);
+    co_return std::to_string(static_cast<int>(temperature));
+}
+
+Result<int> failDirectly() {
+    co_return makeFailure(ErrorCode::TIMEOUT);
+}
+
+Result<int> returnResult(bool ok) {
+    co_return ok ? Result<int>::ok(7) : Result<int>::error(ErrorCode::BUSY);
+}
+
+// Counts live instances to verify the awaited values are destroyed
+struct Tracked {
+    static int live;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    ~Tracked() { --live; }
+
+    int value;
+};
+
+int Tracked::live = 0;
+
+Result<Tracked> makeTracked(int v) {
+    if (v < 0) {
+        return Result<Tracked>::error(ErrorCode::INVALID_PARAMETER);
+    }
+    return Result<Tracked>::emplace(v);
+}
+
+Result<Tracked> doubleTracked(int v) {
+    Tracked t = co_await makeTracked(v);
+    co_return Tracked(t.value * 2);
+}
+
+} // namespace
+
+void test_coroutine_success() {
+    g_stepsRun = 0;
+    auto result = readTemperature(20);
+
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, result.value());
+    TEST_ASSERT_EQUAL(2, g_stepsRun);
+}
+
+void test_coroutine_first_await_fails() {
+    g_stepsRun = 0;
+    auto result = readTemperature(0xFF);
+
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, result.error());
+    TEST_ASSERT_EQUAL(0, g_stepsRun);
+}
+
+void test_coroutine_void_await_fails() {
+    g_stepsRun = 0;
+    auto result = readTemperature(200);
+
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, result.error());
+    TEST_ASSERT_EQUAL(1, g_stepsRun);
+}
+
+void test_coroutine_void_result() {
+    TEST_ASSERT_TRUE(configure(20).isOk());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_PARAMETER, configure(0).error());
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, configure(0xFF).error());
+}
+
+void test_coroutine_non_trivial_value() {
+    auto result = describe(20);
+
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL_STRING("100", result.value().c_str());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, describe(200).error());
+}
+
+void test_coroutine_co_return_failure_and_result() {
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, failDirectly().error());
+    TEST_ASSERT_EQUAL(7, returnResult(true).value());
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, returnResult(false).error());
+}
+
+void test_coroutine_lvalue_await() {
+    auto inner = Result<int>::ok(5);
+    auto outer = [&]() -> Result<int> {
+        int v = co_await inner;
+        co_return v + 1;
+    }();
+
+    TEST_ASSERT_EQUAL(6, outer.value());
+    TEST_ASSERT_EQUAL(5, inner.value());
+}
+
+void test_coroutine_no_leaks() {
+    Tracked::live = 0;
+    {
+        auto ok = doubleTracked(4);
+        TEST_ASSERT_EQUAL(8, ok.value().value);
+        TEST_ASSERT_EQUAL(1, Tracked::live);
+
+        auto failed = doubleTracked(-1);
+        TEST_ASSERT_TRUE(failed.isError());
+        TEST_ASSERT_EQUAL(1, Tracked::live);
+    }
+    TEST_ASSERT_EQUAL(0, Tracked::live);
+}
+
+void test_coroutine_static_arena() {
+    static StaticFrameArena<4096> arena;
+    setFrameAllocator(arena.allocator());
+
+    auto ok = configure(20);
+    auto failed = configure(0xFF);
+
+    resetFrameAllocator();
+
+    TEST_ASSERT_TRUE(ok.isOk());
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, failed.error());
+    TEST_ASSERT_EQUAL(0, arena.used());
+    TEST_ASSERT_GREATER_THAN(0, arena.highWater());
+}
+
+void test_coroutine_arena_exhausted() {
+    static StaticFrameArena<16> arena;
+    setFrameAllocator(arena.allocator());
+
+    auto result = readTemperature(20);
+
+    resetFrameAllocator();
+
+    TEST_ASSERT_TRUE(result.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::OUT_OF_MEMORY, result.error());
+}
+
+#endif // LIBCOMMON_HAS_RESULT_COROUTINES
+
+// Test runner
+void runResultCoroutineTests() {
+    UNITY_BEGIN();
+
+#if LIBCOMMON_HAS_RESULT_COROUTINES
+    RUN_TEST(test_coroutine_success);
+    RUN_TEST(test_coroutine_first_await_fails);
+    RUN_TEST(test_coroutine_void_await_fails);
+    RUN_TEST(test_coroutine_void_result);
+    RUN_TEST(test_coroutine_non_trivial_value);
+    RUN_TEST(test_coroutine_co_return_failure_and_result);
+    RUN_TEST(test_coroutine_lvalue_await);
+    RUN_TEST(test_coroutine_no_leaks);
+    RUN_TEST(test_coroutine_static_arena);
+    RUN_TEST(test_coroutine_arena_exhausted);
+#endif
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Coroutine Tests ===\n");
+    runResultCoroutineTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultCoroutineTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
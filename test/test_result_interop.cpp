@@ -0,0 +1,179 @@
+/**
+ * @file test_result_interop.cpp
+ * @brief Unit tests for conversions between Result and std::optional / std::expected
+ *
+ * The std::expected tests need C++23 (pio test -e native_cxx23).
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <memory>
+#include <optional>
+#include "../src/LibraryCommon.h"
+
+using namespace common;
+
+namespace {
+
+struct Tracked {
+    static int copies;
+    static int moves;
+    int value;
+
+    explicit Tracked(int v) : value(v) {}
+    Tracked(const Tracked& other) : value(other.value) { ++copies; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++moves; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+};
+
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+void resetCounts() {
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+}
+
+std::optional<uint16_t> lookupAddress(bool found) {
+    return found ? std::optional<uint16_t>(0x40) : std::nullopt;
+}
+
+#if LIBCOMMON_HAS_STD_EXPECTED
+std::expected<float, ErrorCode> hostReadPressure(bool ok) {
+    if (ok) {
+        return 1013.25f;
+    }
+    return std::unexpected(ErrorCode::TIMEOUT);
+}
+
+// A std::expected converts implicitly where a Result is returned
+Result<float> readPressure(bool ok) {
+    return hostReadPressure(ok);
+}
+#endif
+
+} // namespace
+
+void test_interop_to_optional() {
+    auto value = Result<uint16_t>::ok(7).toOptional();
+    TEST_ASSERT_TRUE(value.has_value());
+    TEST_ASSERT_EQUAL_UINT16(7, *value);
+    TEST_ASSERT_FALSE(Result<uint16_t>::error(ErrorCode::TIMEOUT).toOptional().has_value());
+
+    // Rvalues move the value out, lvalues copy it
+    resetCounts();
+    auto tracked = Result<Tracked>::emplace(5);
+    auto copied = tracked.toOptional();
+    TEST_ASSERT_EQUAL(1, Tracked::copies);
+    TEST_ASSERT_EQUAL(5, copied->value);
+    auto moved = std::move(tracked).toOptional();
+    TEST_ASSERT_EQUAL(1, Tracked::copies);
+    TEST_ASSERT_EQUAL(1, Tracked::moves);
+    TEST_ASSERT_EQUAL(5, moved->value);
+
+    auto owned = Result<std::unique_ptr<int>>::ok(std::make_unique<int>(3)).toOptional();
+    TEST_ASSERT_EQUAL(3, **owned);
+}
+
+void test_interop_from_optional() {
+    Result<uint16_t> found(lookupAddress(true), ErrorCode::DEVICE_NOT_FOUND);
+    TEST_ASSERT_TRUE(found.isOk());
+    TEST_ASSERT_EQUAL_UINT16(0x40, found.value());
+
+    Result<uint16_t> missing(lookupAddress(false), ErrorCode::DEVICE_NOT_FOUND);
+    TEST_ASSERT_TRUE(missing.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, missing.error());
+
+    resetCounts();
+    std::optional<Tracked> source(std::in_place, 9);
+    Result<Tracked> moved(std::move(source), ErrorCode::INVALID_STATE);
+    TEST_ASSERT_EQUAL(9, moved.value().value);
+    TEST_ASSERT_EQUAL(0, Tracked::copies);
+    TEST_ASSERT_EQUAL(1, Tracked::moves);
+
+    Result<std::unique_ptr<int>> owned(std::optional<std::unique_ptr<int>>(std::make_unique<int>(4)),
+                                       ErrorCode::OUT_OF_MEMORY);
+    TEST_ASSERT_EQUAL(4, *owned.value());
+}
+
+#if LIBCOMMON_HAS_STD_EXPECTED
+void test_interop_to_expected() {
+    std::expected<uint16_t, ErrorCode> value = Result<uint16_t>::ok(0x1234).toExpected();
+    TEST_ASSERT_TRUE(value.has_value());
+    TEST_ASSERT_EQUAL_UINT16(0x1234, *value);
+
+    auto failed = Result<uint16_t>::error(ErrorCode::CRC_ERROR).toExpected();
+    TEST_ASSERT_FALSE(failed.has_value());
+    TEST_ASSERT_EQUAL(ErrorCode::CRC_ERROR, failed.error());
+
+    std::expected<void, ErrorCode> done = Result<void>::ok().toExpected();
+    TEST_ASSERT_TRUE(done.has_value());
+    TEST_ASSERT_EQUAL(ErrorCode::SEND_FAILED, Result<void>::error(ErrorCode::SEND_FAILED).toExpected().error());
+
+    resetCounts();
+    auto tracked = Result<Tracked>::emplace(6);
+    auto copied = tracked.toExpected();
+    auto moved = std::move(tracked).toExpected();
+    TEST_ASSERT_EQUAL(1, Tracked::copies);
+    TEST_ASSERT_EQUAL(6, copied->value);
+    TEST_ASSERT_EQUAL(6, moved->value);
+}
+
+void test_interop_from_expected() {
+    auto pressure = readPressure(true);
+    TEST_ASSERT_TRUE(pressure.isOk());
+    TEST_ASSERT_EQUAL_FLOAT(1013.25f, pressure.value());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, readPressure(false).error());
+
+    Result<void> done = std::expected<void, ErrorCode>();
+    TEST_ASSERT_TRUE(done.isOk());
+    Result<void> failed = std::expected<void, ErrorCode>(std::unexpect, ErrorCode::BUSY);
+    TEST_ASSERT_EQUAL(ErrorCode::BUSY, failed.error());
+
+    resetCounts();
+    std::expected<Tracked, ErrorCode> source(std::in_place, 8);
+    Result<Tracked> moved = std::move(source);
+    TEST_ASSERT_EQUAL(8, moved.value().value);
+    TEST_ASSERT_EQUAL(0, Tracked::copies);
+
+    // Round trip keeps move-only values
+    Result<std::unique_ptr<int>> owned = Result<std::unique_ptr<int>>::ok(std::make_unique<int>(2)).toExpected();
+    TEST_ASSERT_EQUAL(2, *owned.value());
+}
+#endif
+
+// Test runner
+void runResultInteropTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_interop_to_optional);
+    RUN_TEST(test_interop_from_optional);
+#if LIBCOMMON_HAS_STD_EXPECTED
+    RUN_TEST(test_interop_to_expected);
+    RUN_TEST(test_interop_from_expected);
+#endif
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Interop Tests ===\n");
+    runResultInteropTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultInteropTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,236 @@
+/**
+ * @file test_result_monadic.cpp
+ * @brief Unit tests for the move-aware monadic API of common::Result
+ *
+ * The payloads allocate through a counting allocator so the tests can
+ * prove that rvalue pipelines move their payload from stage to stage
+ * without allocating.
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+size_t g_allocations = 0;
+
+// std::allocator that counts allocations
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++g_allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+using Text = std::basic_string<char, std::char_traits<char>, CountingAllocator<char>>;
+
+enum class FrameError {
+    NONE = 0,
+    SHORT_FRAME,
+    BAD_CRC
+};
+
+using Frame = std::vector<uint8_t, CountingAllocator<uint8_t>>;
+
+struct Reading {
+    uint8_t address;
+    Frame payload;
+};
+
+Result<Frame> readFrame(bool fail) {
+    if (fail) {
+        return Result<Frame>::error(ErrorCode::TIMEOUT);
+    }
+    return Result<Frame>::ok(Frame{0x01, 0x03, 0x02, 0x00, 0x2A, 0x30});
+}
+
+Result<Frame> checkCrc(Frame&& frame) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        sum = static_cast<uint8_t>(sum + frame[i]);
+    }
+    if (sum != frame.back()) {
+        return Result<Frame>::error(ErrorCode::CRC_ERROR);
+    }
+    frame.pop_back();
+    return Result<Frame>::ok(std::move(frame));
+}
+
+Reading parse(Frame&& frame) {
+    return Reading{frame.front(), std::move(frame)};
+}
+
+} // namespace
+
+void test_rvalue_pipeline_does_not_allocate() {
+    auto frame = readFrame(false);
+    const size_t before = g_allocations;
+
+    auto reading = std::move(frame).andThen(checkCrc).map(parse);
+
+    TEST_ASSERT_EQUAL(before, g_allocations);
+    TEST_ASSERT_TRUE(reading.isOk());
+    TEST_ASSERT_EQUAL(0x01, reading.value().address);
+    TEST_ASSERT_EQUAL(5, reading.value().payload.size());
+}
+
+void test_lvalue_pipeline_copies() {
+    auto frame = readFrame(false);
+    const size_t before = g_allocations;
+
+    auto copy = frame.map([](const Frame& f) { return f; });
+
+    TEST_ASSERT_EQUAL(before + 1, g_allocations);
+    TEST_ASSERT_TRUE(frame.isOk());
+    TEST_ASSERT_EQUAL(6, frame.value().size());
+    TEST_ASSERT_EQUAL(6, copy.value().size());
+}
+
+void test_rvalue_pipeline_error_short_circuits() {
+    bool parsed = false;
+    auto reading = readFrame(true)
+        .andThen(checkCrc)
+        .map([&parsed](Frame&& f) { parsed = true; return parse(std::move(f)); });
+
+    TEST_ASSERT_FALSE(parsed);
+    TEST_ASSERT_TRUE(reading.isError());
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, reading.error());
+}
+
+void test_transform_moves_string() {
+    auto text = Result<Text>::ok(Text("sensor value out of range"));
+    const size_t before = g_allocations;
+
+    auto length = std::move(text)
+        .transform([](Text&& s) { return std::move(s); })
+        .transform([](Text&& s) { return s.size(); });
+
+    TEST_ASSERT_EQUAL(before, g_allocations);
+    TEST_ASSERT_EQUAL(25, length.value());
+}
+
+void test_map_error_moves_value() {
+    auto text = Result<Text>::ok(Text("long enough to avoid SSO buffer"));
+    const size_t before = g_allocations;
+
+    auto mapped = std::move(text).mapError([](ErrorCode) { return FrameError::BAD_CRC; });
+
+    TEST_ASSERT_EQUAL(before, g_allocations);
+    TEST_ASSERT_TRUE(mapped.isOk());
+}
+
+void test_map_error_converts_error() {
+    auto result = Result<int>::error(ErrorCode::CRC_ERROR);
+
+    auto mapped = result.mapError([](ErrorCode code) {
+        return code == ErrorCode::CRC_ERROR ? FrameError::BAD_CRC : FrameError::SHORT_FRAME;
+    });
+
+    TEST_ASSERT_TRUE(mapped.isError());
+    TEST_ASSERT_EQUAL(FrameError::BAD_CRC, mapped.error());
+}
+
+void test_or_else_recovers() {
+    auto result = Result<int>::error(ErrorCode::TIMEOUT);
+
+    auto recovered = result.orElse([](ErrorCode code) {
+        return code == ErrorCode::TIMEOUT ? Result<int>::ok(-1) : Result<int>::error(code);
+    });
+
+    TEST_ASSERT_TRUE(recovered.isOk());
+    TEST_ASSERT_EQUAL(-1, recovered.value());
+}
+
+void test_or_else_passes_value_through() {
+    auto frame = readFrame(false);
+    const size_t before = g_allocations;
+
+    auto result = std::move(frame).orElse([](ErrorCode) { return readFrame(false); });
+
+    TEST_ASSERT_EQUAL(before, g_allocations);
+    TEST_ASSERT_EQUAL(6, result.value().size());
+}
+
+void test_map_to_void() {
+    int calls = 0;
+    auto result = Result<int>::ok(3).map([&calls](int x) { calls += x; });
+
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(3, calls);
+}
+
+void test_void_monadic_chain() {
+    auto value = Result<void>::ok()
+        .andThen([] { return Result<void>::ok(); })
+        .map([] { return 42; });
+
+    TEST_ASSERT_TRUE(value.isOk());
+    TEST_ASSERT_EQUAL(42, value.value());
+
+    auto recovered = Result<void>::error(ErrorCode::BUSY)
+        .mapError([](ErrorCode) { return FrameError::SHORT_FRAME; })
+        .orElse([](FrameError) { return Result<void, FrameError>::ok(); });
+
+    TEST_ASSERT_TRUE(recovered.isOk());
+}
+
+// Test runner
+void runResultMonadicTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rvalue_pipeline_does_not_allocate);
+    RUN_TEST(test_lvalue_pipeline_copies);
+    RUN_TEST(test_rvalue_pipeline_error_short_circuits);
+    RUN_TEST(test_transform_moves_string);
+    RUN_TEST(test_map_error_moves_value);
+    RUN_TEST(test_map_error_converts_error);
+    RUN_TEST(test_or_else_recovers);
+    RUN_TEST(test_or_else_passes_value_through);
+    RUN_TEST(test_map_to_void);
+    RUN_TEST(test_void_monadic_chain);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Monadic Tests ===\n");
+    runResultMonadicTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultMonadicTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,177 @@
+/**
+ * @file test_result_reference.cpp
+ * @brief Unit tests for the Result<T&> and Result<const T&> specializations
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+// Device that counts how often it is copied
+struct Device {
+    static int copies;
+
+    explicit Device(uint8_t addr) : address(addr) {}
+    Device(const Device& other) : address(other.address), polls(other.polls) { ++copies; }
+    Device& operator=(const Device&) = delete;
+
+    uint8_t address;
+    int polls = 0;
+};
+
+int Device::copies = 0;
+
+Device g_devices[] = {Device(0x01), Device(0x10), Device(0x22)};
+
+Result<Device&> findDevice(uint8_t address) {
+    for (auto& device : g_devices) {
+        if (device.address == address) {
+            return Result<Device&>::ok(device);
+        }
+    }
+    return Result<Device&>::error(ErrorCode::DEVICE_NOT_FOUND);
+}
+
+Result<const Device&> findConstDevice(uint8_t address) {
+    return findDevice(address).andThen([](Device& d) { return Result<const Device&>::ok(d); });
+}
+
+} // namespace
+
+// A Result<const T&> must not bind a temporary
+static_assert(!std::is_constructible_v<Result<const int&>, int&&>);
+static_assert(!std::is_constructible_v<Result<const int&>, SuccessTag, int&&>);
+static_assert(std::is_constructible_v<Result<const int&>, const int&>);
+
+// makeOk() always holds a value; makeRef() refers
+static_assert(std::is_same_v<decltype(makeOk(std::declval<int&>())), Result<int>>);
+static_assert(std::is_same_v<decltype(makeRef(std::declval<int&>())), Result<int&>>);
+static_assert(std::is_same_v<decltype(makeRef(std::declval<const int&>())), Result<const int&>>);
+
+void test_reference_ok_refers_to_original() {
+    Device::copies = 0;
+    auto device = findDevice(0x10);
+
+    TEST_ASSERT_TRUE(device.isOk());
+    TEST_ASSERT_EQUAL_PTR(&g_devices[1], &device.value());
+
+    device.value().polls++;
+    TEST_ASSERT_EQUAL(1, g_devices[1].polls);
+    TEST_ASSERT_EQUAL(0, Device::copies);
+}
+
+void test_reference_make_ref() {
+    Device::copies = 0;
+    auto device = makeRef(g_devices[2]);
+    auto copy = makeOk(g_devices[2]);
+
+    TEST_ASSERT_EQUAL_PTR(&g_devices[2], &device.value());
+    TEST_ASSERT_EQUAL(0x22, copy.value().address);
+    TEST_ASSERT_EQUAL(1, Device::copies);
+}
+
+void test_reference_error() {
+    auto device = findDevice(0x7F);
+
+    TEST_ASSERT_TRUE(device.isError());
+    TEST_ASSERT_FALSE(static_cast<bool>(device));
+    TEST_ASSERT_EQUAL(ErrorCode::DEVICE_NOT_FOUND, device.error());
+}
+
+void test_reference_copy_does_not_copy_object() {
+    Device::copies = 0;
+    auto device = findDevice(0x01);
+    auto copy = device;
+
+    TEST_ASSERT_EQUAL_PTR(&device.value(), &copy.value());
+    TEST_ASSERT_EQUAL(0, Device::copies);
+}
+
+void test_reference_value_or() {
+    Device fallback(0xFF);
+
+    TEST_ASSERT_EQUAL_PTR(&fallback, &findDevice(0x7F).valueOr(fallback));
+    TEST_ASSERT_EQUAL_PTR(&g_devices[2], &findDevice(0x22).valueOr(fallback));
+}
+
+void test_reference_map() {
+    Device::copies = 0;
+    auto address = findDevice(0x22).map([](Device& d) { return d.address; });
+
+    TEST_ASSERT_TRUE(address.isOk());
+    TEST_ASSERT_EQUAL(0x22, address.value());
+    TEST_ASSERT_EQUAL(0, Device::copies);
+}
+
+void test_reference_and_then() {
+    auto polls = findDevice(0x01).andThen([](Device& d) {
+        d.polls += 2;
+        return Result<int>::ok(d.polls);
+    });
+
+    TEST_ASSERT_EQUAL(2, polls.value());
+    TEST_ASSERT_EQUAL(2, g_devices[0].polls);
+}
+
+void test_reference_const() {
+    Device::copies = 0;
+    auto device = findConstDevice(0x10);
+
+    TEST_ASSERT_TRUE(device.isOk());
+    TEST_ASSERT_EQUAL_PTR(&g_devices[1], &device.value());
+    TEST_ASSERT_EQUAL(0, Device::copies);
+}
+
+void test_reference_or_else() {
+    auto device = findDevice(0x7F).orElse([](ErrorCode) { return findDevice(0x01); });
+
+    TEST_ASSERT_EQUAL_PTR(&g_devices[0], &device.value());
+}
+
+void test_reference_layout() {
+    TEST_ASSERT_TRUE(std::is_trivially_copyable_v<Result<Device&>>);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * sizeof(void*), sizeof(Result<Device&>));
+}
+
+// Test runner
+void runResultReferenceTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_reference_ok_refers_to_original);
+    RUN_TEST(test_reference_make_ref);
+    RUN_TEST(test_reference_error);
+    RUN_TEST(test_reference_copy_does_not_copy_object);
+    RUN_TEST(test_reference_value_or);
+    RUN_TEST(test_reference_map);
+    RUN_TEST(test_reference_and_then);
+    RUN_TEST(test_reference_const);
+    RUN_TEST(test_reference_or_else);
+    RUN_TEST(test_reference_layout);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Reference Tests ===\n");
+    runResultReferenceTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultReferenceTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
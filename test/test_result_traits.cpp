@@ -0,0 +1,165 @@
+/**
+ * @file test_result_traits.cpp
+ * @brief Type-trait matrix for common::Result
+ *
+ * Result must be exactly as trivial as its payload: trivially copyable and
+ * destructible when T and E are, and still correct (but non-trivial) when
+ * they are not. The static_asserts fail the build on regressions; the
+ * runtime tests repeat them so the matrix shows up in the test report.
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <memory>
+#include <string>
+#include "../src/Result.h"
+
+using namespace common;
+
+namespace {
+
+enum class TestError {
+    NONE = 0,
+    FAILED
+};
+
+struct Vec3 {
+    float x;
+    float y;
+    float z;
+};
+
+struct UserCopy {
+    UserCopy() = default;
+    UserCopy(const UserCopy&) {}
+    int value = 0;
+};
+
+struct UserDestructor {
+    ~UserDestructor() {}
+    int value = 0;
+};
+
+template<typename R>
+constexpr bool isFullyTrivial() {
+    return std::is_trivially_copyable_v<R> &&
+           std::is_trivially_copy_constructible_v<R> &&
+           std::is_trivially_move_constructible_v<R> &&
+           std::is_trivially_copy_assignable_v<R> &&
+           std::is_trivially_move_assignable_v<R> &&
+           std::is_trivially_destructible_v<R>;
+}
+
+} // namespace
+
+// Trivial payloads -> trivial Result (std::expected storage has
+// non-trivial assignment, so only the library's own layouts are checked)
+#if !LIBCOMMON_EXPECTED_STORAGE
+static_assert(isFullyTrivial<Result<void>>());
+static_assert(isFullyTrivial<Result<bool>>());
+static_assert(isFullyTrivial<Result<uint8_t>>());
+static_assert(isFullyTrivial<Result<uint16_t>>());
+static_assert(isFullyTrivial<Result<int32_t>>());
+static_assert(isFullyTrivial<Result<float>>());
+static_assert(isFullyTrivial<Result<double>>());
+static_assert(isFullyTrivial<Result<int64_t>>());
+static_assert(isFullyTrivial<Result<Vec3>>());
+static_assert(isFullyTrivial<Result<int*>>());
+static_assert(isFullyTrivial<Result<void, TestError>>());
+static_assert(isFullyTrivial<Result<int, TestError>>());
+static_assert(isFullyTrivial<Result<Vec3, TestError>>());
+#endif
+
+// Non-trivial payloads -> non-trivial but well-formed Result
+static_assert(!std::is_trivially_copy_constructible_v<Result<UserCopy>>);
+static_assert(std::is_trivially_destructible_v<Result<UserCopy>>);
+static_assert(std::is_copy_constructible_v<Result<UserCopy>>);
+static_assert(!std::is_trivially_destructible_v<Result<UserDestructor>>);
+static_assert(!std::is_trivially_destructible_v<Result<std::string>>);
+static_assert(std::is_nothrow_move_constructible_v<Result<std::string>>);
+
+// Move-only payloads -> move-only Result
+static_assert(!std::is_copy_constructible_v<Result<std::unique_ptr<int>>>);
+static_assert(!std::is_copy_assignable_v<Result<std::unique_ptr<int>>>);
+static_assert(std::is_nothrow_move_constructible_v<Result<std::unique_ptr<int>>>);
+static_assert(std::is_move_assignable_v<Result<std::unique_ptr<int>>>);
+
+#if !LIBCOMMON_EXPECTED_STORAGE
+void test_traits_trivial_scalars() {
+    TEST_ASSERT_TRUE(isFullyTrivial<Result<uint16_t>>());
+    TEST_ASSERT_TRUE(isFullyTrivial<Result<float>>());
+    TEST_ASSERT_TRUE(isFullyTrivial<Result<double>>());
+    TEST_ASSERT_TRUE(isFullyTrivial<Result<int64_t>>());
+}
+
+void test_traits_trivial_aggregates() {
+    TEST_ASSERT_TRUE(isFullyTrivial<Result<Vec3>>());
+    TEST_ASSERT_TRUE((isFullyTrivial<Result<Vec3, TestError>>()));
+}
+#endif
+
+void test_traits_non_trivial_payloads() {
+    TEST_ASSERT_FALSE(isFullyTrivial<Result<UserCopy>>());
+    TEST_ASSERT_FALSE(isFullyTrivial<Result<UserDestructor>>());
+    TEST_ASSERT_FALSE(isFullyTrivial<Result<std::string>>());
+}
+
+void test_traits_non_trivial_copy_semantics() {
+    auto original = Result<std::string>::ok(std::string("holding register"));
+    auto copy = original;
+    auto moved = std::move(copy);
+
+    TEST_ASSERT_EQUAL_STRING("holding register", original.value().c_str());
+    TEST_ASSERT_EQUAL_STRING("holding register", moved.value().c_str());
+
+    moved = Result<std::string>::error(ErrorCode::TIMEOUT);
+    TEST_ASSERT_TRUE(moved.isError());
+}
+
+void test_traits_move_only_payload() {
+    TEST_ASSERT_FALSE(std::is_copy_constructible_v<Result<std::unique_ptr<int>>>);
+    TEST_ASSERT_FALSE(std::is_copy_assignable_v<Result<std::unique_ptr<int>>>);
+
+    auto original = Result<std::unique_ptr<int>>::ok(std::make_unique<int>(42));
+    auto moved = std::move(original);
+    TEST_ASSERT_EQUAL(42, *moved.value());
+
+    moved = Result<std::unique_ptr<int>>::error(ErrorCode::TIMEOUT);
+    TEST_ASSERT_TRUE(moved.isError());
+}
+
+// Test runner
+void runResultTraitsTests() {
+    UNITY_BEGIN();
+
+#if !LIBCOMMON_EXPECTED_STORAGE
+    RUN_TEST(test_traits_trivial_scalars);
+    RUN_TEST(test_traits_trivial_aggregates);
+#endif
+    RUN_TEST(test_traits_non_trivial_payloads);
+    RUN_TEST(test_traits_non_trivial_copy_semantics);
+    RUN_TEST(test_traits_move_only_payload);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Traits Tests ===\n");
+    runResultTraitsTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultTraitsTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,314 @@
+/**
+ * @file test_result_wire.cpp
+ * @brief Unit tests for the Result wire encoding (ResultWire.h)
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "../src/LibraryCommon.h"
+#include "../src/ResultWire.h"
+
+using namespace common;
+
+namespace {
+
+enum class Mode : uint8_t { IDLE = 0, RUN = 1, FAULT = 200 };
+enum class LinkError : int8_t { NONE = 0, LOST = -3, NOISE = 7 };
+
+static_assert(maxWireSize<uint16_t>() == 3, "17-bit tag");
+static_assert(maxWireSize<int32_t>() == 5, "33-bit tag");
+static_assert(maxWireSize<float>() == 5, "tag + 4 bytes");
+static_assert(maxWireSize<double>() == 9, "tag + 8 bytes");
+static_assert(maxWireSize<uint64_t>() == 11, "tag + 10-byte varint");
+static_assert(maxWireSize<void>() == 3, "ErrorCode error tag");
+static_assert(maxWireSize<bool, LinkError>() == 2, "9-bit tags");
+
+// Non-zero starting error for decode targets (0 reads as success for ErrorCode)
+template<typename E>
+E staleError();
+template<>
+ErrorCode staleError<ErrorCode>() { return ErrorCode::INVALID_STATE; }
+template<>
+LinkError staleError<LinkError>() { return LinkError::NOISE; }
+
+uint32_t g_random = 0x12345678;
+
+uint32_t nextRandom() {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return g_random;
+}
+
+uint64_t nextRandom64() {
+    return (static_cast<uint64_t>(nextRandom()) << 32) | nextRandom();
+}
+
+template<typename T, typename E>
+bool sameResult(const Result<T, E>& a, const Result<T, E>& b) {
+    if (a.isError() || b.isError()) {
+        return a.isError() && b.isError() && a.error() == b.error();
+    }
+    if constexpr (std::is_void_v<T>) {
+        return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // Bit-exact, so NaN payloads and -0.0 count
+        const T x = a.value();
+        const T y = b.value();
+        return std::memcmp(&x, &y, sizeof(T)) == 0;
+    } else {
+        return a.value() == b.value();
+    }
+}
+
+template<typename T, typename E>
+bool roundTrips(const Result<T, E>& original) {
+    uint8_t buffer[maxWireSize<T, E>()];
+    auto written = encodeResult(original, buffer, sizeof(buffer));
+    if (written.isError()) {
+        return false;
+    }
+    Result<T, E> decoded = Result<T, E>::error(staleError<E>());
+    auto consumed = decodeResult(buffer, written.value(), decoded);
+    return consumed.isOk() && consumed.value() == written.value() && sameResult(original, decoded);
+}
+
+// Whatever decodes must re-encode to something that decodes the same
+template<typename T, typename E>
+bool decodesConsistently(const uint8_t* bytes, size_t size) {
+    Result<T, E> decoded = Result<T, E>::error(staleError<E>());
+    auto consumed = decodeResult(bytes, size, decoded);
+    if (consumed.isError()) {
+        return consumed.error() == ErrorCode::BUFFER_UNDERFLOW || consumed.error() == ErrorCode::INVALID_DATA;
+    }
+    return consumed.value() <= size && roundTrips(decoded);
+}
+
+} // namespace
+
+void test_wire_exact_bytes() {
+    uint8_t buffer[16];
+
+    TEST_ASSERT_EQUAL(1, encodeResult(Result<uint16_t>::ok(5), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0x0A, buffer[0]);
+
+    TEST_ASSERT_EQUAL(1, encodeResult(Result<int32_t>::ok(-1), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0x02, buffer[0]);
+
+    TEST_ASSERT_EQUAL(2, encodeResult(Result<uint16_t>::ok(0x1234), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0xE8, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x48, buffer[1]);
+
+    TEST_ASSERT_EQUAL(3, encodeResult(Result<uint16_t>::ok(0xFFFF), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0xFE, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x07, buffer[2]);
+
+    // TIMEOUT = 30: zigzag 60, tag 121
+    TEST_ASSERT_EQUAL(1, encodeResult(Result<float>::error(ErrorCode::TIMEOUT), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0x79, buffer[0]);
+
+    TEST_ASSERT_EQUAL(5, encodeResult(Result<float>::ok(1.0f), buffer, sizeof(buffer)).value());
+    const uint8_t one[] = {0x00, 0x00, 0x00, 0x80, 0x3F};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(one, buffer, sizeof(one));
+
+    TEST_ASSERT_EQUAL(1, encodeResult(Result<void>::ok(), buffer, sizeof(buffer)).value());
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[0]);
+}
+
+void test_wire_round_trip_types() {
+    TEST_ASSERT_TRUE(roundTrips(Result<float>::ok(-273.15f)));
+    TEST_ASSERT_TRUE(roundTrips(Result<float>::ok(-0.0f)));
+    TEST_ASSERT_TRUE(roundTrips(Result<float>::ok(std::numeric_limits<float>::infinity())));
+    TEST_ASSERT_TRUE(roundTrips(Result<float>::ok(std::numeric_limits<float>::quiet_NaN())));
+    TEST_ASSERT_TRUE(roundTrips(Result<double>::ok(1e300)));
+    TEST_ASSERT_TRUE(roundTrips(Result<int8_t>::ok(std::numeric_limits<int8_t>::min())));
+    TEST_ASSERT_TRUE(roundTrips(Result<int32_t>::ok(std::numeric_limits<int32_t>::min())));
+    TEST_ASSERT_TRUE(roundTrips(Result<uint32_t>::ok(std::numeric_limits<uint32_t>::max())));
+    TEST_ASSERT_TRUE(roundTrips(Result<int64_t>::ok(std::numeric_limits<int64_t>::min())));
+    TEST_ASSERT_TRUE(roundTrips(Result<uint64_t>::ok(std::numeric_limits<uint64_t>::max())));
+    TEST_ASSERT_TRUE(roundTrips(Result<bool>::ok(true)));
+    TEST_ASSERT_TRUE(roundTrips(Result<Mode>::ok(Mode::FAULT)));
+    TEST_ASSERT_TRUE(roundTrips(Result<void>::ok()));
+    TEST_ASSERT_TRUE(roundTrips(Result<void>::error(ErrorCode::SSL_ERROR)));
+    TEST_ASSERT_TRUE(roundTrips(Result<uint16_t>::error(ErrorCode::CRC_ERROR)));
+    TEST_ASSERT_TRUE(roundTrips(Result<uint16_t, LinkError>::error(LinkError::LOST)));
+    TEST_ASSERT_TRUE(roundTrips(Result<uint16_t, LinkError>::ok(7)));
+}
+
+void test_wire_buffer_overflow() {
+    uint8_t buffer[8];
+    std::memset(buffer, 0xCC, sizeof(buffer));
+
+    auto r = encodeResult(Result<uint16_t>::ok(0xFFFF), buffer, 2);
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_OVERFLOW, r.error());
+    TEST_ASSERT_EQUAL_UINT8(0xCC, buffer[0]);
+
+    // A short value still fits a short buffer
+    TEST_ASSERT_EQUAL(1, encodeResult(Result<uint16_t>::ok(3), buffer, 1).value());
+
+    // Batch: the Results that fit are written
+    std::array<Result<float>, 2> readings = {Result<float>::ok(1.5f), Result<float>::ok(2.5f)};
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_OVERFLOW, encodeResults(readings, buffer, sizeof(buffer)).error());
+    TEST_ASSERT_EQUAL_UINT8(0x00, buffer[0]);
+}
+
+void test_wire_rejects_bad_input() {
+    auto reading = Result<uint16_t>::ok(99);
+
+    const uint8_t truncated[] = {0xE8, 0xC8};
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_UNDERFLOW, decodeResult(truncated, sizeof(truncated), reading).error());
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_UNDERFLOW, decodeResult(truncated, 0, reading).error());
+
+    // 0x20000 << 1 does not fit uint16_t
+    const uint8_t tooLarge[] = {0x80, 0x80, 0x10};
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(tooLarge, sizeof(tooLarge), reading).error());
+
+    const uint8_t overlong[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F};
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(overlong, sizeof(overlong), reading).error());
+    TEST_ASSERT_EQUAL_UINT16(99, reading.value());
+
+    // Floats follow a 0 tag only
+    auto pressure = Result<float>::ok(1.0f);
+    const uint8_t wrongTag[] = {0x02, 0, 0, 0, 0};
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(wrongTag, sizeof(wrongTag), pressure).error());
+    const uint8_t shortFloat[] = {0x00, 0, 0};
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_UNDERFLOW, decodeResult(shortFloat, sizeof(shortFloat), pressure).error());
+
+    auto flag = Result<bool>::ok(false);
+    const uint8_t notBool[] = {0x04};
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(notBool, sizeof(notBool), flag).error());
+
+    // An error tag holding 0 (OK) must not decode as success
+    const uint8_t zeroError[] = {0x01};
+    auto count = Result<int32_t>::ok(7);
+    auto done = Result<void>::ok();
+    auto precise = Result<double>::ok(2.5);
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(zeroError, sizeof(zeroError), pressure).error());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(zeroError, sizeof(zeroError), count).error());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(zeroError, sizeof(zeroError), done).error());
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_DATA, decodeResult(zeroError, sizeof(zeroError), precise).error());
+    TEST_ASSERT_EQUAL(7, count.value());
+}
+
+void test_wire_batch_round_trip() {
+    std::array<Result<float>, 6> readings = {
+        Result<float>::ok(21.5f), Result<float>::error(ErrorCode::TIMEOUT), Result<float>::ok(-4.0f),
+        Result<float>::error(ErrorCode::CRC_ERROR), Result<float>::ok(0.0f), Result<float>::ok(1013.25f)};
+    uint8_t frame[6 * maxWireSize<float>()];
+
+    auto length = encodeResults(readings, frame, sizeof(frame));
+    TEST_ASSERT_TRUE(length.isOk());
+    TEST_ASSERT_EQUAL(4 * 5 + 1 + 2, length.value());
+
+    const auto stale = Result<float>::error(ErrorCode::DATA_NOT_READY);
+    std::array<Result<float>, 6> received = {stale, stale, stale, stale, stale, stale};
+    auto consumed = decodeResults(frame, length.value(), received);
+    TEST_ASSERT_TRUE(consumed.isOk());
+    TEST_ASSERT_EQUAL(length.value(), consumed.value());
+    for (size_t i = 0; i < readings.size(); ++i) {
+        TEST_ASSERT_TRUE(sameResult(readings[i], received[i]));
+    }
+
+    // One byte short: the last Result is missing
+    TEST_ASSERT_EQUAL(ErrorCode::BUFFER_UNDERFLOW, decodeResults(frame, length.value() - 1, received).error());
+}
+
+void test_wire_fuzz_round_trip() {
+    g_random = 0x12345678;
+    for (int i = 0; i < 20000; ++i) {
+        const uint32_t pick = nextRandom();
+        const bool failed = (pick & 3) == 0;
+        const auto error = static_cast<ErrorCode>(static_cast<int16_t>(nextRandom()));
+        switch ((pick >> 2) % 5) {
+            case 0: {
+                uint32_t bits = nextRandom();
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                TEST_ASSERT_TRUE(roundTrips(failed ? Result<float>::error(error) : Result<float>::ok(value)));
+                break;
+            }
+            case 1: {
+                auto value = static_cast<int32_t>(nextRandom()) >> (nextRandom() % 32);
+                TEST_ASSERT_TRUE(roundTrips(failed ? Result<int32_t>::error(error) : Result<int32_t>::ok(value)));
+                break;
+            }
+            case 2: {
+                auto value = static_cast<uint16_t>(nextRandom());
+                TEST_ASSERT_TRUE(roundTrips(failed ? Result<uint16_t>::error(error) : Result<uint16_t>::ok(value)));
+                break;
+            }
+            case 3: {
+                uint64_t bits = nextRandom64();
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                TEST_ASSERT_TRUE(roundTrips(failed ? Result<double>::error(error) : Result<double>::ok(value)));
+                break;
+            }
+            default: {
+                auto value = static_cast<int64_t>(nextRandom64()) >> (nextRandom() % 64);
+                TEST_ASSERT_TRUE(roundTrips(failed ? Result<int64_t>::error(error) : Result<int64_t>::ok(value)));
+                break;
+            }
+        }
+    }
+}
+
+void test_wire_fuzz_random_bytes() {
+    g_random = 0x9E3779B9;
+    uint8_t bytes[12];
+    for (int i = 0; i < 20000; ++i) {
+        const size_t size = nextRandom() % (sizeof(bytes) + 1);
+        for (size_t j = 0; j < size; ++j) {
+            // Bias towards continuation bits and small values
+            const uint32_t r = nextRandom();
+            bytes[j] = (r & 0x100) ? static_cast<uint8_t>(r | 0x80) : static_cast<uint8_t>(r & 0x7F);
+        }
+        TEST_ASSERT_TRUE((decodesConsistently<uint16_t, ErrorCode>(bytes, size)));
+        TEST_ASSERT_TRUE((decodesConsistently<int32_t, ErrorCode>(bytes, size)));
+        TEST_ASSERT_TRUE((decodesConsistently<float, ErrorCode>(bytes, size)));
+        TEST_ASSERT_TRUE((decodesConsistently<uint64_t, ErrorCode>(bytes, size)));
+        TEST_ASSERT_TRUE((decodesConsistently<bool, LinkError>(bytes, size)));
+        TEST_ASSERT_TRUE((decodesConsistently<void, ErrorCode>(bytes, size)));
+    }
+}
+
+// Test runner
+void runResultWireTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_wire_exact_bytes);
+    RUN_TEST(test_wire_round_trip_types);
+    RUN_TEST(test_wire_buffer_overflow);
+    RUN_TEST(test_wire_rejects_bad_input);
+    RUN_TEST(test_wire_batch_round_trip);
+    RUN_TEST(test_wire_fuzz_round_trip);
+    RUN_TEST(test_wire_fuzz_random_bytes);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Result Wire Tests ===\n");
+    runResultWireTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runResultWireTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
@@ -0,0 +1,293 @@
+/**
+ * @file test_retry.cpp
+ * @brief Unit tests for retry() (Retry.h) with a fake clock
+ */
+
+#ifdef UNIT_TEST
+
+#include <unity.h>
+#include <memory>
+#include "../src/LibraryCommon.h"
+#include "../src/Retry.h"
+
+using namespace common;
+
+namespace {
+
+struct FakeTimer {
+    uint32_t now = 1000;
+    uint32_t reads = 0;
+    uint32_t sleeps[16] = {};
+    size_t sleepCount = 0;
+
+    RetryTimer timer() {
+        return RetryTimer{
+            [](void* context) noexcept {
+                auto* self = static_cast<FakeTimer*>(context);
+                ++self->reads;
+                return self->now;
+            },
+            [](uint32_t ms, void* context) noexcept {
+                auto* self = static_cast<FakeTimer*>(context);
+                self->sleeps[self->sleepCount++ % 16] = ms;
+                self->now += ms;
+            },
+            this};
+    }
+};
+
+/// Fails with the listed errors, then succeeds with the attempt number
+struct FlakyOperation {
+    const ErrorCode* errors;
+    size_t failures;
+    size_t calls = 0;
+
+    Result<int> operator()() {
+        ++calls;
+        if (calls <= failures) {
+            return Result<int>::error(errors[calls - 1]);
+        }
+        return Result<int>::ok(static_cast<int>(calls));
+    }
+};
+
+RetryPolicy fixedPolicy() {
+    RetryPolicy policy;
+    policy.maxAttempts = 5;
+    policy.initialDelayMs = 10;
+    policy.maxDelayMs = 1000;
+    policy.jitterPercent = 0;
+    return policy;
+}
+
+} // namespace
+
+void test_retry_success_first_try() {
+    FakeTimer fake;
+    FlakyOperation op{nullptr, 0};
+
+    auto result = retry(op, fixedPolicy(), fake.timer());
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(1, result.value());
+    TEST_ASSERT_EQUAL(1, op.calls);
+    TEST_ASSERT_EQUAL(0, fake.sleepCount);
+    // Without stats or a deadline the clock is not read
+    TEST_ASSERT_EQUAL(0, fake.reads);
+
+    RetryStats stats;
+    retry(op, fixedPolicy(), fake.timer(), &stats);
+    TEST_ASSERT_EQUAL(1, stats.attempts);
+    TEST_ASSERT_EQUAL(RetryStop::SUCCEEDED, stats.stop);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.elapsedMs);
+}
+
+void test_retry_backoff_until_success() {
+    FakeTimer fake;
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT, ErrorCode::CRC_ERROR, ErrorCode::BUSY};
+    FlakyOperation op{errors, 3};
+
+    RetryStats stats;
+    auto result = retry(op, fixedPolicy(), fake.timer(), &stats);
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(4, result.value());
+
+    TEST_ASSERT_EQUAL(3, fake.sleepCount);
+    TEST_ASSERT_EQUAL_UINT32(10, fake.sleeps[0]);
+    TEST_ASSERT_EQUAL_UINT32(20, fake.sleeps[1]);
+    TEST_ASSERT_EQUAL_UINT32(40, fake.sleeps[2]);
+
+    TEST_ASSERT_EQUAL(4, stats.attempts);
+    TEST_ASSERT_EQUAL_UINT32(70, stats.delayMs);
+    TEST_ASSERT_EQUAL_UINT32(70, stats.elapsedMs);
+    TEST_ASSERT_EQUAL(RetryStop::SUCCEEDED, stats.stop);
+}
+
+void test_retry_stops_on_permanent_error() {
+    FakeTimer fake;
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT, ErrorCode::INVALID_PARAMETER, ErrorCode::TIMEOUT};
+    FlakyOperation op{errors, 3};
+
+    RetryStats stats;
+    auto result = retry(op, fixedPolicy(), fake.timer(), &stats);
+    TEST_ASSERT_EQUAL(ErrorCode::INVALID_PARAMETER, result.error());
+    TEST_ASSERT_EQUAL(2, op.calls);
+    TEST_ASSERT_EQUAL(RetryStop::NOT_RETRYABLE, stats.stop);
+    TEST_ASSERT_EQUAL(1, fake.sleepCount);
+}
+
+void test_retry_attempts_exhausted_with_delay_cap() {
+    FakeTimer fake;
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT, ErrorCode::TIMEOUT, ErrorCode::TIMEOUT,
+                                ErrorCode::TIMEOUT, ErrorCode::TIMEOUT};
+    FlakyOperation op{errors, 5};
+    RetryPolicy policy = fixedPolicy();
+    policy.maxAttempts = 4;
+    policy.maxDelayMs = 25;
+
+    RetryStats stats;
+    auto result = retry(op, policy, fake.timer(), &stats);
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, result.error());
+    TEST_ASSERT_EQUAL(4, op.calls);
+    TEST_ASSERT_EQUAL(RetryStop::ATTEMPTS_EXHAUSTED, stats.stop);
+    TEST_ASSERT_EQUAL(3, fake.sleepCount);
+    TEST_ASSERT_EQUAL_UINT32(10, fake.sleeps[0]);
+    TEST_ASSERT_EQUAL_UINT32(20, fake.sleeps[1]);
+    TEST_ASSERT_EQUAL_UINT32(25, fake.sleeps[2]);
+}
+
+void test_retry_initial_delay_capped() {
+    FakeTimer fake;
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT, ErrorCode::TIMEOUT};
+    FlakyOperation op{errors, 2};
+    RetryPolicy policy = fixedPolicy();
+    policy.initialDelayMs = 100;
+    policy.maxDelayMs = 30;
+
+    auto result = retry(op, policy, fake.timer());
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(2, fake.sleepCount);
+    TEST_ASSERT_EQUAL_UINT32(30, fake.sleeps[0]);
+    TEST_ASSERT_EQUAL_UINT32(30, fake.sleeps[1]);
+}
+
+void test_retry_deadline() {
+    FakeTimer fake;
+    RetryPolicy policy = fixedPolicy();
+    policy.maxAttempts = 100;
+    policy.deadlineMs = 100;
+
+    // Every attempt takes 15 ms and times out
+    size_t calls = 0;
+    auto slowOperation = [&]() {
+        ++calls;
+        fake.now += 15;
+        return Result<int>::error(ErrorCode::TIMEOUT);
+    };
+
+    RetryStats stats;
+    auto result = retry(slowOperation, policy, fake.timer(), &stats);
+    TEST_ASSERT_EQUAL(ErrorCode::TIMEOUT, result.error());
+    TEST_ASSERT_EQUAL(RetryStop::DEADLINE, stats.stop);
+    // 15, +10, 15, +20, 15 = 75 ms; waiting another 40 would pass 100
+    TEST_ASSERT_EQUAL(3, calls);
+    TEST_ASSERT_EQUAL_UINT32(75, stats.elapsedMs);
+    TEST_ASSERT_EQUAL_UINT32(30, stats.delayMs);
+    TEST_ASSERT_LESS_THAN(policy.deadlineMs, stats.elapsedMs);
+}
+
+void test_retry_jitter_bounds() {
+    FakeTimer fake;
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT, ErrorCode::TIMEOUT, ErrorCode::TIMEOUT,
+                                ErrorCode::TIMEOUT, ErrorCode::TIMEOUT, ErrorCode::TIMEOUT,
+                                ErrorCode::TIMEOUT, ErrorCode::TIMEOUT, ErrorCode::TIMEOUT};
+    RetryPolicy policy = fixedPolicy();
+    policy.maxAttempts = 10;
+    policy.backoffFactor = 1;
+    policy.initialDelayMs = 1000;
+    policy.jitterPercent = 50;
+
+    FlakyOperation op{errors, 9};
+    TEST_ASSERT_TRUE(retry(op, policy, fake.timer()).isOk());
+    TEST_ASSERT_EQUAL(9, fake.sleepCount);
+
+    bool varied = false;
+    for (size_t i = 0; i < fake.sleepCount; ++i) {
+        TEST_ASSERT_GREATER_OR_EQUAL(500, fake.sleeps[i]);
+        TEST_ASSERT_LESS_OR_EQUAL(1000, fake.sleeps[i]);
+        varied = varied || fake.sleeps[i] != fake.sleeps[0];
+    }
+    TEST_ASSERT_TRUE(varied);
+}
+
+void test_retry_custom_predicate() {
+    FakeTimer fake;
+    // INVALID_DATA is not retryable by default; this device garbles frames
+    const ErrorCode errors[] = {ErrorCode::INVALID_DATA, ErrorCode::INVALID_DATA};
+    FlakyOperation op{errors, 2};
+    RetryPolicy policy = fixedPolicy();
+    policy.shouldRetry = [](ErrorCode error) { return error == ErrorCode::INVALID_DATA || isRetryable(error); };
+
+    auto result = retry(op, policy, fake.timer());
+    TEST_ASSERT_TRUE(result.isOk());
+    TEST_ASSERT_EQUAL(3, op.calls);
+}
+
+void test_retry_move_only_and_void() {
+    FakeTimer fake;
+    int calls = 0;
+    auto makeBuffer = [&]() -> Result<std::unique_ptr<int>> {
+        if (++calls < 2) {
+            return Result<std::unique_ptr<int>>::error(ErrorCode::QUEUE_EMPTY);
+        }
+        return Result<std::unique_ptr<int>>::ok(std::make_unique<int>(42));
+    };
+    auto buffer = retry(makeBuffer, fixedPolicy(), fake.timer());
+    TEST_ASSERT_TRUE(buffer.isOk());
+    TEST_ASSERT_EQUAL(42, *buffer.value());
+
+    calls = 0;
+    auto flush = [&]() -> Result<void> {
+        return ++calls < 3 ? Result<void>::error(ErrorCode::WOULD_BLOCK) : Result<void>::ok();
+    };
+    TEST_ASSERT_TRUE(retry(flush, fixedPolicy(), fake.timer()).isOk());
+    TEST_ASSERT_EQUAL(3, calls);
+}
+
+void test_retry_installed_timer() {
+    FakeTimer fake;
+    setRetryTimer(fake.timer());
+
+    const ErrorCode errors[] = {ErrorCode::TIMEOUT};
+    FlakyOperation op{errors, 1};
+    TEST_ASSERT_TRUE(retry(op, fixedPolicy()).isOk());
+    TEST_ASSERT_EQUAL(1, fake.sleepCount);
+
+    resetRetryTimer();
+    TEST_ASSERT_TRUE(getRetryTimer().context == nullptr);
+
+    // The default timer really sleeps
+    RetryPolicy policy = fixedPolicy();
+    policy.initialDelayMs = 2;
+    FlakyOperation again{errors, 1};
+    RetryStats stats;
+    TEST_ASSERT_TRUE(retry(again, policy, &stats).isOk());
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.elapsedMs);
+}
+
+// Test runner
+void runRetryTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_retry_success_first_try);
+    RUN_TEST(test_retry_backoff_until_success);
+    RUN_TEST(test_retry_stops_on_permanent_error);
+    RUN_TEST(test_retry_attempts_exhausted_with_delay_cap);
+    RUN_TEST(test_retry_initial_delay_capped);
+    RUN_TEST(test_retry_deadline);
+    RUN_TEST(test_retry_jitter_bounds);
+    RUN_TEST(test_retry_custom_predicate);
+    RUN_TEST(test_retry_move_only_and_void);
+    RUN_TEST(test_retry_installed_timer);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);
+    Serial.begin(115200);
+    Serial.println("\n=== LibraryCommon Retry Tests ===\n");
+    runRetryTests();
+}
+
+void loop() {}
+#else
+int main() {
+    runRetryTests();
+    return 0;
+}
+#endif
+
+#endif // UNIT_TEST
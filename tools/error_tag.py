@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Map LibraryCommon location tags back to file:line.
+
+An error location tag packs a 20-bit file id (FNV-1a of the source file
+name, without directories) and a 12-bit line number; see
+src/ErrorLocation.h. This tool hashes every source file under the given
+directories and resolves tags against them.
+
+Usage:
+  error_tag.py decode TAG [TAG ...] [--src DIR ...]
+      TAG may be decimal or 0x-prefixed hex, as logged by the firmware.
+  error_tag.py check [--src DIR ...]
+      List file names whose ids collide; errors from those files cannot
+      be told apart by tag.
+  error_tag.py trace BLOB [--src DIR ...]
+      Print a dumpErrorTrace() blob (src/ErrorTrace.h), one hop per line,
+      with locations resolved and ErrorCode values named.
+
+--src defaults to the current directory. Sources are files ending in
+.h .hpp .c .cc .cpp .ino.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LINE_BITS = 12
+MAX_LINE = (1 << LINE_BITS) - 1
+FILE_ID_MASK = (1 << (32 - LINE_BITS)) - 1
+SOURCE_EXTENSIONS = (".h", ".hpp", ".c", ".cc", ".cpp", ".ino")
+
+
+def file_id(name):
+    """Same hash as detail::locationFileId() in ErrorLocation.h."""
+    value = 2166136261
+    for byte in os.path.basename(name).encode():
+        value ^= byte
+        value = (value * 16777619) & 0xFFFFFFFF
+    return value & FILE_ID_MASK
+
+
+def split_tag(tag):
+    return tag >> LINE_BITS, tag & MAX_LINE
+
+
+def scan_sources(roots):
+    """Map file id -> sorted list of source paths with that id."""
+    ids = {}
+    for root in roots:
+        for directory, subdirs, files in os.walk(root):
+            subdirs[:] = [d for d in subdirs if not d.startswith(".") or d == ".pio"]
+            for name in files:
+                if name.endswith(SOURCE_EXTENSIONS):
+                    path = os.path.relpath(os.path.join(directory, name))
+                    ids.setdefault(file_id(name), []).append(path)
+    return {key: sorted(paths) for key, paths in ids.items()}
+
+
+def describe(tag, ids):
+    if tag == 0:
+        return "unknown location"
+    fid, line = split_tag(tag)
+    suffix = "+" if line == MAX_LINE else ""
+    paths = ids.get(fid)
+    if not paths:
+        return f"<file id 0x{fid:05x}>:{line}{suffix}"
+    return " | ".join(f"{path}:{line}{suffix}" for path in paths)
+
+
+def error_names(roots):
+    """Map ErrorCode value -> name, parsed from any ErrorCodes.h found."""
+    names = {}
+    for root in roots:
+        for directory, _, files in os.walk(root):
+            if "ErrorCodes.h" in files:
+                with open(os.path.join(directory, "ErrorCodes.h")) as header:
+                    for name, value in re.findall(r"^\s*([A-Z_]+)\s*=\s*(-?\d+)\s*,", header.read(), re.M):
+                        names.setdefault(int(value), name)
+    return names
+
+
+def trace(path, ids, names):
+    with open(path, "rb") as blob:
+        data = blob.read()
+    if len(data) < 8 or data[:4] != b"ETR1":
+        print(f"{path}: not an error trace dump")
+        return 1
+    rings, entry_size = struct.unpack_from("<HH", data, 4)
+    offset = 8
+    for _ in range(rings):
+        owner, count, _ = struct.unpack_from("<IHH", data, offset)
+        offset += 8
+        print(f"thread #{owner}: {count} hop(s)")
+        for _ in range(count):
+            timestamp, location, code = struct.unpack_from("<IIi", data, offset)
+            offset += entry_size
+            name = names.get(code, str(code))
+            print(f"  {timestamp:>10}  {name:<24} {describe(location, ids)}")
+    return 0
+
+
+def decode(tags, ids):
+    failures = 0
+    for text in tags:
+        tag = int(text, 0)
+        if tag == 0:
+            print(f"{text}: unknown location")
+            continue
+        fid, line = split_tag(tag)
+        suffix = "+" if line == MAX_LINE else ""
+        paths = ids.get(fid)
+        if not paths:
+            print(f"{text}: file id 0x{fid:05x} not found, line {line}{suffix}")
+            failures += 1
+            continue
+        for path in paths:
+            print(f"{text}: {path}:{line}{suffix}")
+    return 1 if failures else 0
+
+
+def check(ids):
+    collisions = 0
+    for fid, paths in sorted(ids.items()):
+        names = sorted({os.path.basename(p) for p in paths})
+        if len(names) > 1:
+            collisions += 1
+            print(f"0x{fid:05x}: " + ", ".join(names))
+    print(f"{collisions} collision(s)")
+    return 1 if collisions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("command", choices=["decode", "check", "trace"])
+    parser.add_argument("tags", nargs="*")
+    parser.add_argument("--src", nargs="+", default=["."])
+    args = parser.parse_args()
+
+    ids = scan_sources(args.src)
+    if args.command == "decode":
+        return decode(args.tags, ids)
+    if args.command == "trace":
+        if len(args.tags) != 1:
+            parser.error("trace takes exactly one blob file")
+        return trace(args.tags[0], ids, error_names(args.src))
+    return check(ids)
+
+
+if __name__ == "__main__":
+    sys.exit(main())